@@ -8,7 +8,10 @@
  * @date 2025-06-07
  */
 
+#include <stddef.h>
 #include "ili9488.h"
+#include "ili9488_trace.h"
+#include "ili9488_toggle.h"
 
 /* Global variable to store the current display rotation */
 ILI9488_Rotation_t ili9488_rotation = ILI9488_ROTATION_PORTRAIT;
@@ -24,6 +27,363 @@ ILI9488_Rotation_t ili9488_rotation = ILI9488_ROTATION_PORTRAIT;
 #define CMD_MEMORY_ACCESS  0x36  ///< Set memory access control (rotation, mirroring)
 #define CMD_INTERFACE_MODE 0xB0  ///< Set interface mode and timing
 #define CMD_PIXEL_FORMAT   0x3A  ///< Set pixel format (18-bit RGB666)
+#define CMD_NORMAL_MODE    0x13  ///< Leave partial/scroll mode and return to normal display mode
+#define CMD_VSCROLL_DEF    0x33  ///< Define the vertical scrolling area
+#define CMD_TEARING_ON     0x35  ///< Enable the tearing effect (TE) output line
+#define CMD_VSCROLL_START  0x37  ///< Set the vertical scrolling start address
+#define CMD_MEMORY_WRITE_CONT 0x3C  ///< Continue writing display memory after the last pixel written
+
+#if ILI9488_TRANSPORT == ILI9488_TRANSPORT_SPI
+
+/* Staging buffers: two for the bursts, converted while the other is sent, and the repeated fill
+   pattern. The DMA reads them from RAM, so on parts with a data cache link them to a non-cacheable region. */
+static uint8_t ili9488_spi_burst[2][ILI9488_SPI_CHUNK * 3];
+static uint8_t ili9488_spi_fill[ILI9488_SPI_FILL * 3];
+static uint32_t ili9488_spi_fill_word;   ///< Bus word held by ili9488_spi_fill
+static uint32_t ili9488_spi_fill_count;  ///< Pixels of it, 0 when empty
+
+/**
+ * @brief Wait until the SPI peripheral has sent everything handed to it
+ * @details The HAL returns to the ready state from the DMA interrupt once the
+ *          last byte has left the shift register, so CS may go high after it.
+ */
+static inline void ILI9488_SpiWait(void){
+    while(HAL_SPI_GetState(&ILI9488_SPI_HANDLE) != HAL_SPI_STATE_READY){
+    }
+}
+
+/**
+ * @brief Send bytes to the display, by DMA if there are enough of them
+ * @param bytes Bytes to send, left untouched until the next ILI9488_SpiWait()
+ * @param size Number of bytes (1 to 65535)
+ * @details Waits for the previous transfer first. A DMA transfer is left
+ *          running, so the caller can prepare the next one meanwhile.
+ */
+static inline void ILI9488_SpiSend(const uint8_t *bytes, uint16_t size){
+    ILI9488_SpiWait();
+    if(size < ILI9488_SPI_DMA_MIN){
+        HAL_SPI_Transmit(&ILI9488_SPI_HANDLE, (uint8_t *)bytes, size, HAL_MAX_DELAY);
+    }
+    else{
+        HAL_SPI_Transmit_DMA(&ILI9488_SPI_HANDLE, (uint8_t *)bytes, size);
+    }
+}
+
+/**
+ * @brief Pull CS low with DCX at the given level
+ * @param dcx 0 for a command, 1 for data
+ */
+static inline void ILI9488_SpiSelect(uint8_t dcx){
+    ILI9488_CS_GPIO_Port->BSRR = (uint32_t)ILI9488_CS_Pin << 16; /* CS low */
+    if(dcx) ILI9488_DCX_GPIO_Port->BSRR = ILI9488_DCX_Pin; /* DCX high (data) */
+    else ILI9488_DCX_GPIO_Port->BSRR = (uint32_t)ILI9488_DCX_Pin << 16; /* DCX low (command) */
+    ILI9488_ToggleSelect(dcx);
+}
+
+/**
+ * @brief Raise CS once the last transfer is out
+ */
+static inline void ILI9488_SpiDeselect(void){
+    ILI9488_SpiWait();
+    ILI9488_CS_GPIO_Port->BSRR = ILI9488_CS_Pin; /* CS high */
+    ILI9488_ToggleDeselect();
+}
+
+/**
+ * @brief Split an 18-bit bus word into the three bytes of an SPI pixel
+ * @param out Three bytes
+ * @param word 18-bit bus word (see ILI9488_COLOR_TO_BUS)
+ * @details In 18 bpp SPI mode each byte carries one channel in its upper six
+ *          bits: DB17-DB12 first, then DB11-DB6 and DB5-DB0.
+ */
+static inline void ILI9488_SpiPack(uint8_t *out, uint32_t word){
+    out[0] = (uint8_t)((word >> 10) & 0xFC);
+    out[1] = (uint8_t)((word >> 4) & 0xFC);
+    out[2] = (uint8_t)((word << 2) & 0xFC);
+}
+
+/**
+ * @brief Write a command to the display
+ * @param cmd 8-bit command to write
+ * @details This function sends the command byte with DCX low. The chip
+ *          select (CS) is automatically managed during the operation.
+ */
+static inline void ILI9488_WriteCommand(uint8_t cmd){
+    ILI9488_TraceCommand(cmd);
+    ILI9488_SpiSelect(0);
+    ILI9488_SpiSend(&cmd, 1);
+    ILI9488_SpiDeselect();
+}
+
+/**
+ * @brief Write a parameter to the display
+ * @param data Parameter, sent as its low byte
+ * @details This function sends the parameter byte with DCX high. Pixels go
+ *          through ILI9488_WriteBusRun() and the burst functions, which send
+ *          three bytes per pixel.
+ */
+static inline void ILI9488_WriteData(uint32_t data){
+    uint8_t byte = (uint8_t)data;
+    ILI9488_TraceData(data);
+    ILI9488_SpiSelect(1);
+    ILI9488_SpiSend(&byte, 1);
+    ILI9488_SpiDeselect();
+}
+
+#elif ILI9488_TRANSPORT == ILI9488_TRANSPORT_TIMER
+
+/* Data lines in bus bit order */
+static GPIO_TypeDef *const ili9488_timer_ports[18] = {
+    DB0_GPIO_Port, DB1_GPIO_Port, DB2_GPIO_Port, DB3_GPIO_Port, DB4_GPIO_Port, DB5_GPIO_Port,
+    DB6_GPIO_Port, DB7_GPIO_Port, DB8_GPIO_Port, DB9_GPIO_Port, DB10_GPIO_Port, DB11_GPIO_Port,
+    DB12_GPIO_Port, DB13_GPIO_Port, DB14_GPIO_Port, DB15_GPIO_Port, DB16_GPIO_Port, DB17_GPIO_Port
+};
+static const uint16_t ili9488_timer_pins[18] = {
+    DB0_Pin, DB1_Pin, DB2_Pin, DB3_Pin, DB4_Pin, DB5_Pin,
+    DB6_Pin, DB7_Pin, DB8_Pin, DB9_Pin, DB10_Pin, DB11_Pin,
+    DB12_Pin, DB13_Pin, DB14_Pin, DB15_Pin, DB16_Pin, DB17_Pin
+};
+
+/* BSRR words of each 6-bit slice of a bus word, per port, built by ILI9488_TimerInit() */
+static uint32_t ili9488_timer_table[2][3][64];
+
+/* Chunk buffers of the bursts: port 0 words, then port 1 words */
+static uint32_t ili9488_timer_buffer[2][2 * ILI9488_TIMER_CHUNK];
+
+/* BSRR words driving DCX low and high, per port; both 0 for a port without DCX */
+static uint32_t ili9488_timer_dcx[2][2];
+
+/**
+ * @brief Transfer paced by the timer
+ */
+static struct {
+    const uint32_t *bsrr;      ///< Port 0 BSRR words, NULL to strobe the pins as they are
+    uint32_t stride;           ///< Offset of the port 1 words from the port 0 words
+    uint32_t count;            ///< Words in the transfer
+    uint32_t done;             ///< Words handed to the timer so far
+    const ILI9488_BsrrNode_t *next; ///< Node of a chain sent after this transfer, NULL if none
+    volatile uint8_t busy;     ///< 1 until the timer has strobed the last word
+    uint8_t selected;          ///< 1 while CS is low
+} ili9488_timer;
+
+/**
+ * @brief Split a bus word into the BSRR words of the two data ports
+ * @param word 18-bit bus word
+ * @param port1 Output: BSRR word of port 1
+ * @return BSRR word of port 0
+ */
+static inline uint32_t ILI9488_TimerSplit(uint32_t word, uint32_t *port1){
+    uint32_t low = word & 0x3F, mid = (word >> 6) & 0x3F, high = (word >> 12) & 0x3F;
+    *port1 = ili9488_timer_table[1][0][low] | ili9488_timer_table[1][1][mid] | ili9488_timer_table[1][2][high];
+    return ili9488_timer_table[0][0][low] | ili9488_timer_table[0][1][mid] | ili9488_timer_table[0][2][high];
+}
+
+/**
+ * @brief Build the BSRR tables from the data pins and set up the timer
+ * @details Every data line sets its pin in the table entries where its bit
+ *          is 1 and resets it where it is 0, so one BSRR store per port
+ *          drives a whole word. WR is high while the counter is below
+ *          ILI9488_TIMER_PERIOD / 2 and low afterwards, so it rises at the
+ *          update event ending each period; the DMA drives the next word
+ *          ILI9488_TIMER_HOLD ticks later. One-pulse mode stops the timer
+ *          after the repetition counter has run out.
+ */
+static void ILI9488_TimerInit(void){
+    TIM_TypeDef *timer = ILI9488_TIMER_HANDLE.Instance;
+
+    for(uint8_t line = 0; line < 18; line++){
+        uint8_t port = ili9488_timer_ports[line] == ILI9488_TIMER_PORT0 ? 0 : 1;
+        uint32_t pin = ili9488_timer_pins[line];
+        for(uint32_t slice = 0; slice < 64; slice++){
+            uint32_t *entry = &ili9488_timer_table[port][line / 6][slice];
+            *entry |= (slice & (1u << (line % 6))) ? pin : pin << 16;
+        }
+    }
+    if(ILI9488_DCX_GPIO_Port == ILI9488_TIMER_PORT0 || ILI9488_DCX_GPIO_Port == ILI9488_TIMER_PORT1){
+        uint8_t port = ILI9488_DCX_GPIO_Port == ILI9488_TIMER_PORT0 ? 0 : 1;
+        ili9488_timer_dcx[port][0] = (uint32_t)ILI9488_DCX_Pin << 16;
+        ili9488_timer_dcx[port][1] = ILI9488_DCX_Pin;
+    }
+    timer->CR1 |= TIM_CR1_OPM | TIM_CR1_URS; /* Stop at the end of a run, no interrupt from UG */
+    timer->ARR = ILI9488_TIMER_PERIOD - 1;
+    timer->CCR1 = ILI9488_TIMER_PERIOD / 2;
+    timer->CCR2 = ILI9488_TIMER_HOLD;
+    timer->CCR3 = ILI9488_TIMER_HOLD;
+    timer->DIER |= TIM_DIER_UIE;
+    HAL_TIM_PWM_Start(&ILI9488_TIMER_HANDLE, TIM_CHANNEL_1); /* One WR pulse with CS high, ignored */
+    while(timer->CR1 & TIM_CR1_CEN){
+    }
+}
+
+/**
+ * @brief Hand the next chunk of the transfer to the timer
+ * @details The repetition counter limits a run of the timer to
+ *          ILI9488_TIMER_CHUNK words; the DMA streams are armed for exactly
+ *          the words of the run.
+ */
+static ILI9488_FAST void ILI9488_TimerChunk(void){
+    TIM_TypeDef *timer = ILI9488_TIMER_HANDLE.Instance;
+    uint32_t left = ili9488_timer.count - ili9488_timer.done;
+    uint32_t chunk = left < ILI9488_TIMER_CHUNK ? left : ILI9488_TIMER_CHUNK;
+
+    if(ili9488_timer.bsrr){
+        const uint32_t *words = ili9488_timer.bsrr + ili9488_timer.done;
+        HAL_DMA_Start(ILI9488_TIMER_HANDLE.hdma[TIM_DMA_ID_CC2], (uintptr_t)words,
+                      (uintptr_t)&ILI9488_TIMER_PORT0->BSRR, chunk);
+        HAL_DMA_Start(ILI9488_TIMER_HANDLE.hdma[TIM_DMA_ID_CC3], (uintptr_t)(words + ili9488_timer.stride),
+                      (uintptr_t)&ILI9488_TIMER_PORT1->BSRR, chunk);
+        timer->DIER |= TIM_DIER_CC2DE | TIM_DIER_CC3DE;
+    }
+    else{
+        timer->DIER &= ~(TIM_DIER_CC2DE | TIM_DIER_CC3DE);
+    }
+    ili9488_timer.done += chunk;
+    timer->RCR = chunk - 1;
+    timer->EGR = TIM_EGR_UG; /* Load RCR, counter to 0 */
+    timer->CR1 |= TIM_CR1_CEN;
+}
+
+/**
+ * @brief Start a transfer in the background, CS and DCX already set
+ * @param bsrr Port 0 BSRR words, NULL to strobe the pins as they are
+ * @param stride Offset of the port 1 words
+ * @param count Number of words (1 or more)
+ */
+static void ILI9488_TimerStart(const uint32_t *bsrr, uint32_t stride, uint32_t count){
+    while(ili9488_timer.busy){
+    }
+    ili9488_timer.bsrr = bsrr;
+    ili9488_timer.stride = stride;
+    ili9488_timer.count = count;
+    ili9488_timer.done = 0;
+    ili9488_timer.next = NULL;
+    ili9488_timer.busy = 1;
+    ILI9488_TimerChunk();
+}
+
+/**
+ * @brief Continue a transfer from the timer update interrupt
+ * @details Call from the update interrupt handler of the timer, for example
+ *          TIM1_UP_TIM10_IRQHandler(), before HAL_TIM_IRQHandler() if the
+ *          HAL handles the timer as well.
+ */
+ILI9488_FAST void ILI9488_TimerIRQHandler(void){
+    TIM_TypeDef *timer = ILI9488_TIMER_HANDLE.Instance;
+    if(!(timer->SR & TIM_SR_UIF)) return;
+    timer->SR = ~TIM_SR_UIF;
+    if(!ili9488_timer.busy) return;
+    if(ili9488_timer.bsrr){
+        /* The streams finished with the last compare event, this resets their HAL state */
+        HAL_DMA_PollForTransfer(ILI9488_TIMER_HANDLE.hdma[TIM_DMA_ID_CC2], HAL_DMA_FULL_TRANSFER, 0);
+        HAL_DMA_PollForTransfer(ILI9488_TIMER_HANDLE.hdma[TIM_DMA_ID_CC3], HAL_DMA_FULL_TRANSFER, 0);
+    }
+    if(ili9488_timer.done < ili9488_timer.count){
+        ILI9488_TimerChunk();
+    }
+    else if(ili9488_timer.next){
+        /* Next node of a chain: reload the transfer without returning to the caller */
+        const ILI9488_BsrrNode_t *node = ili9488_timer.next;
+        ili9488_timer.bsrr = node->bsrr;
+        ili9488_timer.stride = node->stride;
+        ili9488_timer.count = node->count;
+        ili9488_timer.done = 0;
+        ili9488_timer.next = node->next;
+        ILI9488_TimerChunk();
+    }
+    else{
+        ili9488_timer.busy = 0;
+    }
+}
+
+/**
+ * @brief Check whether a background transfer is still running
+ * @return 1 while the timer strobes words, 0 when the bus is idle
+ */
+uint8_t ILI9488_BusBusy(void){
+    return ili9488_timer.busy;
+}
+
+/**
+ * @brief Wait for the background transfer to finish and raise CS
+ * @details Buffers given to ILI9488_WriteBsrr() may be reused afterwards.
+ */
+void ILI9488_BusWait(void){
+    while(ili9488_timer.busy){
+    }
+    if(!ili9488_timer.selected) return;
+    ILI9488_CS_GPIO_Port->BSRR = ILI9488_CS_Pin; /* CS high */
+    ILI9488_ToggleDeselect();
+    ili9488_timer.selected = 0;
+}
+
+/**
+ * @brief Finish the previous transfer and pull CS low with DCX at the given level
+ * @param dcx 0 for a command, 1 for data
+ */
+static inline void ILI9488_TimerSelect(uint8_t dcx){
+    ILI9488_BusWait();
+    ILI9488_CS_GPIO_Port->BSRR = (uint32_t)ILI9488_CS_Pin << 16; /* CS low */
+    if(dcx) ILI9488_DCX_GPIO_Port->BSRR = ILI9488_DCX_Pin; /* DCX high (data) */
+    else ILI9488_DCX_GPIO_Port->BSRR = (uint32_t)ILI9488_DCX_Pin << 16; /* DCX low (command) */
+    ILI9488_ToggleSelect(dcx);
+    ili9488_timer.selected = 1;
+}
+
+/**
+ * @brief Drive a bus word onto the data pins, one BSRR store per port
+ * @param word 18-bit bus word
+ */
+static inline void ILI9488_TimerDrive(uint32_t word){
+    uint32_t port1;
+    ILI9488_TIMER_PORT0->BSRR = ILI9488_TimerSplit(word, &port1);
+    ILI9488_TIMER_PORT1->BSRR = port1;
+}
+
+/**
+ * @brief Write a command to the display
+ * @param cmd 8-bit command to write
+ * @details This function drives the command byte with DCX low and lets the
+ *          timer strobe it once. The chip select (CS) is automatically
+ *          managed during the operation.
+ */
+static inline void ILI9488_WriteCommand(uint8_t cmd){
+    ILI9488_TraceCommand(cmd);
+    ILI9488_TimerSelect(0);
+    ILI9488_TimerDrive(cmd);
+    ILI9488_TimerStart(NULL, 0, 1);
+    ILI9488_BusWait();
+}
+
+/**
+ * @brief Write data to the display
+ * @param data 18-bit data to write (RGB666 format)
+ * @details This function drives the data word with DCX high and lets the
+ *          timer strobe it once. The chip select (CS) is automatically
+ *          managed during the operation.
+ */
+static inline void ILI9488_WriteData(uint32_t data){
+    ILI9488_TraceData(data);
+    ILI9488_TimerSelect(1);
+    ILI9488_TimerDrive(data);
+    ILI9488_TimerStart(NULL, 0, 1);
+    ILI9488_BusWait();
+}
+
+#else
+
+/**
+ * @brief Generate a write strobe
+ * @details The panel latches DB0-DB17 on the rising edge of WR. Strobing
+ *          again without touching the data pins writes the same value again,
+ *          which is how solid runs are sent without re-driving the bus.
+ */
+static inline void ILI9488_Strobe(void){
+    ILI9488_ToggleStrobe();
+    /* WR strobe (active low) */
+    ILI9488_WR_GPIO_Port->BSRR = (uint32_t)ILI9488_WR_Pin << 16; /* WR low */
+    __NOP(); __NOP(); /* Short delay */
+    ILI9488_WR_GPIO_Port->BSRR = ILI9488_WR_Pin; /* WR high */
+}
 
 /**
  * @brief Write 18-bit data to the display
@@ -36,6 +396,7 @@ ILI9488_Rotation_t ili9488_rotation = ILI9488_ROTATION_PORTRAIT;
  *       in the main.h file.
  */
 static inline void ILI9488_Write18(uint32_t data){
+    ILI9488_ToggleWord(data);
     /* Clear all data pins (set to 0) */
     DB0_GPIO_Port->BSRR = (uint32_t)DB0_Pin << 16;
     DB1_GPIO_Port->BSRR = (uint32_t)DB1_Pin << 16;
@@ -76,10 +437,7 @@ static inline void ILI9488_Write18(uint32_t data){
     if(data & (1 << 16)) DB16_GPIO_Port->BSRR = DB16_Pin;
     if(data & (1 << 17)) DB17_GPIO_Port->BSRR = DB17_Pin;
 
-    /* WR strobe (active low) */
-    ILI9488_WR_GPIO_Port->BSRR = (uint32_t)ILI9488_WR_Pin << 16; /* WR low */
-    __NOP(); __NOP(); /* Short delay */
-    ILI9488_WR_GPIO_Port->BSRR = ILI9488_WR_Pin; /* WR high */
+    ILI9488_Strobe();
 }
 
 /**
@@ -92,10 +450,13 @@ static inline void ILI9488_Write18(uint32_t data){
  *       in the main.h file.
  */
 static inline void ILI9488_WriteCommand(uint8_t cmd){
+    ILI9488_TraceCommand(cmd);
     ILI9488_CS_GPIO_Port->BSRR = (uint32_t)ILI9488_CS_Pin << 16; /* CS low */
     ILI9488_DCX_GPIO_Port->BSRR = (uint32_t)ILI9488_DCX_Pin << 16; /* DCX low (command) */
+    ILI9488_ToggleSelect(0);
     ILI9488_Write18(cmd);
     ILI9488_CS_GPIO_Port->BSRR = ILI9488_CS_Pin; /* CS high */
+    ILI9488_ToggleDeselect();
 }
 
 /**
@@ -108,12 +469,17 @@ static inline void ILI9488_WriteCommand(uint8_t cmd){
  *       in the main.h file.
  */
 static inline void ILI9488_WriteData(uint32_t data){
+    ILI9488_TraceData(data);
     ILI9488_CS_GPIO_Port->BSRR = (uint32_t)ILI9488_CS_Pin << 16; /* CS low */
     ILI9488_DCX_GPIO_Port->BSRR = ILI9488_DCX_Pin; /* DCX high (data) */
+    ILI9488_ToggleSelect(1);
     ILI9488_Write18(data);
     ILI9488_CS_GPIO_Port->BSRR = ILI9488_CS_Pin; /* CS high */
+    ILI9488_ToggleDeselect();
 }
 
+#endif /* ILI9488_TRANSPORT */
+
 /**
  * @brief Set the display address window for drawing
  * @param x0 Starting X coordinate (0 to 319 or 0 to 479 for vertical)
@@ -146,6 +512,433 @@ static inline void ILI9488_SetAddressWindow(uint16_t x0, uint16_t y0, uint16_t x
     }
 }
 
+/**
+ * @brief Open an address window for streaming pixels
+ * @param x Left edge of the window
+ * @param y Top edge of the window
+ * @param w Width of the window (1 or more)
+ * @param h Height of the window (1 or more)
+ * @details This function sets the address window and issues the memory write
+ *          command. Pixels sent afterwards with ILI9488_WritePixels() fill the
+ *          window row by row, and several calls may follow one window.
+ */
+void ILI9488_SetWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h){
+    if(ili9488_rotation == ILI9488_ROTATION_PORTRAIT || ili9488_rotation == ILI9488_ROTATION_PORTRAIT_INV){
+        ILI9488_SetAddressWindow(x, y, x + w - 1, y + h - 1);
+    }
+    else if(ili9488_rotation == ILI9488_ROTATION_LANDSCAPE || ili9488_rotation == ILI9488_ROTATION_LANDSCAPE_INV){
+        ILI9488_SetAddressWindow(y, x, y + h - 1, x + w - 1);
+    }
+}
+
+/**
+ * @brief Resume a memory write in the current address window
+ * @details This function issues the memory write continue command, so pixels
+ *          sent afterwards follow the last pixel written instead of restarting
+ *          at the window origin. Streams call it before every chunk after the
+ *          first, so other bus traffic between chunks cannot break the fill.
+ */
+void ILI9488_WriteContinue(void){
+    ILI9488_WriteCommand(CMD_MEMORY_WRITE_CONT);
+}
+
+#if ILI9488_TRANSPORT == ILI9488_TRANSPORT_SPI
+
+/**
+ * @brief Send a burst of pixels in chunks converted to SPI bytes
+ * @param words Colors or bus words
+ * @param count Number of pixels
+ * @param colors 1 if words holds RGB666 colors, 0 for bus words
+ * @details Each chunk is converted into one of two buffers while the DMA
+ *          sends the other, with CS low for the whole burst.
+ */
+static ILI9488_FAST void ILI9488_SpiBurst(const uint32_t *words, uint32_t count, uint8_t colors){
+    uint8_t half = 0;
+    ILI9488_SpiSelect(1);
+    while(count > 0){
+        uint32_t chunk = count < ILI9488_SPI_CHUNK ? count : ILI9488_SPI_CHUNK;
+        uint8_t *out = ili9488_spi_burst[half];
+        for(uint32_t i = 0; i < chunk; i++){
+            uint32_t word = colors ? ILI9488_COLOR_TO_BUS(words[i]) : words[i];
+            ILI9488_TracePixel(word);
+            ILI9488_SpiPack(out + 3 * i, word);
+        }
+        ILI9488_SpiSend(out, (uint16_t)(chunk * 3));
+        words += chunk;
+        count -= chunk;
+        half ^= 1;
+    }
+    ILI9488_SpiDeselect();
+}
+
+/**
+ * @brief Stream pixels into the current address window
+ * @param pixels 18-bit RGB colors (RGB666 format)
+ * @param count Number of pixels
+ * @details Must follow ILI9488_SetWindow(). The window position advances
+ *          with every pixel, so a window can be filled in several chunks.
+ *          CS stays low for the whole burst, which is sent by DMA in chunks
+ *          of ILI9488_SPI_CHUNK pixels.
+ */
+ILI9488_FAST void ILI9488_WritePixels(const uint32_t *pixels, uint32_t count){
+    ILI9488_TraceBurst(count);
+    ILI9488_SpiBurst(pixels, count, 1);
+    ILI9488_TraceBurstEnd();
+}
+
+/**
+ * @brief Stream pre-packed bus words into the current address window
+ * @param words 18-bit bus words (see ILI9488_COLOR_TO_BUS)
+ * @param count Number of pixels
+ * @details Same as ILI9488_WritePixels() without the color conversion, for
+ *          assets converted to bus words offline.
+ */
+ILI9488_FAST void ILI9488_WriteBus(const uint32_t *words, uint32_t count){
+    ILI9488_TraceBurst(count);
+    ILI9488_SpiBurst(words, count, 0);
+    ILI9488_TraceBurstEnd();
+}
+
+/**
+ * @brief Stream a run of one bus word into the current address window
+ * @param word 18-bit bus word (see ILI9488_COLOR_TO_BUS)
+ * @param count Number of pixels
+ * @details The word is packed into a buffer of ILI9488_SPI_FILL pixels once,
+ *          and the DMA sends that buffer again and again with CS held low.
+ *          The buffer is kept, so runs of the same word skip the packing.
+ */
+ILI9488_FAST void ILI9488_WriteBusRun(uint32_t word, uint32_t count){
+    if(count == 0) return;
+    ILI9488_TraceRun(word, count);
+    uint32_t fill = count < ILI9488_SPI_FILL ? count : ILI9488_SPI_FILL;
+    if(word != ili9488_spi_fill_word || fill > ili9488_spi_fill_count){
+        /* CS is high, so no transfer is reading the buffer */
+        ILI9488_SpiPack(ili9488_spi_fill, word);
+        for(uint32_t i = 3; i < fill * 3; i++) ili9488_spi_fill[i] = ili9488_spi_fill[i - 3];
+        ili9488_spi_fill_word = word;
+        ili9488_spi_fill_count = fill;
+    }
+    ILI9488_SpiSelect(1);
+    while(count > 0){
+        uint32_t chunk = count < fill ? count : fill;
+        ILI9488_SpiSend(ili9488_spi_fill, (uint16_t)(chunk * 3));
+        count -= chunk;
+    }
+    ILI9488_SpiDeselect();
+}
+
+#elif ILI9488_TRANSPORT == ILI9488_TRANSPORT_TIMER
+
+/**
+ * @brief Send a burst of pixels in chunks converted to BSRR words
+ * @param words Colors or bus words
+ * @param count Number of pixels
+ * @param colors 1 if words holds RGB666 colors, 0 for bus words
+ * @details Each chunk is converted into one of two buffers while the timer
+ *          sends the other. The last chunk is left running with CS low, so
+ *          the caller's next work overlaps it.
+ */
+static ILI9488_FAST void ILI9488_TimerBurst(const uint32_t *words, uint32_t count, uint8_t colors){
+    uint8_t half = 0;
+    ILI9488_TimerSelect(1);
+    while(count > 0){
+        uint32_t chunk = count < ILI9488_TIMER_CHUNK ? count : ILI9488_TIMER_CHUNK;
+        uint32_t *out = ili9488_timer_buffer[half];
+        for(uint32_t i = 0; i < chunk; i++){
+            uint32_t word = colors ? ILI9488_COLOR_TO_BUS(words[i]) : words[i];
+            ILI9488_TracePixel(word);
+            out[i] = ILI9488_TimerSplit(word, &out[ILI9488_TIMER_CHUNK + i]);
+        }
+        ILI9488_TimerStart(out, ILI9488_TIMER_CHUNK, chunk);
+        words += chunk;
+        count -= chunk;
+        half ^= 1;
+    }
+}
+
+/**
+ * @brief Stream pixels into the current address window
+ * @param pixels 18-bit RGB colors (RGB666 format)
+ * @param count Number of pixels
+ * @details Must follow ILI9488_SetWindow(). The window position advances
+ *          with every pixel, so a window can be filled in several chunks.
+ *          CS stays low for the whole burst. The pixels are copied, so the
+ *          array may be reused as soon as this returns, while the timer may
+ *          still be sending the last ILI9488_TIMER_CHUNK of them.
+ */
+ILI9488_FAST void ILI9488_WritePixels(const uint32_t *pixels, uint32_t count){
+    ILI9488_TraceBurst(count);
+    ILI9488_TimerBurst(pixels, count, 1);
+    ILI9488_TraceBurstEnd();
+}
+
+/**
+ * @brief Stream pre-packed bus words into the current address window
+ * @param words 18-bit bus words (see ILI9488_COLOR_TO_BUS)
+ * @param count Number of pixels
+ * @details Same as ILI9488_WritePixels() without the color conversion, for
+ *          assets converted to bus words offline.
+ */
+ILI9488_FAST void ILI9488_WriteBus(const uint32_t *words, uint32_t count){
+    ILI9488_TraceBurst(count);
+    ILI9488_TimerBurst(words, count, 0);
+    ILI9488_TraceBurstEnd();
+}
+
+/**
+ * @brief Stream a run of one bus word into the current address window
+ * @param word 18-bit bus word (see ILI9488_COLOR_TO_BUS)
+ * @param count Number of pixels
+ * @details The data pins are driven once and the timer strobes WR for every
+ *          pixel with no DMA at all. The run goes on in the background after
+ *          this returns; the next bus access waits for it.
+ */
+ILI9488_FAST void ILI9488_WriteBusRun(uint32_t word, uint32_t count){
+    if(count == 0) return;
+    ILI9488_TraceRun(word, count);
+    ILI9488_TimerSelect(1);
+    ILI9488_TimerDrive(word);
+    ILI9488_TimerStart(NULL, 0, count);
+}
+
+/**
+ * @brief Convert bus words into the BSRR words ILI9488_WriteBsrr() sends
+ * @param words 18-bit bus words (see ILI9488_COLOR_TO_BUS)
+ * @param bsrr Output: 2 * count words, the port 0 words followed by the port 1 words
+ * @param count Number of pixels
+ * @details Needs ILI9488_Init() to have run, as the tables follow the pin
+ *          assignment of main.h. If DCX shares a port with the data lines,
+ *          the words also drive it high, so they follow the memory write
+ *          command of an ILI9488_ChainRect() window.
+ */
+ILI9488_FAST void ILI9488_BusToBsrr(const uint32_t *words, uint32_t *bsrr, uint32_t count){
+    for(uint32_t i = 0; i < count; i++){
+        bsrr[i] = ILI9488_TimerSplit(words[i], &bsrr[count + i]) | ili9488_timer_dcx[0][1];
+        bsrr[count + i] |= ili9488_timer_dcx[1][1];
+    }
+}
+
+/**
+ * @brief Stream precomputed BSRR words into the current address window in the background
+ * @param bsrr 2 * count words from ILI9488_BusToBsrr(), untouched until ILI9488_BusWait()
+ * @param count Number of pixels
+ * @details Nothing is converted or copied: the DMA reads the words straight
+ *          from the array, and this returns as soon as the first chunk has
+ *          been handed to the timer.
+ */
+void ILI9488_WriteBsrr(const uint32_t *bsrr, uint32_t count){
+    if(count == 0) return;
+    ILI9488_TraceBurst(count);
+#ifdef ILI9488_TRACE
+    /* Read the bus words back from the set halves of the BSRR words for the trace */
+    for(uint32_t i = 0; i < count; i++){
+        uint32_t word = 0;
+        for(uint8_t line = 0; line < 18; line++){
+            uint32_t set = ili9488_timer_ports[line] == ILI9488_TIMER_PORT0 ? bsrr[i] : bsrr[count + i];
+            if(set & ili9488_timer_pins[line]) word |= 1u << line;
+        }
+        ILI9488_TracePixel(word);
+    }
+#endif
+    ILI9488_TimerSelect(1);
+    ILI9488_TimerStart(bsrr, count, count);
+    ILI9488_TraceBurstEnd();
+}
+
+/**
+ * @brief Build the nodes sending one rectangle of a chain
+ * @param rect Storage for the nodes and the window words, untouched until ILI9488_BusWait()
+ * @param x Left edge of the rectangle
+ * @param y Top edge of the rectangle
+ * @param w Width of the rectangle (1 or more)
+ * @param h Height of the rectangle (1 or more)
+ * @param bsrr 2 * w * h words from ILI9488_BusToBsrr(), untouched until ILI9488_BusWait()
+ * @param prev Rectangle sent before this one, NULL for the first of a chain
+ * @return 1 on success, 0 if DCX is on neither data port or the rectangle is empty
+ * @details The column, page and memory write commands with their parameters
+ *          become 11 BSRR words carrying DCX next to the data lines, so the
+ *          DMA switches between commands and data on its own. The window is
+ *          the one ILI9488_SetWindow() would set. Needs ILI9488_Init() to
+ *          have run.
+ */
+uint8_t ILI9488_ChainRect(ILI9488_ChainRect_t *rect, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                          const uint32_t *bsrr, ILI9488_ChainRect_t *prev){
+    /* Command (DCX low) or parameter byte, in sending order */
+    const uint16_t window[ILI9488_CHAIN_WINDOW] = {
+        0x100 | CMD_COLUMN_ADDR, x >> 8, x & 0xFF, (x + w - 1) >> 8, (x + w - 1) & 0xFF,
+        0x100 | CMD_PAGE_ADDR, y >> 8, y & 0xFF, (y + h - 1) >> 8, (y + h - 1) & 0xFF,
+        0x100 | CMD_MEMORY_WRITE
+    };
+
+    if(w == 0 || h == 0 || (ili9488_timer_dcx[0][0] | ili9488_timer_dcx[1][0]) == 0) return 0;
+    for(uint8_t i = 0; i < ILI9488_CHAIN_WINDOW; i++){
+        uint8_t dcx = window[i] & 0x100 ? 0 : 1;
+        uint32_t *port1 = &rect->words[ILI9488_CHAIN_WINDOW + i];
+        rect->words[i] = ILI9488_TimerSplit(window[i] & 0xFF, port1) | ili9488_timer_dcx[0][dcx];
+        *port1 |= ili9488_timer_dcx[1][dcx];
+    }
+    rect->window.bsrr = rect->words;
+    rect->window.stride = ILI9488_CHAIN_WINDOW;
+    rect->window.count = ILI9488_CHAIN_WINDOW;
+    rect->window.next = &rect->pixels;
+    rect->pixels.bsrr = bsrr;
+    rect->pixels.stride = (uint32_t)w * h;
+    rect->pixels.count = (uint32_t)w * h;
+    rect->pixels.next = NULL;
+    if(prev) prev->pixels.next = &rect->window;
+    return 1;
+}
+
+/**
+ * @brief Send a chain of nodes in the background with one start
+ * @param first First node, for example &rect->window of the first ILI9488_ChainRect()
+ * @details The timer update interrupt moves from node to node, so the whole
+ *          chain goes out with CS low and no other work from the caller.
+ *          Returns once the first node has been handed to the timer; the
+ *          nodes and their words must stay untouched until ILI9488_BusWait().
+ */
+void ILI9488_WriteChain(const ILI9488_BsrrNode_t *first){
+#ifdef ILI9488_TRACE
+    /* Nodes starting with DCX low hold commands and parameters, the others pixels */
+    for(const ILI9488_BsrrNode_t *node = first; node; node = node->next){
+        uint8_t commands = ((node->bsrr[0] & ili9488_timer_dcx[0][0]) | (node->bsrr[node->stride] & ili9488_timer_dcx[1][0])) != 0;
+        if(!commands) ILI9488_TraceBurst(node->count);
+        for(uint32_t i = 0; i < node->count; i++){
+            uint32_t word = 0;
+            for(uint8_t line = 0; line < 18; line++){
+                uint32_t set = ili9488_timer_ports[line] == ILI9488_TIMER_PORT0 ? node->bsrr[i] : node->bsrr[node->stride + i];
+                if(set & ili9488_timer_pins[line]) word |= 1u << line;
+            }
+            if(!commands) ILI9488_TracePixel(word);
+            else if((node->bsrr[i] & ili9488_timer_dcx[0][0]) || (node->bsrr[node->stride + i] & ili9488_timer_dcx[1][0])){
+                ILI9488_TraceCommand((uint8_t)word);
+            }
+            else ILI9488_TraceData(word);
+        }
+        if(!commands) ILI9488_TraceBurstEnd();
+    }
+#endif
+    ILI9488_TimerSelect(0);
+    ili9488_timer.bsrr = first->bsrr;
+    ili9488_timer.stride = first->stride;
+    ili9488_timer.count = first->count;
+    ili9488_timer.done = 0;
+    ili9488_timer.next = first->next;
+    ili9488_timer.busy = 1;
+    ILI9488_TimerChunk();
+}
+
+#else
+
+/**
+ * @brief Stream pixels into the current address window
+ * @param pixels 18-bit RGB colors (RGB666 format)
+ * @param count Number of pixels
+ * @details Must follow ILI9488_SetWindow(). The window position advances
+ *          with every pixel, so a window can be filled in several chunks.
+ *          CS stays low for the whole burst.
+ */
+ILI9488_FAST void ILI9488_WritePixels(const uint32_t *pixels, uint32_t count){
+    ILI9488_TraceBurst(count);
+    ILI9488_CS_GPIO_Port->BSRR = (uint32_t)ILI9488_CS_Pin << 16; /* CS low */
+    ILI9488_DCX_GPIO_Port->BSRR = ILI9488_DCX_Pin; /* DCX high (data) */
+    ILI9488_ToggleSelect(1);
+    for(uint32_t i = 0; i < count; i++){
+        uint32_t word = ILI9488_COLOR_TO_BUS(pixels[i]);
+        ILI9488_TracePixel(word);
+        ILI9488_Write18(word);
+    }
+    ILI9488_CS_GPIO_Port->BSRR = ILI9488_CS_Pin; /* CS high */
+    ILI9488_ToggleDeselect();
+    ILI9488_TraceBurstEnd();
+}
+
+/**
+ * @brief Stream pre-packed bus words into the current address window
+ * @param words 18-bit bus words (see ILI9488_COLOR_TO_BUS)
+ * @param count Number of pixels
+ * @details Same as ILI9488_WritePixels() without the color conversion, for
+ *          assets converted to bus words offline.
+ */
+ILI9488_FAST void ILI9488_WriteBus(const uint32_t *words, uint32_t count){
+    ILI9488_TraceBurst(count);
+    ILI9488_CS_GPIO_Port->BSRR = (uint32_t)ILI9488_CS_Pin << 16; /* CS low */
+    ILI9488_DCX_GPIO_Port->BSRR = ILI9488_DCX_Pin; /* DCX high (data) */
+    ILI9488_ToggleSelect(1);
+    for(uint32_t i = 0; i < count; i++){
+        ILI9488_TracePixel(words[i]);
+        ILI9488_Write18(words[i]);
+    }
+    ILI9488_CS_GPIO_Port->BSRR = ILI9488_CS_Pin; /* CS high */
+    ILI9488_ToggleDeselect();
+    ILI9488_TraceBurstEnd();
+}
+
+/**
+ * @brief Stream a run of one bus word into the current address window
+ * @param word 18-bit bus word (see ILI9488_COLOR_TO_BUS)
+ * @param count Number of pixels
+ * @details The data pins are driven once, then only WR is strobed for the
+ *          remaining pixels with CS held low. A run costs two GPIO writes
+ *          per pixel instead of thirty-six.
+ */
+ILI9488_FAST void ILI9488_WriteBusRun(uint32_t word, uint32_t count){
+    if(count == 0) return;
+    ILI9488_TraceRun(word, count);
+    ILI9488_CS_GPIO_Port->BSRR = (uint32_t)ILI9488_CS_Pin << 16; /* CS low */
+    ILI9488_DCX_GPIO_Port->BSRR = ILI9488_DCX_Pin; /* DCX high (data) */
+    ILI9488_ToggleSelect(1);
+    ILI9488_Write18(word);
+    for(uint32_t i = 1; i < count; i++){
+        ILI9488_Strobe();
+    }
+    ILI9488_CS_GPIO_Port->BSRR = ILI9488_CS_Pin; /* CS high */
+    ILI9488_ToggleDeselect();
+}
+
+#endif /* ILI9488_TRANSPORT */
+
+#if ILI9488_TRANSPORT != ILI9488_TRANSPORT_TIMER
+/**
+ * @brief Check whether a background transfer is still running
+ * @return Always 0, this transport returns when the bus is idle
+ */
+uint8_t ILI9488_BusBusy(void){
+    return 0;
+}
+
+/**
+ * @brief Wait for the background transfer to finish
+ * @details Nothing to wait for with this transport.
+ */
+void ILI9488_BusWait(void){
+}
+#endif
+
+/**
+ * @brief Stream a run of one color into the current address window
+ * @param color 18-bit RGB color (RGB666 format, 0x000000 to 0x3FFFFF)
+ * @param count Number of pixels
+ * @details The color is latched once and repeated with WR strobes only.
+ */
+void ILI9488_WriteColor(uint32_t color, uint32_t count){
+    ILI9488_WriteBusRun(ILI9488_COLOR_TO_BUS(color), count);
+}
+
+/**
+ * @brief Draw a bitmap on the display
+ * @param x Left edge of the bitmap
+ * @param y Top edge of the bitmap
+ * @param w Width of the bitmap
+ * @param h Height of the bitmap
+ * @param pixels w * h 18-bit RGB colors (RGB666 format), row by row
+ * @details The bitmap is sent through a single address window.
+ */
+void ILI9488_DrawBitmap(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint32_t *pixels){
+    ILI9488_SetWindow(x, y, w, h);
+    ILI9488_WritePixels(pixels, (uint32_t)w * h);
+}
+
 /**
  * @brief Draw a single pixel on the display
  * @param x X coordinate (0 to 319 or 0 to 479 for vertical)
@@ -158,14 +951,32 @@ static inline void ILI9488_SetAddressWindow(uint16_t x0, uint16_t y0, uint16_t x
 void ILI9488_DrawPixel(uint16_t x, uint16_t y, uint32_t color){
     if(ili9488_rotation == ILI9488_ROTATION_PORTRAIT || ili9488_rotation == ILI9488_ROTATION_PORTRAIT_INV){
         ILI9488_SetAddressWindow(x, y, x, y);
-        ILI9488_WriteData(color & 0x3FFFF); /* 18-bit color */
+        ILI9488_WriteBusRun(ILI9488_COLOR_TO_BUS(color), 1); /* 18-bit color */
     }
     else if(ili9488_rotation == ILI9488_ROTATION_LANDSCAPE || ili9488_rotation == ILI9488_ROTATION_LANDSCAPE_INV){
         ILI9488_SetAddressWindow(y, x, y, x);
-        ILI9488_WriteData(color & 0x3FFFF); /* 18-bit color */
+        ILI9488_WriteBusRun(ILI9488_COLOR_TO_BUS(color), 1); /* 18-bit color */
     }
 }
 
+/**
+ * @brief Fill a rectangle given in signed coordinates, clipped to the screen
+ * @param x Left edge, may be negative
+ * @param y Top edge, may be negative
+ * @param w Width, may be 0 or less for nothing
+ * @param h Height, may be 0 or less for nothing
+ * @param color 18-bit RGB color (RGB666 format, 0x000000 to 0x3FFFFF)
+ */
+static void ILI9488_FillSpan(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color){
+    int32_t x1 = x + w, y1 = y + h;
+    if(x < 0) x = 0;
+    if(y < 0) y = 0;
+    if(x1 > ILI9488_GetWidth()) x1 = ILI9488_GetWidth();
+    if(y1 > ILI9488_GetHeight()) y1 = ILI9488_GetHeight();
+    if(x >= x1 || y >= y1) return;
+    ILI9488_FillRect((uint16_t)x, (uint16_t)y, (uint16_t)(x1 - x), (uint16_t)(y1 - y), color);
+}
+
 /**
  * @brief Draw a line on the display
  * @param x0 Starting X coordinate (0 to 319 or 0 to 479 for vertical)
@@ -174,21 +985,37 @@ void ILI9488_DrawPixel(uint16_t x, uint16_t y, uint32_t color){
  * @param y1 Ending Y coordinate (0 to 479 or 0 to 319 for horizontal)
  * @param color 18-bit RGB color (RGB666 format, 0x000000 to 0x3FFFFF)
  * @details This function draws a line between two points with the specified color.
- *          The line is drawn using Bresenham's algorithm.
+ *          The line is drawn using Bresenham's algorithm. Pixels that share a
+ *          row (mostly horizontal lines) or a column (mostly vertical lines)
+ *          are sent as one run in one address window, so horizontal and
+ *          vertical lines cost a single window.
  */
 void ILI9488_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint32_t color){
-    if(ili9488_rotation == ILI9488_ROTATION_PORTRAIT || ili9488_rotation == ILI9488_ROTATION_PORTRAIT_INV){
-        ILI9488_SetAddressWindow(x0, y0, x1, y1);
-        for(uint32_t i = 0; i < (uint32_t)ILI9488_PORTRAIT_WIDTH * ILI9488_PORTRAIT_HEIGHT; i++){
-            ILI9488_WriteData(color & 0x3FFFF);
+    int32_t dx = x1 > x0 ? x1 - x0 : x0 - x1, sx = x0 < x1 ? 1 : -1;
+    int32_t dy = y1 > y0 ? y0 - y1 : y1 - y0, sy = y0 < y1 ? 1 : -1;
+    int32_t err = dx + dy, x = x0, y = y0;
+    uint8_t horizontal = dx >= -dy;
+    int32_t run_x = x, run_y = y, run = 0;
+
+    for(;;){
+        /* Extend the run along the major axis, or send it and start a new one */
+        if(run && (horizontal ? y != run_y : x != run_x)){
+            if(horizontal) ILI9488_FillSpan(sx > 0 ? run_x : run_x - run + 1, run_y, run, 1, color);
+            else ILI9488_FillSpan(run_x, sy > 0 ? run_y : run_y - run + 1, 1, run, color);
+            run = 0;
         }
-    }
-    else if(ili9488_rotation == ILI9488_ROTATION_LANDSCAPE || ili9488_rotation == ILI9488_ROTATION_LANDSCAPE_INV){
-        ILI9488_SetAddressWindow(y0, x0, y1, x1);
-        for(uint32_t i = 0; i < (uint32_t)ILI9488_LANDSCAPE_WIDTH * ILI9488_LANDSCAPE_HEIGHT; i++){
-            ILI9488_WriteData(color & 0x3FFFF);
+        if(!run){
+            run_x = x;
+            run_y = y;
         }
+        run++;
+        if(x == x1 && y == y1) break;
+        int32_t e2 = 2 * err;
+        if(e2 >= dy){ err += dy; x += sx; }
+        if(e2 <= dx){ err += dx; y += sy; }
     }
+    if(horizontal) ILI9488_FillSpan(sx > 0 ? run_x : run_x - run + 1, run_y, run, 1, color);
+    else ILI9488_FillSpan(run_x, sy > 0 ? run_y : run_y - run + 1, 1, run, color);
 }
 
 /**
@@ -198,22 +1025,12 @@ void ILI9488_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint32
  * @param w Width of rectangle (1 to 320 or 1 to 480)
  * @param h Height of rectangle (1 to 320 or 1 to 480)
  * @param color 18-bit RGB color (RGB666 format, 0x000000 to 0x3FFFFF)
- * @details This function draws a rectangle with the specified color.
- *          The rectangle is drawn using Bresenham's algorithm.
+ * @details This function draws a filled rectangle with the specified color.
+ *          The part off the screen is clipped, so the rectangle may reach
+ *          past the right and bottom edges.
  */
 void ILI9488_DrawRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint32_t color){
-    if(ili9488_rotation == ILI9488_ROTATION_PORTRAIT || ili9488_rotation == ILI9488_ROTATION_PORTRAIT_INV){
-        ILI9488_SetAddressWindow(x, y, x + w - 1, y + h - 1);
-        for(uint32_t i = 0; i < (uint32_t)w * h; i++){
-            ILI9488_WriteData(color & 0x3FFFF);
-        }
-    }
-    else if(ili9488_rotation == ILI9488_ROTATION_LANDSCAPE || ili9488_rotation == ILI9488_ROTATION_LANDSCAPE_INV){
-        ILI9488_SetAddressWindow(y, x, y + h - 1, x + w - 1);
-        for(uint32_t i = 0; i < (uint32_t)h * w; i++){
-            ILI9488_WriteData(color & 0x3FFFF);
-        }
-    }
+    ILI9488_FillSpan(x, y, w, h, color);
 }
 
 /**
@@ -225,21 +1042,47 @@ void ILI9488_DrawRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint32_t c
  * @param color 18-bit RGB color (RGB666 format, 0x000000 to 0x3FFFFF)
  * @details This function fills a rectangle with the specified color.
  *          The coordinates are automatically adjusted based on the current
- *          display rotation.
+ *          display rotation. The color is latched once and repeated with
+ *          WR strobes only.
  */
 void ILI9488_FillRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint32_t color){
     if(ili9488_rotation == ILI9488_ROTATION_PORTRAIT || ili9488_rotation == ILI9488_ROTATION_PORTRAIT_INV){
         ILI9488_SetAddressWindow(x, y, x + w - 1, y + h - 1);
-        for(uint32_t i = 0; i < (uint32_t)w * h; i++){
-            ILI9488_WriteData(color & 0x3FFFF);
-        }
+        ILI9488_WriteColor(color, (uint32_t)w * h);
     }
     else if(ili9488_rotation == ILI9488_ROTATION_LANDSCAPE || ili9488_rotation == ILI9488_ROTATION_LANDSCAPE_INV){
         ILI9488_SetAddressWindow(y, x, y + h - 1, x + w - 1);
-        for(uint32_t i = 0; i < (uint32_t)h * w; i++){
-            ILI9488_WriteData(color & 0x3FFFF);
-        }
+        ILI9488_WriteColor(color, (uint32_t)h * w);
+    }
+}
+
+/**
+ * @brief Draw the eight mirrored segments of a circle outline
+ * @param x0 Center X coordinate
+ * @param y0 Center Y coordinate
+ * @param x Distance of the segments from the center
+ * @param a First offset along the segments
+ * @param b Last offset along the segments
+ * @param color 18-bit RGB color (RGB666 format, 0x000000 to 0x3FFFFF)
+ */
+static void ILI9488_CircleSegments(int32_t x0, int32_t y0, int32_t x, int32_t a, int32_t b, uint32_t color){
+    int32_t n = b - a + 1;
+    if(a == 0){
+        /* The segments on both sides of an axis meet there; send them as one */
+        ILI9488_FillSpan(x0 + x, y0 - b, 1, 2 * b + 1, color);
+        ILI9488_FillSpan(x0 - x, y0 - b, 1, 2 * b + 1, color);
+        ILI9488_FillSpan(x0 - b, y0 + x, 2 * b + 1, 1, color);
+        ILI9488_FillSpan(x0 - b, y0 - x, 2 * b + 1, 1, color);
+        return;
     }
+    ILI9488_FillSpan(x0 + x, y0 + a, 1, n, color);
+    ILI9488_FillSpan(x0 + x, y0 - b, 1, n, color);
+    ILI9488_FillSpan(x0 - x, y0 + a, 1, n, color);
+    ILI9488_FillSpan(x0 - x, y0 - b, 1, n, color);
+    ILI9488_FillSpan(x0 + a, y0 + x, n, 1, color);
+    ILI9488_FillSpan(x0 - b, y0 + x, n, 1, color);
+    ILI9488_FillSpan(x0 + a, y0 - x, n, 1, color);
+    ILI9488_FillSpan(x0 - b, y0 - x, n, 1, color);
 }
 
 /**
@@ -248,22 +1091,31 @@ void ILI9488_FillRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint32_t c
  * @param y0 Center Y coordinate (0 to 479 or 0 to 319 for horizontal)
  * @param radius Circle radius
  * @param color 18-bit RGB color (RGB666 format, 0x000000 to 0x3FFFFF)
- * @details This function draws a circle with the specified color.
- *          The circle is drawn using Bresenham's algorithm.
+ * @details This function draws a circle outline with the specified color,
+ *          clipped to the screen. The outline is traced with the midpoint
+ *          algorithm, and the points at one distance from the center are sent
+ *          as a vertical and a horizontal run in each octant.
  */
 void ILI9488_DrawCircle(uint16_t x0, uint16_t y0, uint16_t radius, uint32_t color){
-    if(ili9488_rotation == ILI9488_ROTATION_PORTRAIT || ili9488_rotation == ILI9488_ROTATION_PORTRAIT_INV){
-        ILI9488_SetAddressWindow(x0, y0, x0 + radius, y0 + radius);
-        for(uint32_t i = 0; i < (uint32_t)ILI9488_PORTRAIT_WIDTH * ILI9488_PORTRAIT_HEIGHT; i++){
-            ILI9488_WriteData(color & 0x3FFFF);
-        }
+    int32_t x = radius, y = 0, d = 1 - (int32_t)radius, first = 0;
+
+    if(radius == 0){
+        ILI9488_FillSpan(x0, y0, 1, 1, color);
+        return;
     }
-    else if(ili9488_rotation == ILI9488_ROTATION_LANDSCAPE || ili9488_rotation == ILI9488_ROTATION_LANDSCAPE_INV){
-        ILI9488_SetAddressWindow(y0, x0, y0 + radius, x0 + radius);
-        for(uint32_t i = 0; i < (uint32_t)ILI9488_LANDSCAPE_WIDTH * ILI9488_LANDSCAPE_HEIGHT; i++){
-            ILI9488_WriteData(color & 0x3FFFF);
+    while(y <= x){
+        y++;
+        if(d < 0){
+            d += 2 * y + 1;
+        }
+        else{
+            ILI9488_CircleSegments(x0, y0, x, first, y - 1, color);
+            x--;
+            first = y;
+            d += 2 * (y - x) + 1;
         }
     }
+    if(first <= x) ILI9488_CircleSegments(x0, y0, x, first, y - 1, color);
 }
 
 /**
@@ -272,20 +1124,28 @@ void ILI9488_DrawCircle(uint16_t x0, uint16_t y0, uint16_t radius, uint32_t colo
  * @param y0 Center Y coordinate (0 to 479 or 0 to 319 for horizontal)
  * @param radius Circle radius
  * @param color 18-bit RGB color (RGB666 format, 0x000000 to 0x3FFFFF)
- * @details This function fills a circle with the specified color.
- *          The circle is filled using Bresenham's algorithm.
+ * @details This function fills a circle with the specified color, clipped to
+ *          the screen. The rows come from the same midpoint walk as
+ *          ILI9488_DrawCircle(), and every row is sent once as a single run.
  */
 void ILI9488_FillCircle(uint16_t x0, uint16_t y0, uint16_t radius, uint32_t color){
-    if(ili9488_rotation == ILI9488_ROTATION_PORTRAIT || ili9488_rotation == ILI9488_ROTATION_PORTRAIT_INV){
-        ILI9488_SetAddressWindow(x0, y0, x0 + radius, y0 + radius);
-        for(uint32_t i = 0; i < (uint32_t)ILI9488_PORTRAIT_WIDTH * ILI9488_PORTRAIT_HEIGHT; i++){
-            ILI9488_WriteData(color & 0x3FFFF);
+    int32_t x = radius, y = 0, d = 1 - (int32_t)radius;
+
+    while(y <= x){
+        ILI9488_FillSpan(x0 - x, y0 + y, 2 * x + 1, 1, color);
+        if(y) ILI9488_FillSpan(x0 - x, y0 - y, 2 * x + 1, 1, color);
+        y++;
+        if(d < 0){
+            d += 2 * y + 1;
         }
-    }
-    else if(ili9488_rotation == ILI9488_ROTATION_LANDSCAPE || ili9488_rotation == ILI9488_ROTATION_LANDSCAPE_INV){
-        ILI9488_SetAddressWindow(y0, x0, y0 + radius, x0 + radius);
-        for(uint32_t i = 0; i < (uint32_t)ILI9488_LANDSCAPE_WIDTH * ILI9488_LANDSCAPE_HEIGHT; i++){
-            ILI9488_WriteData(color & 0x3FFFF);
+        else{
+            /* Rows at distance x end here, as wide as the last y */
+            if(x > y - 1){
+                ILI9488_FillSpan(x0 - (y - 1), y0 + x, 2 * y - 1, 1, color);
+                ILI9488_FillSpan(x0 - (y - 1), y0 - x, 2 * y - 1, 1, color);
+            }
+            x--;
+            d += 2 * (y - x) + 1;
         }
     }
 }
@@ -293,22 +1153,11 @@ void ILI9488_FillCircle(uint16_t x0, uint16_t y0, uint16_t radius, uint32_t colo
 /**
  * @brief Fill the entire display with a color
  * @param color 18-bit RGB color (RGB666 format, 0x000000 to 0x3FFFFF)
- * @details This function fills the entire display with the specified color.
- *          The display is filled using Bresenham's algorithm.
+ * @details This function fills the entire display with the specified color
+ *          in one address window covering the current rotation.
  */
 void ILI9488_FillBackground(uint32_t color){
-    if(ili9488_rotation == ILI9488_ROTATION_PORTRAIT || ili9488_rotation == ILI9488_ROTATION_PORTRAIT_INV){
-        ILI9488_SetAddressWindow(0, 0, ILI9488_PORTRAIT_WIDTH - 1, ILI9488_PORTRAIT_HEIGHT - 1);
-        for(uint32_t i = 0; i < (uint32_t)ILI9488_PORTRAIT_WIDTH * ILI9488_PORTRAIT_HEIGHT; i++){
-            ILI9488_WriteData(color & 0x3FFFF);
-        }
-    }
-    else if(ili9488_rotation == ILI9488_ROTATION_LANDSCAPE || ili9488_rotation == ILI9488_ROTATION_LANDSCAPE_INV){
-        ILI9488_SetAddressWindow(0, 0, ILI9488_LANDSCAPE_WIDTH - 1, ILI9488_LANDSCAPE_HEIGHT - 1);
-        for(uint32_t i = 0; i < (uint32_t)ILI9488_LANDSCAPE_WIDTH * ILI9488_LANDSCAPE_HEIGHT; i++){
-            ILI9488_WriteData(color & 0x3FFFF);
-        }
-    }
+    ILI9488_FillRect(0, 0, ILI9488_GetWidth(), ILI9488_GetHeight(), color);
 }
 
 /**
@@ -355,7 +1204,11 @@ static inline void ILI9488_SetRotation(uint8_t rotation){
  *       in the main.h file.
  */
 void ILI9488_Init(ILI9488_Rotation_t rotation){
+#if ILI9488_TRANSPORT == ILI9488_TRANSPORT_TIMER
+    ILI9488_TimerInit();
+#endif
     /* Hardware reset */
+    ILI9488_TraceReset();
     ILI9488_RESET_GPIO_Port->BSRR = (uint32_t)ILI9488_RESET_Pin << 16; /* RESET low */
     HAL_Delay(20);
     ILI9488_RESET_GPIO_Port->BSRR = ILI9488_RESET_Pin; /* RESET high */
@@ -366,6 +1219,10 @@ void ILI9488_Init(ILI9488_Rotation_t rotation){
     ILI9488_WriteData(0x66); /* 18-bit/pixel */
     ILI9488_SetRotation(rotation);
     ili9488_rotation = rotation; /* Store the rotation value for future use */
+#ifdef ILI9488_TE_Pin
+    ILI9488_WriteCommand(CMD_TEARING_ON);
+    ILI9488_WriteData(0x00); /* TE pulses on V-blank only */
+#endif
     ILI9488_WriteCommand(CMD_DISPLAY_ON);
     HAL_Delay(20);
 }
@@ -415,13 +1272,84 @@ void ILI9488_WakeUp(void){
     HAL_Delay(20);
 }
 
+/**
+ * @brief Get the current display rotation
+ * @return Rotation set by ILI9488_Init()
+ */
+ILI9488_Rotation_t ILI9488_GetRotation(void){
+    return ili9488_rotation;
+}
 
+/**
+ * @brief Get the display width for the current rotation
+ * @return 320 in portrait, 480 in landscape
+ */
+uint16_t ILI9488_GetWidth(void){
+    if(ili9488_rotation == ILI9488_ROTATION_LANDSCAPE || ili9488_rotation == ILI9488_ROTATION_LANDSCAPE_INV){
+        return ILI9488_LANDSCAPE_WIDTH;
+    }
+    return ILI9488_PORTRAIT_WIDTH;
+}
 
+/**
+ * @brief Get the display height for the current rotation
+ * @return 480 in portrait, 320 in landscape
+ */
+uint16_t ILI9488_GetHeight(void){
+    if(ili9488_rotation == ILI9488_ROTATION_LANDSCAPE || ili9488_rotation == ILI9488_ROTATION_LANDSCAPE_INV){
+        return ILI9488_LANDSCAPE_HEIGHT;
+    }
+    return ILI9488_PORTRAIT_HEIGHT;
+}
 
+/**
+ * @brief Define the vertical scrolling area
+ * @param top Number of fixed lines at the top of the panel
+ * @param scroll Number of lines in the scrolling area
+ * @param bottom Number of fixed lines at the bottom of the panel
+ * @details The three values must add up to ILI9488_PORTRAIT_HEIGHT (480).
+ *          Lines are counted along the panel's gate (scan) direction, which
+ *          is the Y axis in portrait and the X axis in landscape.
+ */
+void ILI9488_SetScrollArea(uint16_t top, uint16_t scroll, uint16_t bottom){
+    ILI9488_WriteCommand(CMD_VSCROLL_DEF);
+    ILI9488_WriteData(top >> 8); ILI9488_WriteData(top & 0xFF);
+    ILI9488_WriteData(scroll >> 8); ILI9488_WriteData(scroll & 0xFF);
+    ILI9488_WriteData(bottom >> 8); ILI9488_WriteData(bottom & 0xFF);
+}
 
+/**
+ * @brief Set the vertical scrolling start address
+ * @param line Frame memory line shown on the first line of the scrolling area
+ * @details The panel shows frame memory line (line + i) on scrolling line i,
+ *          wrapping inside the scrolling area. No pixel data is transferred,
+ *          so a full-screen scroll costs only three bus words.
+ */
+void ILI9488_SetScrollStart(uint16_t line){
+    ILI9488_WriteCommand(CMD_VSCROLL_START);
+    ILI9488_WriteData(line >> 8); ILI9488_WriteData(line & 0xFF);
+}
 
+/**
+ * @brief Leave scroll mode and return to normal display mode
+ * @details The scrolling start address should be back at 0 beforehand so
+ *          the frame memory is shown at its natural position.
+ */
+void ILI9488_ResetScroll(void){
+    ILI9488_WriteCommand(CMD_NORMAL_MODE);
+}
 
-
-
-
-
+/**
+ * @brief Wait for the start of the next vertical blanking period
+ * @details Blocks until a rising edge on the TE line, so that writes issued
+ *          right after the call run ahead of the panel's refresh scan. If
+ *          ILI9488_TE_Pin is not defined in main.h, the function returns
+ *          immediately.
+ */
+void ILI9488_WaitForTE(void){
+#ifdef ILI9488_TE_Pin
+    while(ILI9488_TE_GPIO_Port->IDR & ILI9488_TE_Pin);    /* Let a pulse in progress end */
+    while(!(ILI9488_TE_GPIO_Port->IDR & ILI9488_TE_Pin)); /* Wait for the next rising edge */
+    ILI9488_TraceVsync();
+#endif
+}
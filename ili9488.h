@@ -21,6 +21,90 @@ extern "C" {
  /* For GPIO definitions */
 #include "main.h"
 
+/* Bus transports, chosen with ILI9488_TRANSPORT in main.h or on the compiler command line */
+#define ILI9488_TRANSPORT_8080  0   ///< 18-bit 8080 parallel bus bit-banged on GPIO (DB0-DB17, WR, CS, DCX)
+#define ILI9488_TRANSPORT_SPI   1   ///< 4-wire SPI (SCK, MOSI, CS, DCX), 3 bytes per pixel, DMA for pixels
+#define ILI9488_TRANSPORT_TIMER 2   ///< 18-bit 8080 bus with WR from a timer and the data lines written by DMA
+
+#ifndef ILI9488_TRANSPORT
+#define ILI9488_TRANSPORT  ILI9488_TRANSPORT_8080
+#endif
+
+#if ILI9488_TRANSPORT == ILI9488_TRANSPORT_SPI
+/* HAL handle of the SPI peripheral: 8-bit frames, MSB first, mode 0, TX DMA stream in normal mode */
+#ifndef ILI9488_SPI_HANDLE
+#define ILI9488_SPI_HANDLE  hspi1
+#endif
+extern SPI_HandleTypeDef ILI9488_SPI_HANDLE;
+
+/* Pixels converted per DMA transfer of a burst (two buffers of 3 bytes per pixel, at most 21845) */
+#ifndef ILI9488_SPI_CHUNK
+#define ILI9488_SPI_CHUNK  256
+#endif
+
+/* Pixels in the repeated buffer of a solid run (3 bytes per pixel, at most 21845) */
+#ifndef ILI9488_SPI_FILL
+#define ILI9488_SPI_FILL  64
+#endif
+
+/* Shortest transfer in bytes worth a DMA transfer, shorter ones are written by the CPU */
+#ifndef ILI9488_SPI_DMA_MIN
+#define ILI9488_SPI_DMA_MIN  16
+#endif
+#elif ILI9488_TRANSPORT == ILI9488_TRANSPORT_TIMER
+/* HAL handle of the advanced timer pacing the bus: CH1 in PWM mode 1 (active high) on the WR pin,
+   CH2 and CH3 with memory-to-peripheral word DMA streams in normal mode, and the update interrupt
+   calling ILI9488_TimerIRQHandler() */
+#ifndef ILI9488_TIMER_HANDLE
+#define ILI9488_TIMER_HANDLE  htim1
+#endif
+extern TIM_HandleTypeDef ILI9488_TIMER_HANDLE;
+
+/* The two GPIO ports holding DB0-DB17, written by the CH2 and CH3 streams */
+#ifndef ILI9488_TIMER_PORT0
+#define ILI9488_TIMER_PORT0  DB0_GPIO_Port
+#endif
+#ifndef ILI9488_TIMER_PORT1
+#define ILI9488_TIMER_PORT1  DB17_GPIO_Port
+#endif
+
+/* Timer ticks per bus word; WR is low in the second half */
+#ifndef ILI9488_TIMER_PERIOD
+#define ILI9488_TIMER_PERIOD  12
+#endif
+
+/* Timer ticks after the WR rising edge before the next word is driven */
+#ifndef ILI9488_TIMER_HOLD
+#define ILI9488_TIMER_HOLD  1
+#endif
+
+/* Words per timer run, at most the range of the repetition counter (256 with an 8-bit RCR) */
+#ifndef ILI9488_TIMER_CHUNK
+#define ILI9488_TIMER_CHUNK  256
+#endif
+#endif /* ILI9488_TRANSPORT */
+
+/* Linker section for the hot paths (bus transport, solid fills, blit and glyph inner loops), for example
+   ".itcm_text" for the ITCM of F7/H7 or ".ccmram" for the CCM SRAM of F3/G4; the startup code must copy
+   it from flash. Unset, or in a build for anything but an Arm core, the functions stay in .text */
+#ifndef ILI9488_FAST
+#if defined(ILI9488_FAST_SECTION) && defined(__GNUC__) && defined(__arm__)
+#define ILI9488_FAST  __attribute__((section(ILI9488_FAST_SECTION), noinline))
+#else
+#define ILI9488_FAST
+#endif
+#endif
+
+/* Same section for the per-pixel and per-row helpers of ILI9488_FAST functions, still inlined into them;
+   an out-of-line copy the compiler keeps lands in RAM too */
+#ifndef ILI9488_FAST_INLINE
+#if defined(ILI9488_FAST_SECTION) && defined(__GNUC__) && defined(__arm__)
+#define ILI9488_FAST_INLINE  __attribute__((section(ILI9488_FAST_SECTION)))
+#else
+#define ILI9488_FAST_INLINE
+#endif
+#endif
+
 /* Display dimensions */
 #define ILI9488_PORTRAIT_WIDTH       320
 #define ILI9488_PORTRAIT_HEIGHT      480
@@ -37,6 +121,14 @@ extern "C" {
 #define ILI9488_CYAN        0x003F3F
 #define ILI9488_MAGENTA     0x3F003F
 
+/**
+ * @brief Convert an RGB666 color to an 18-bit bus word
+ * @details Colors keep each 6-bit channel in its own byte (0x00RRGGBB, as in
+ *          the definitions above). In 18 bpp mode the panel expects red on
+ *          DB17-DB12, green on DB11-DB6 and blue on DB5-DB0.
+ */
+#define ILI9488_COLOR_TO_BUS(c)  ((((c) >> 4) & 0x3F000) | (((c) >> 2) & 0xFC0) | ((c) & 0x3F))
+
 /* Display rotation values */
 typedef enum {
     ILI9488_ROTATION_PORTRAIT = 0,
@@ -45,6 +137,12 @@ typedef enum {
     ILI9488_ROTATION_LANDSCAPE_INV = 3
 } ILI9488_Rotation_t;
 
+/* Bitmap sampling filters for scaled and transformed blits */
+typedef enum {
+    ILI9488_FILTER_NEAREST = 0,  ///< Nearest texel, no blending
+    ILI9488_FILTER_BILINEAR = 1  ///< Weighted average of the four nearest texels
+} ILI9488_Filter_t;
+
 /**
  * @brief Initialize the ILI9488 display
  * @param rotation Initial display rotation (0-3)
@@ -55,7 +153,7 @@ typedef enum {
  *          4. Set display rotation
  *          5. Turn display on
  */
-void ILI9488_Init(uint8_t rotation);
+void ILI9488_Init(ILI9488_Rotation_t rotation);
 
 /**
  * @brief Draw a single pixel on the display
@@ -82,6 +180,7 @@ void ILI9488_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint32
  * @param w Width of rectangle (1 to 320 or 1 to 480)
  * @param h Height of rectangle (1 to 320 or 1 to 480)
  * @param color 18-bit RGB color (RGB666 format, 0x000000 to 0x3FFFFF)
+ * @details The rectangle is filled, and clipped at the right and bottom edges.
  */
 void ILI9488_DrawRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint32_t color);
 
@@ -113,6 +212,139 @@ void ILI9488_DrawCircle(uint16_t x0, uint16_t y0, uint16_t radius, uint32_t colo
  */
 void ILI9488_FillCircle(uint16_t x0, uint16_t y0, uint16_t radius, uint32_t color);
 
+/**
+ * @brief Open an address window for streaming pixels
+ * @param x Left edge of the window
+ * @param y Top edge of the window
+ * @param w Width of the window (1 or more)
+ * @param h Height of the window (1 or more)
+ */
+void ILI9488_SetWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+/**
+ * @brief Resume a memory write in the current address window
+ * @details Pixels sent afterwards continue after the last pixel written.
+ */
+void ILI9488_WriteContinue(void);
+
+/**
+ * @brief Stream pixels into the current address window
+ * @param pixels 18-bit RGB colors (RGB666 format)
+ * @param count Number of pixels
+ */
+void ILI9488_WritePixels(const uint32_t *pixels, uint32_t count);
+
+/**
+ * @brief Stream pre-packed bus words into the current address window
+ * @param words 18-bit bus words (see ILI9488_COLOR_TO_BUS)
+ * @param count Number of pixels
+ */
+void ILI9488_WriteBus(const uint32_t *words, uint32_t count);
+
+/**
+ * @brief Stream a run of one bus word into the current address window
+ * @param word 18-bit bus word (see ILI9488_COLOR_TO_BUS)
+ * @param count Number of pixels
+ */
+void ILI9488_WriteBusRun(uint32_t word, uint32_t count);
+
+/**
+ * @brief Stream a run of one color into the current address window
+ * @param color 18-bit RGB color (RGB666 format, 0x000000 to 0x3FFFFF)
+ * @param count Number of pixels
+ * @details The data pins are driven once and only WR is strobed per pixel.
+ */
+void ILI9488_WriteColor(uint32_t color, uint32_t count);
+
+/**
+ * @brief Check whether a background transfer is still running
+ * @return 1 while the bus is busy, always 0 with transports that return when idle
+ */
+uint8_t ILI9488_BusBusy(void);
+
+/**
+ * @brief Wait for the background transfer to finish
+ * @details With the timer transport, pixel bursts and runs go on after the
+ *          call that started them returns; every bus access waits for them
+ *          first. Call this before reusing a buffer given to
+ *          ILI9488_WriteBsrr() or before sleeping the core.
+ */
+void ILI9488_BusWait(void);
+
+#if ILI9488_TRANSPORT == ILI9488_TRANSPORT_TIMER
+/**
+ * @brief Convert bus words into the BSRR words ILI9488_WriteBsrr() sends
+ * @param words 18-bit bus words (see ILI9488_COLOR_TO_BUS)
+ * @param bsrr Output: 2 * count words, the port 0 words followed by the port 1 words
+ * @param count Number of pixels
+ */
+void ILI9488_BusToBsrr(const uint32_t *words, uint32_t *bsrr, uint32_t count);
+
+/**
+ * @brief Stream precomputed BSRR words into the current address window in the background
+ * @param bsrr 2 * count words from ILI9488_BusToBsrr(), untouched until ILI9488_BusWait()
+ * @param count Number of pixels
+ */
+void ILI9488_WriteBsrr(const uint32_t *bsrr, uint32_t count);
+
+/**
+ * @brief Continue a transfer from the timer update interrupt
+ */
+void ILI9488_TimerIRQHandler(void);
+
+/* BSRR words of the window commands sent before each rectangle of a chain */
+#define ILI9488_CHAIN_WINDOW  11
+
+/**
+ * @brief Node of a chain of BSRR transfers, sent one after another by the timer interrupt
+ */
+typedef struct ILI9488_BsrrNode {
+    const uint32_t *bsrr;                   ///< Port 0 BSRR words
+    uint32_t stride;                        ///< Offset of the port 1 words from the port 0 words
+    uint32_t count;                         ///< Number of words (1 or more)
+    const struct ILI9488_BsrrNode *next;    ///< Node sent next, NULL at the end of the chain
+} ILI9488_BsrrNode_t;
+
+/**
+ * @brief Rectangle of a chain: its window commands followed by its pixels
+ */
+typedef struct {
+    ILI9488_BsrrNode_t window;                  ///< Column, page and memory write commands
+    ILI9488_BsrrNode_t pixels;                  ///< Pixel burst
+    uint32_t words[2 * ILI9488_CHAIN_WINDOW];   ///< BSRR words of the commands, port 0 then port 1
+} ILI9488_ChainRect_t;
+
+/**
+ * @brief Build the nodes sending one rectangle of a chain
+ * @param rect Storage for the nodes and the window words, untouched until ILI9488_BusWait()
+ * @param x Left edge of the rectangle
+ * @param y Top edge of the rectangle
+ * @param w Width of the rectangle (1 or more)
+ * @param h Height of the rectangle (1 or more)
+ * @param bsrr 2 * w * h words from ILI9488_BusToBsrr(), untouched until ILI9488_BusWait()
+ * @param prev Rectangle sent before this one, NULL for the first of a chain
+ * @return 1 on success, 0 if DCX is on neither data port or the rectangle is empty
+ */
+uint8_t ILI9488_ChainRect(ILI9488_ChainRect_t *rect, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                          const uint32_t *bsrr, ILI9488_ChainRect_t *prev);
+
+/**
+ * @brief Send a chain of nodes in the background with one start
+ * @param first First node, for example &rect->window of the first ILI9488_ChainRect()
+ */
+void ILI9488_WriteChain(const ILI9488_BsrrNode_t *first);
+#endif
+
+/**
+ * @brief Draw a bitmap on the display
+ * @param x Left edge of the bitmap
+ * @param y Top edge of the bitmap
+ * @param w Width of the bitmap
+ * @param h Height of the bitmap
+ * @param pixels w * h 18-bit RGB colors (RGB666 format), row by row
+ */
+void ILI9488_DrawBitmap(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint32_t *pixels);
+
 /**
  * @brief Fill the entire display with a color
  * @param color 18-bit RGB color (RGB666 format, 0x000000 to 0x3FFFFF)
@@ -133,6 +365,51 @@ void ILI9488_Sleep(void);
  */
 void ILI9488_WakeUp(void);
 
+/**
+ * @brief Get the current display rotation
+ * @return Rotation set by ILI9488_Init()
+ */
+ILI9488_Rotation_t ILI9488_GetRotation(void);
+
+/**
+ * @brief Get the display width for the current rotation
+ * @return 320 in portrait, 480 in landscape
+ */
+uint16_t ILI9488_GetWidth(void);
+
+/**
+ * @brief Get the display height for the current rotation
+ * @return 480 in portrait, 320 in landscape
+ */
+uint16_t ILI9488_GetHeight(void);
+
+/**
+ * @brief Define the vertical scrolling area
+ * @param top Number of fixed lines at the top of the panel
+ * @param scroll Number of lines in the scrolling area
+ * @param bottom Number of fixed lines at the bottom of the panel
+ * @details The three values must add up to 480 lines.
+ */
+void ILI9488_SetScrollArea(uint16_t top, uint16_t scroll, uint16_t bottom);
+
+/**
+ * @brief Set the vertical scrolling start address
+ * @param line Frame memory line shown on the first line of the scrolling area
+ */
+void ILI9488_SetScrollStart(uint16_t line);
+
+/**
+ * @brief Leave scroll mode and return to normal display mode
+ */
+void ILI9488_ResetScroll(void);
+
+/**
+ * @brief Wait for the start of the next vertical blanking period
+ * @details Polls the TE line when ILI9488_TE_Pin is defined in main.h,
+ *          otherwise returns immediately.
+ */
+void ILI9488_WaitForTE(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,304 @@
+/**
+ * @file ili9488_affine.c
+ * @brief ILI9488 affine textured blits (rotation, scale, shear)
+ * @details This file contains the implementation of the fixed-point affine
+ *          blitter. Each destination row is first clipped analytically
+ *          against the texture bounds, so pixels that fall outside the
+ *          texture never reach the bus. Inside the clipped span, texture
+ *          coordinates advance by constant 16.16 steps (additions only) and
+ *          the sampled row is sent through a single address window.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include "ili9488_affine.h"
+
+/**
+ * @brief Sine of 0 to 90 degrees in 16.16 fixed point
+ */
+static const uint32_t ili9488_affine_sine[91] = {
+    0, 1144, 2287, 3430, 4572, 5712, 6850, 7987,
+    9121, 10252, 11380, 12505, 13626, 14742, 15855, 16962,
+    18064, 19161, 20252, 21336, 22415, 23486, 24550, 25607,
+    26656, 27697, 28729, 29753, 30767, 31772, 32768, 33754,
+    34729, 35693, 36647, 37590, 38521, 39441, 40348, 41243,
+    42126, 42995, 43852, 44695, 45525, 46341, 47143, 47930,
+    48703, 49461, 50203, 50931, 51643, 52339, 53020, 53684,
+    54332, 54963, 55578, 56175, 56756, 57319, 57865, 58393,
+    58903, 59396, 59870, 60326, 60764, 61183, 61584, 61966,
+    62328, 62672, 62997, 63303, 63589, 63856, 64104, 64332,
+    64540, 64729, 64898, 65048, 65177, 65287, 65376, 65446,
+    65496, 65526, 65536
+};
+
+/* Output row buffer, one full display row */
+static uint32_t ili9488_affine_row[ILI9488_LANDSCAPE_WIDTH];
+
+/**
+ * @brief Sine of an angle in whole degrees
+ * @param angle Angle in degrees (any value)
+ * @return Sine in 16.16 fixed point
+ */
+static int32_t ILI9488_Affine_Sin(int16_t angle){
+    int16_t a = (int16_t)(angle % 360);
+    if(a < 0) a += 360;
+    if(a <= 90)  return (int32_t)ili9488_affine_sine[a];
+    if(a <= 180) return (int32_t)ili9488_affine_sine[180 - a];
+    if(a <= 270) return -(int32_t)ili9488_affine_sine[a - 180];
+    return -(int32_t)ili9488_affine_sine[360 - a];
+}
+
+/**
+ * @brief Floor division of signed 64-bit values
+ */
+static int64_t ILI9488_Affine_FloorDiv(int64_t n, int64_t d){
+    int64_t q = n / d;
+    if((n % d != 0) && ((n < 0) != (d < 0))) q--;
+    return q;
+}
+
+/**
+ * @brief Restrict a column range to the texels inside the texture
+ * @param start Coordinate at column 0 (16.16)
+ * @param step Coordinate step per column (16.16)
+ * @param limit Largest valid coordinate (16.16)
+ * @param first First column of the range, updated in place
+ * @param last Last column of the range, updated in place
+ * @return 1 if the range is not empty, 0 otherwise
+ * @details Solves 0 <= start + x * step <= limit for x once per row,
+ *          instead of testing every pixel.
+ */
+static uint8_t ILI9488_Affine_Clip(int32_t start, int32_t step, int32_t limit, int32_t *first, int32_t *last){
+    int64_t lo, hi;
+    if(step == 0){
+        return start >= 0 && start <= limit;
+    }
+    if(step > 0){
+        lo = -ILI9488_Affine_FloorDiv(start, step);              /* ceil(-start / step) */
+        hi = ILI9488_Affine_FloorDiv((int64_t)limit - start, step);
+    }
+    else{
+        lo = -ILI9488_Affine_FloorDiv((int64_t)start - limit, step); /* ceil((limit - start) / step) */
+        hi = ILI9488_Affine_FloorDiv(-(int64_t)start, step);
+    }
+    if(lo > *first) *first = (int32_t)lo;
+    if(hi < *last) *last = (int32_t)hi;
+    return *first <= *last;
+}
+
+/**
+ * @brief Blend the four texels around a sample point
+ * @param r0 Texture row above the sample point
+ * @param r1 Texture row below the sample point
+ * @param x0 Column left of the sample point
+ * @param x1 Column right of the sample point
+ * @param fu Horizontal weight of x1, 0 to 255
+ * @param fv Vertical weight of r1, 0 to 255
+ * @return Filtered RGB666 color
+ * @details Red and blue are blended together in one 32-bit lane pair and
+ *          green separately. The four weights always add up to 256.
+ */
+static inline uint32_t ILI9488_Affine_Blend(const uint32_t *r0, const uint32_t *r1, int32_t x0, int32_t x1,
+                                            uint32_t fu, uint32_t fv){
+    uint32_t p00 = r0[x0], p10 = r0[x1], p01 = r1[x0], p11 = r1[x1];
+    uint32_t w11 = (fu * fv) >> 8;
+    uint32_t w10 = fu - w11, w01 = fv - w11, w00 = 256 - fu - fv + w11;
+    uint32_t rb = ((p00 & 0x3F003F) * w00 + (p10 & 0x3F003F) * w10 +
+                   (p01 & 0x3F003F) * w01 + (p11 & 0x3F003F) * w11) >> 8;
+    uint32_t g = ((p00 & 0x3F00) * w00 + (p10 & 0x3F00) * w10 +
+                  (p01 & 0x3F00) * w01 + (p11 & 0x3F00) * w11) >> 8;
+    return (rb & 0x3F003F) | (g & 0x3F00);
+}
+
+/**
+ * @brief Sample a texture with bilinear filtering
+ * @param texture Texture pixels
+ * @param tw Texture width
+ * @param th Texture height
+ * @param u Texture X in 16.16 fixed point
+ * @param v Texture Y in 16.16 fixed point
+ * @return Filtered RGB666 color
+ */
+static inline uint32_t ILI9488_Affine_Bilinear(const uint32_t *texture, uint16_t tw, uint16_t th, int32_t u, int32_t v){
+    u -= ILI9488_FIXED_ONE / 2;
+    v -= ILI9488_FIXED_ONE / 2;
+    int32_t iu = u >> 16, iv = v >> 16;
+    int32_t x0 = iu < 0 ? 0 : iu, x1 = iu + 1 >= tw ? tw - 1 : iu + 1;
+    int32_t y0 = iv < 0 ? 0 : iv, y1 = iv + 1 >= th ? th - 1 : iv + 1;
+    return ILI9488_Affine_Blend(texture + (uint32_t)y0 * tw, texture + (uint32_t)y1 * tw, x0, x1,
+                                (uint32_t)(u >> 8) & 0xFF, (uint32_t)(v >> 8) & 0xFF);
+}
+
+/**
+ * @brief Sample a texture with bilinear filtering
+ * @param texture Texture pixels, tw * th RGB666 colors, row by row
+ * @param tw Texture width
+ * @param th Texture height
+ * @param u Texture X in 16.16 fixed point (texel centers at integer + 0.5)
+ * @param v Texture Y in 16.16 fixed point (texel centers at integer + 0.5)
+ * @return Filtered RGB666 color, with edge texels repeated outside the texture
+ */
+uint32_t ILI9488_SampleBilinear(const uint32_t *texture, uint16_t tw, uint16_t th, int32_t u, int32_t v){
+    return ILI9488_Affine_Bilinear(texture, tw, th, u, v);
+}
+
+/**
+ * @brief Build a rotation and scale mapping around a pivot
+ * @param m Output mapping
+ * @param angle Rotation angle in degrees (clockwise on screen)
+ * @param scale Scale factor in 16.16 fixed point (ILI9488_FIXED_ONE = 1:1)
+ * @param pivot_u Texture pivot X in 16.16 fixed point
+ * @param pivot_v Texture pivot Y in 16.16 fixed point
+ * @param dst_x Destination X of the pivot, relative to the destination origin
+ * @param dst_y Destination Y of the pivot, relative to the destination origin
+ */
+void ILI9488_AffineRotozoom(ILI9488_Affine_t *m, int16_t angle, int32_t scale,
+                            int32_t pivot_u, int32_t pivot_v, int16_t dst_x, int16_t dst_y){
+    int32_t s = ILI9488_Affine_Sin(angle);
+    int32_t c = ILI9488_Affine_Sin((int16_t)(angle + 90));
+    if(scale <= 0) scale = ILI9488_FIXED_ONE;
+
+    /* Inverse of a clockwise rotation followed by a scale */
+    m->dudx = (int32_t)(((int64_t)c << 16) / scale);
+    m->dudy = (int32_t)(((int64_t)s << 16) / scale);
+    m->dvdx = -m->dudy;
+    m->dvdy = m->dudx;
+
+    /* Sample at pixel centers: offset of the first center from the pivot */
+    int32_t ox = ILI9488_FIXED_ONE / 2 - ((int32_t)dst_x << 16);
+    int32_t oy = ILI9488_FIXED_ONE / 2 - ((int32_t)dst_y << 16);
+    m->u0 = pivot_u + (int32_t)(((int64_t)m->dudx * ox + (int64_t)m->dudy * oy) >> 16);
+    m->v0 = pivot_v + (int32_t)(((int64_t)m->dvdx * ox + (int64_t)m->dvdy * oy) >> 16);
+}
+
+/**
+ * @brief Apply a shear on top of a mapping
+ * @param m Mapping to modify
+ * @param shear_x Horizontal shear in 16.16 fixed point (texture U per destination row)
+ * @param shear_y Vertical shear in 16.16 fixed point (texture V per destination column)
+ */
+void ILI9488_AffineShear(ILI9488_Affine_t *m, int32_t shear_x, int32_t shear_y){
+    m->dudy += shear_x;
+    m->dvdx += shear_y;
+    m->u0 += shear_x / 2;
+    m->v0 += shear_y / 2;
+}
+
+/**
+ * @brief Draw a texture through an affine mapping
+ * @param x Left edge of the destination rectangle (may be off-screen)
+ * @param y Top edge of the destination rectangle (may be off-screen)
+ * @param w Width of the destination rectangle
+ * @param h Height of the destination rectangle
+ * @param texture Texture pixels, tw * th RGB666 colors, row by row
+ * @param tw Texture width (1 to 2048)
+ * @param th Texture height (1 to 2048)
+ * @param m Inverse mapping from destination to texture coordinates
+ * @param filter Sampling filter
+ * @details The destination rectangle is clipped to the screen, then each
+ *          row is clipped against the texture. The remaining span is
+ *          sampled with incremental coordinates and written through one
+ *          address window per row.
+ */
+ILI9488_FAST void ILI9488_DrawAffine(int16_t x, int16_t y, uint16_t w, uint16_t h,
+                                     const uint32_t *texture, uint16_t tw, uint16_t th,
+                                     const ILI9488_Affine_t *m, ILI9488_Filter_t filter){
+    int32_t x0 = x < 0 ? 0 : x, y0 = y < 0 ? 0 : y;
+    int32_t x1 = (int32_t)x + w, y1 = (int32_t)y + h;
+    if(x1 > ILI9488_GetWidth()) x1 = ILI9488_GetWidth();
+    if(y1 > ILI9488_GetHeight()) y1 = ILI9488_GetHeight();
+    if(x0 >= x1 || y0 >= y1 || tw == 0 || th == 0) return;
+
+    int32_t umax = ((int32_t)tw << 16) - 1;
+    int32_t vmax = ((int32_t)th << 16) - 1;
+
+    /* Texture coordinates at the first visible column of the first visible row */
+    int32_t u_row = m->u0 + (x0 - x) * m->dudx + (y0 - y) * m->dudy;
+    int32_t v_row = m->v0 + (x0 - x) * m->dvdx + (y0 - y) * m->dvdy;
+
+    for(int32_t row = y0; row < y1; row++, u_row += m->dudy, v_row += m->dvdy){
+        int32_t first = 0, last = x1 - x0 - 1;
+        if(!ILI9488_Affine_Clip(u_row, m->dudx, umax, &first, &last)) continue;
+        if(!ILI9488_Affine_Clip(v_row, m->dvdx, vmax, &first, &last)) continue;
+
+        int32_t u = u_row + first * m->dudx;
+        int32_t v = v_row + first * m->dvdx;
+        uint32_t *out = ili9488_affine_row;
+        if(filter == ILI9488_FILTER_BILINEAR){
+            /* Step the upper row and its offset as the nearest loop does; only the edge rows are clamped */
+            int32_t vb = v - ILI9488_FIXED_ONE / 2;
+            int32_t iv = vb >> 16, iv_step = m->dvdx >> 16;
+            int32_t line = iv * (int32_t)tw;
+            int32_t line_step = iv_step * (int32_t)tw;
+            uint32_t frac = (uint32_t)vb & 0xFFFF, frac_step = (uint32_t)m->dvdx & 0xFFFF;
+            u -= ILI9488_FIXED_ONE / 2;
+            for(int32_t i = first; i <= last; i++, u += m->dudx){
+                int32_t iu = u >> 16;
+                int32_t left = iu < 0 ? 0 : iu, right = iu + 1 >= tw ? tw - 1 : iu + 1;
+                const uint32_t *r0 = texture + line + (iv < 0 ? tw : 0);
+                const uint32_t *r1 = texture + line + (iv + 1 < th ? tw : 0);
+                *out++ = ILI9488_Affine_Blend(r0, r1, left, right, (uint32_t)(u >> 8) & 0xFF, frac >> 8);
+                iv += iv_step;
+                line += line_step;
+                frac += frac_step;
+                if(frac & 0x10000){
+                    frac &= 0xFFFF;
+                    iv++;
+                    line += tw;
+                }
+            }
+        }
+        else{
+            /* Step the row offset instead of multiplying v by the texture width per pixel: the integer
+               part of dvdx moves it by whole rows, and a carry out of the fraction by one more */
+            int32_t line = (int32_t)(v >> 16) * tw;
+            int32_t line_step = (m->dvdx >> 16) * (int32_t)tw;
+            uint32_t frac = (uint32_t)v & 0xFFFF, frac_step = (uint32_t)m->dvdx & 0xFFFF;
+            for(int32_t i = first; i <= last; i++, u += m->dudx){
+                *out++ = texture[line + (u >> 16)];
+                line += line_step;
+                frac += frac_step;
+                if(frac & 0x10000){
+                    frac &= 0xFFFF;
+                    line += tw;
+                }
+            }
+        }
+        ILI9488_SetWindow((uint16_t)(x0 + first), (uint16_t)row, (uint16_t)(last - first + 1), 1);
+        ILI9488_WritePixels(ili9488_affine_row, (uint32_t)(last - first + 1));
+    }
+}
+
+/**
+ * @brief Draw a rotated and scaled texture centered on a point
+ * @param cx Destination X of the texture center
+ * @param cy Destination Y of the texture center
+ * @param texture Texture pixels, tw * th RGB666 colors, row by row
+ * @param tw Texture width (1 to 2048)
+ * @param th Texture height (1 to 2048)
+ * @param angle Rotation angle in degrees (clockwise on screen)
+ * @param scale Scale factor in 16.16 fixed point (ILI9488_FIXED_ONE = 1:1)
+ * @param filter Sampling filter
+ * @details The destination rectangle is the bounding box of the rotated
+ *          and scaled texture, so only the texture footprint is visited.
+ */
+void ILI9488_DrawRotozoom(int16_t cx, int16_t cy, const uint32_t *texture, uint16_t tw, uint16_t th,
+                          int16_t angle, int32_t scale, ILI9488_Filter_t filter){
+    ILI9488_Affine_t m;
+    int32_t s = ILI9488_Affine_Sin(angle);
+    int32_t c = ILI9488_Affine_Sin((int16_t)(angle + 90));
+    if(s < 0) s = -s;
+    if(c < 0) c = -c;
+    if(scale <= 0) scale = ILI9488_FIXED_ONE;
+
+    /* Half extents of the rotated texture, plus one pixel for rounding */
+    int32_t ex = (int32_t)((((int64_t)c * tw + (int64_t)s * th) * scale) >> 33) + 1;
+    int32_t ey = (int32_t)((((int64_t)s * tw + (int64_t)c * th) * scale) >> 33) + 1;
+    if(ex > 0x3FFF) ex = 0x3FFF;
+    if(ey > 0x3FFF) ey = 0x3FFF;
+
+    ILI9488_AffineRotozoom(&m, angle, scale, (int32_t)tw << 15, (int32_t)th << 15, (int16_t)ex, (int16_t)ey);
+    ILI9488_DrawAffine((int16_t)(cx - ex), (int16_t)(cy - ey), (uint16_t)(2 * ex), (uint16_t)(2 * ey),
+                       texture, tw, th, &m, filter);
+}
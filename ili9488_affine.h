@@ -0,0 +1,113 @@
+/**
+ * @file ili9488_affine.h
+ * @brief ILI9488 affine textured blits (rotation, scale, shear)
+ * @details This header file contains the declarations for the fixed-point
+ *          affine blitter. Destination pixels are mapped back to texture
+ *          coordinates with an inverse 2x3 matrix in 16.16 fixed point,
+ *          sampled with nearest or bilinear filtering and streamed row by
+ *          row into the display.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_AFFINE_H
+#define __ILI9488_AFFINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* For int32_t, uint16_t, uint32_t */
+#include <stdint.h>
+#include "ili9488.h"
+
+/* One in 16.16 fixed point */
+#define ILI9488_FIXED_ONE  65536
+
+/**
+ * @brief Inverse affine mapping from destination pixels to texture coordinates
+ * @details For the destination pixel (x, y), relative to the top left corner
+ *          of the destination rectangle, the sampled texture position is:
+ *          u = u0 + x * dudx + y * dudy
+ *          v = v0 + x * dvdx + y * dvdy
+ *          All values are in 16.16 fixed point and address texel centers
+ *          at integer + 0.5.
+ */
+typedef struct {
+    int32_t u0;    ///< Texture U at the destination origin
+    int32_t v0;    ///< Texture V at the destination origin
+    int32_t dudx;  ///< U step per destination column
+    int32_t dvdx;  ///< V step per destination column
+    int32_t dudy;  ///< U step per destination row
+    int32_t dvdy;  ///< V step per destination row
+} ILI9488_Affine_t;
+
+/**
+ * @brief Build a rotation and scale mapping around a pivot
+ * @param m Output mapping
+ * @param angle Rotation angle in degrees (clockwise on screen)
+ * @param scale Scale factor in 16.16 fixed point (ILI9488_FIXED_ONE = 1:1)
+ * @param pivot_u Texture pivot X in 16.16 fixed point
+ * @param pivot_v Texture pivot Y in 16.16 fixed point
+ * @param dst_x Destination X of the pivot, relative to the destination origin
+ * @param dst_y Destination Y of the pivot, relative to the destination origin
+ */
+void ILI9488_AffineRotozoom(ILI9488_Affine_t *m, int16_t angle, int32_t scale,
+                            int32_t pivot_u, int32_t pivot_v, int16_t dst_x, int16_t dst_y);
+
+/**
+ * @brief Apply a shear on top of a mapping
+ * @param m Mapping to modify
+ * @param shear_x Horizontal shear in 16.16 fixed point (texture U per destination row)
+ * @param shear_y Vertical shear in 16.16 fixed point (texture V per destination column)
+ */
+void ILI9488_AffineShear(ILI9488_Affine_t *m, int32_t shear_x, int32_t shear_y);
+
+/**
+ * @brief Sample a texture with bilinear filtering
+ * @param texture Texture pixels, tw * th RGB666 colors, row by row
+ * @param tw Texture width
+ * @param th Texture height
+ * @param u Texture X in 16.16 fixed point (texel centers at integer + 0.5)
+ * @param v Texture Y in 16.16 fixed point (texel centers at integer + 0.5)
+ * @return Filtered RGB666 color, with edge texels repeated outside the texture
+ */
+uint32_t ILI9488_SampleBilinear(const uint32_t *texture, uint16_t tw, uint16_t th, int32_t u, int32_t v);
+
+/**
+ * @brief Draw a texture through an affine mapping
+ * @param x Left edge of the destination rectangle (may be off-screen)
+ * @param y Top edge of the destination rectangle (may be off-screen)
+ * @param w Width of the destination rectangle
+ * @param h Height of the destination rectangle
+ * @param texture Texture pixels, tw * th RGB666 colors, row by row
+ * @param tw Texture width (1 to 2048)
+ * @param th Texture height (1 to 2048)
+ * @param m Inverse mapping from destination to texture coordinates
+ * @param filter Sampling filter
+ * @details Destination pixels that map outside the texture are not written.
+ */
+void ILI9488_DrawAffine(int16_t x, int16_t y, uint16_t w, uint16_t h,
+                        const uint32_t *texture, uint16_t tw, uint16_t th,
+                        const ILI9488_Affine_t *m, ILI9488_Filter_t filter);
+
+/**
+ * @brief Draw a rotated and scaled texture centered on a point
+ * @param cx Destination X of the texture center
+ * @param cy Destination Y of the texture center
+ * @param texture Texture pixels, tw * th RGB666 colors, row by row
+ * @param tw Texture width (1 to 2048)
+ * @param th Texture height (1 to 2048)
+ * @param angle Rotation angle in degrees (clockwise on screen)
+ * @param scale Scale factor in 16.16 fixed point (ILI9488_FIXED_ONE = 1:1)
+ * @param filter Sampling filter
+ */
+void ILI9488_DrawRotozoom(int16_t cx, int16_t cy, const uint32_t *texture, uint16_t tw, uint16_t th,
+                          int16_t angle, int32_t scale, ILI9488_Filter_t filter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ILI9488_AFFINE_H */
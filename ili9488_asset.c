@@ -0,0 +1,91 @@
+/**
+ * @file ili9488_asset.c
+ * @brief ILI9488 asset packs
+ * @details This file contains the implementation of asset pack lookups. The
+ *          index is searched in place, so a lookup touches about log2(count)
+ *          entries and one name, and nothing from the pack is copied to RAM.
+ *          Image blobs are handed to ILI9488_DrawImage() at their mapped
+ *          address, so bus-word images go from flash to the data lines
+ *          directly.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "ili9488_asset.h"
+#include "ili9488_image.h"
+
+/**
+ * @brief Check that a pack header is valid
+ * @param pack Start of the pack (4-byte aligned)
+ * @return 1 if the pack can be used, 0 otherwise
+ */
+uint8_t ILI9488_PackCheck(const void *pack){
+    const ILI9488_PackHeader_t *header = (const ILI9488_PackHeader_t *)pack;
+    if(pack == NULL) return 0;
+    if(header->magic != ILI9488_PACK_MAGIC || header->version != ILI9488_PACK_VERSION) return 0;
+    /* Blobs hold uint32_t words, so they must be at least word aligned */
+    if(header->align < 4 || (header->align & (header->align - 1))) return 0;
+    return header->size >= sizeof(ILI9488_PackHeader_t) + header->count * sizeof(ILI9488_PackEntry_t);
+}
+
+/**
+ * @brief Hash an asset name as the pack index does (32-bit FNV-1a)
+ * @param name NUL-terminated asset name
+ * @return Name hash
+ */
+uint32_t ILI9488_PackHash(const char *name){
+    uint32_t hash = 2166136261u;
+    while(*name){
+        hash ^= (uint8_t)*name++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Find an asset by name
+ * @param pack Start of a valid pack
+ * @param name NUL-terminated asset name
+ * @param size If not NULL, receives the blob size in bytes
+ * @return Address of the blob inside the pack, or NULL if there is no such asset
+ * @details The packer rejects names whose hashes collide, so the first entry
+ *          with a matching hash is the only candidate. Its name is still
+ *          compared, so a name that is not in the pack is never mistaken for
+ *          one that is.
+ */
+const void *ILI9488_PackFind(const void *pack, const char *name, uint32_t *size){
+    const ILI9488_PackHeader_t *header = (const ILI9488_PackHeader_t *)pack;
+    const ILI9488_PackEntry_t *index = (const ILI9488_PackEntry_t *)(header + 1);
+    const uint8_t *base = (const uint8_t *)pack;
+    uint32_t hash = ILI9488_PackHash(name);
+    uint32_t lo = 0, hi = header->count;
+
+    while(lo < hi){
+        uint32_t mid = (lo + hi) / 2;
+        if(index[mid].hash < hash) lo = mid + 1;
+        else hi = mid;
+    }
+    if(lo == header->count || index[lo].hash != hash) return NULL;
+    if(strcmp((const char *)(base + index[lo].name), name) != 0) return NULL;
+
+    if(size) *size = index[lo].size;
+    return base + index[lo].offset;
+}
+
+/**
+ * @brief Draw an image asset by name
+ * @param pack Start of a valid pack
+ * @param name NUL-terminated asset name
+ * @param x Left edge of the image
+ * @param y Top edge of the image
+ * @return 1 if the asset was found and drawn, 0 otherwise
+ */
+uint8_t ILI9488_DrawAsset(const void *pack, const char *name, uint16_t x, uint16_t y){
+    const void *image = ILI9488_PackFind(pack, name, NULL);
+    if(image == NULL) return 0;
+    ILI9488_DrawImage(x, y, image);
+    return 1;
+}
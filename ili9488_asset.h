@@ -0,0 +1,90 @@
+/**
+ * @file ili9488_asset.h
+ * @brief ILI9488 asset packs
+ * @details This header file contains the declarations for reading asset packs
+ *          built by tools/ili9488_pack.c. A pack is used in place, typically
+ *          from memory-mapped QSPI flash: names are resolved with a binary
+ *          search over the hash-sorted index, and image blobs are drawn
+ *          straight from the mapped region without copying them to RAM.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_ASSET_H
+#define __ILI9488_ASSET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* For uint8_t, uint16_t, uint32_t */
+#include <stdint.h>
+#include "ili9488.h"
+
+/* Pack magic, "ILPK" in little-endian order */
+#define ILI9488_PACK_MAGIC    0x4B504C49
+#define ILI9488_PACK_VERSION  1
+
+/**
+ * @brief Pack header
+ * @details Followed by count index entries sorted by hash, the NUL-terminated
+ *          names and the blobs, each starting on a multiple of align bytes.
+ */
+typedef struct {
+    uint32_t magic;    ///< ILI9488_PACK_MAGIC
+    uint16_t version;  ///< ILI9488_PACK_VERSION
+    uint16_t count;    ///< Number of index entries
+    uint32_t align;    ///< Blob alignment in bytes
+    uint32_t size;     ///< Total pack size in bytes
+} ILI9488_PackHeader_t;
+
+/**
+ * @brief Pack index entry
+ * @details Offsets are relative to the start of the pack.
+ */
+typedef struct {
+    uint32_t hash;    ///< FNV-1a hash of the name
+    uint32_t offset;  ///< Blob offset
+    uint32_t size;    ///< Blob size in bytes
+    uint32_t name;    ///< Name offset
+} ILI9488_PackEntry_t;
+
+/**
+ * @brief Check that a pack header is valid
+ * @param pack Start of the pack (4-byte aligned)
+ * @return 1 if the pack can be used, 0 otherwise
+ */
+uint8_t ILI9488_PackCheck(const void *pack);
+
+/**
+ * @brief Hash an asset name as the pack index does (32-bit FNV-1a)
+ * @param name NUL-terminated asset name
+ * @return Name hash
+ */
+uint32_t ILI9488_PackHash(const char *name);
+
+/**
+ * @brief Find an asset by name
+ * @param pack Start of a valid pack
+ * @param name NUL-terminated asset name
+ * @param size If not NULL, receives the blob size in bytes
+ * @return Address of the blob inside the pack, or NULL if there is no such asset
+ */
+const void *ILI9488_PackFind(const void *pack, const char *name, uint32_t *size);
+
+/**
+ * @brief Draw an image asset by name
+ * @param pack Start of a valid pack
+ * @param name NUL-terminated asset name
+ * @param x Left edge of the image
+ * @param y Top edge of the image
+ * @return 1 if the asset was found and drawn, 0 otherwise
+ */
+uint8_t ILI9488_DrawAsset(const void *pack, const char *name, uint16_t x, uint16_t y);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ILI9488_ASSET_H */
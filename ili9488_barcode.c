@@ -0,0 +1,672 @@
+/**
+ * @file ili9488_barcode.c
+ * @brief ILI9488 QR code and Code128 barcode rendering
+ * @details This file contains a QR code encoder working on static buffers
+ *          (versions 1 to 10, byte mode, all error correction levels) and a
+ *          Code128 renderer. Dark modules are merged into rectangles before
+ *          they are sent with ILI9488_FillRect(), so a version 10 symbol is
+ *          drawn with a few hundred fills instead of one write per module.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include "ili9488_barcode.h"
+
+/* QR code symbol size in modules for the largest supported version */
+#define QR_MAX_SIZE        (17 + 4 * ILI9488_QR_MAX_VERSION)
+/* Bytes needed to hold one bit per module */
+#define QR_MAX_BITMAP      ((QR_MAX_SIZE * QR_MAX_SIZE + 7) / 8)
+/* Total codewords of the largest supported version */
+#define QR_MAX_CODEWORDS   346
+/* Longest error correction block of the supported versions */
+#define QR_MAX_ECC_LEN     30
+/* Most dark runs a single module row can contain */
+#define QR_MAX_RUNS        ((QR_MAX_SIZE + 1) / 2)
+
+/**
+ * @brief Error correction codewords per block, indexed by [ecc][version]
+ */
+static const uint8_t ili9488_qr_ecc_len[4][ILI9488_QR_MAX_VERSION + 1] = {
+    {0,  7, 10, 15, 20, 26, 18, 20, 24, 30, 18}, /* Low */
+    {0, 10, 16, 26, 18, 24, 16, 18, 22, 22, 26}, /* Medium */
+    {0, 13, 22, 18, 26, 18, 24, 18, 22, 20, 24}, /* Quartile */
+    {0, 17, 28, 22, 16, 22, 28, 26, 26, 24, 28}  /* High */
+};
+
+/**
+ * @brief Error correction blocks, indexed by [ecc][version]
+ */
+static const uint8_t ili9488_qr_ecc_blocks[4][ILI9488_QR_MAX_VERSION + 1] = {
+    {0, 1, 1, 1, 1, 1, 2, 2, 2, 2, 4}, /* Low */
+    {0, 1, 1, 1, 2, 2, 4, 4, 4, 5, 5}, /* Medium */
+    {0, 1, 1, 2, 2, 4, 4, 6, 6, 8, 8}, /* Quartile */
+    {0, 1, 1, 2, 4, 4, 4, 5, 6, 8, 8}  /* High */
+};
+
+/**
+ * @brief Format information bits of each error correction level
+ */
+static const uint8_t ili9488_qr_ecc_format[4] = {1, 0, 3, 2};
+
+/* Encoder working buffers, shared by all QR codes */
+static uint8_t ili9488_qr_modules[QR_MAX_BITMAP];
+static uint8_t ili9488_qr_function[QR_MAX_BITMAP];
+static uint8_t ili9488_qr_data[QR_MAX_CODEWORDS];
+static uint8_t ili9488_qr_codewords[QR_MAX_CODEWORDS];
+static uint8_t ili9488_qr_size;
+
+/**
+ * @brief Dark module run, or a rectangle of stacked identical runs
+ */
+typedef struct {
+    uint8_t x0; ///< First module column
+    uint8_t x1; ///< Last module column
+    uint8_t y0; ///< First module row covered by the rectangle
+} ILI9488_QrRun_t;
+
+/**
+ * @brief Get a module of the QR code bitmap
+ * @param map Module or function bitmap
+ * @param x Module column
+ * @param y Module row
+ * @return 1 if the module is set, 0 otherwise
+ */
+static inline uint8_t ILI9488_QR_Get(const uint8_t *map, uint8_t x, uint8_t y){
+    uint16_t i = (uint16_t)y * ili9488_qr_size + x;
+    return (map[i >> 3] >> (i & 7)) & 1;
+}
+
+/**
+ * @brief Set or clear a module of the QR code bitmap
+ * @param map Module or function bitmap
+ * @param x Module column
+ * @param y Module row
+ * @param on 1 to set the module, 0 to clear it
+ */
+static inline void ILI9488_QR_Put(uint8_t *map, uint8_t x, uint8_t y, uint8_t on){
+    uint16_t i = (uint16_t)y * ili9488_qr_size + x;
+    if(on) map[i >> 3] |= (uint8_t)(1 << (i & 7));
+    else   map[i >> 3] &= (uint8_t)~(1 << (i & 7));
+}
+
+/**
+ * @brief Place a function module (finder, timing, alignment, format)
+ * @param x Module column
+ * @param y Module row
+ * @param dark 1 for a dark module, 0 for a light one
+ */
+static void ILI9488_QR_Function(uint8_t x, uint8_t y, uint8_t dark){
+    ILI9488_QR_Put(ili9488_qr_modules, x, y, dark);
+    ILI9488_QR_Put(ili9488_qr_function, x, y, 1);
+}
+
+/**
+ * @brief Get the number of data and error correction bits of a version
+ * @param version QR code version (1 to 10)
+ * @return Number of modules available for codewords
+ */
+static uint16_t ILI9488_QR_RawModules(uint8_t version){
+    uint16_t result = (uint16_t)((16 * version + 128) * version + 64);
+    if(version >= 2){
+        uint8_t align = version / 7 + 2;
+        result -= (uint16_t)((25 * align - 10) * align - 55);
+        if(version >= 7) result -= 36;
+    }
+    return result;
+}
+
+/**
+ * @brief Get the number of data codewords of a version
+ * @param version QR code version (1 to 10)
+ * @param ecc Error correction level
+ * @return Number of data codewords
+ */
+static uint16_t ILI9488_QR_DataCodewords(uint8_t version, ILI9488_QrEcc_t ecc){
+    return ILI9488_QR_RawModules(version) / 8
+         - (uint16_t)ili9488_qr_ecc_len[ecc][version] * ili9488_qr_ecc_blocks[ecc][version];
+}
+
+/**
+ * @brief Get the QR code version needed for a payload
+ * @param len Payload length in bytes
+ * @param ecc Error correction level
+ * @return QR code version (1 to ILI9488_QR_MAX_VERSION), or 0 if the payload
+ *         does not fit
+ * @details Byte mode uses a 4-bit mode indicator and an 8-bit character count
+ *          up to version 9, and a 16-bit character count from version 10.
+ */
+uint8_t ILI9488_QRCodeVersion(uint16_t len, ILI9488_QrEcc_t ecc){
+    if(ecc > ILI9488_QR_ECC_HIGH) return 0;
+    for(uint8_t version = 1; version <= ILI9488_QR_MAX_VERSION; version++){
+        uint32_t bits = 4 + (version < 10 ? 8 : 16) + (uint32_t)len * 8;
+        if(bits <= (uint32_t)ILI9488_QR_DataCodewords(version, ecc) * 8) return version;
+    }
+    return 0;
+}
+
+/**
+ * @brief Multiply two elements of GF(256) modulo 0x11D
+ */
+static uint8_t ILI9488_QR_Multiply(uint8_t a, uint8_t b){
+    uint8_t z = 0;
+    for(int8_t i = 7; i >= 0; i--){
+        z = (uint8_t)((z << 1) ^ ((z >> 7) * 0x1D));
+        z ^= (uint8_t)(((b >> i) & 1) * a);
+    }
+    return z;
+}
+
+/**
+ * @brief Compute the Reed-Solomon error correction bytes of a block
+ * @param data Data codewords of the block
+ * @param len Number of data codewords
+ * @param ecc Output buffer for the error correction codewords
+ * @param degree Number of error correction codewords
+ */
+static void ILI9488_QR_ReedSolomon(const uint8_t *data, uint16_t len, uint8_t *ecc, uint8_t degree){
+    uint8_t divisor[QR_MAX_ECC_LEN];
+    uint8_t root = 1;
+
+    /* Generator polynomial (x - r^0) * ... * (x - r^(degree - 1)), leading term dropped */
+    for(uint8_t i = 0; i < degree; i++) divisor[i] = 0;
+    divisor[degree - 1] = 1;
+    for(uint8_t i = 0; i < degree; i++){
+        for(uint8_t j = 0; j < degree; j++){
+            divisor[j] = ILI9488_QR_Multiply(divisor[j], root);
+            if(j + 1 < degree) divisor[j] ^= divisor[j + 1];
+        }
+        root = ILI9488_QR_Multiply(root, 0x02);
+    }
+
+    /* Polynomial division remainder */
+    for(uint8_t i = 0; i < degree; i++) ecc[i] = 0;
+    for(uint16_t i = 0; i < len; i++){
+        uint8_t factor = data[i] ^ ecc[0];
+        for(uint8_t j = 0; j + 1 < degree; j++) ecc[j] = ecc[j + 1];
+        ecc[degree - 1] = 0;
+        for(uint8_t j = 0; j < degree; j++) ecc[j] ^= ILI9488_QR_Multiply(divisor[j], factor);
+    }
+}
+
+/**
+ * @brief Build the codeword sequence of a payload
+ * @param data Payload bytes
+ * @param len Payload length in bytes
+ * @param version QR code version (1 to 10)
+ * @param ecc Error correction level
+ * @details The payload is encoded in byte mode, padded to the data capacity,
+ *          split into blocks with their error correction codewords and
+ *          interleaved into ili9488_qr_codewords.
+ */
+static void ILI9488_QR_Codewords(const uint8_t *data, uint16_t len, uint8_t version, ILI9488_QrEcc_t ecc){
+    uint16_t capacity = ILI9488_QR_DataCodewords(version, ecc);
+    uint16_t raw = ILI9488_QR_RawModules(version) / 8;
+    uint8_t blocks = ili9488_qr_ecc_blocks[ecc][version];
+    uint8_t ecc_len = ili9488_qr_ecc_len[ecc][version];
+    uint8_t short_blocks = (uint8_t)(blocks - raw % blocks);
+    uint16_t short_len = raw / blocks - ecc_len;
+    uint32_t bit = 0;
+
+    /* Mode indicator, character count and payload */
+    for(uint16_t i = 0; i < capacity; i++) ili9488_qr_data[i] = 0;
+    uint32_t header = (0x4UL << (version < 10 ? 8 : 16)) | len;
+    uint8_t header_bits = version < 10 ? 12 : 20;
+    for(int8_t i = (int8_t)(header_bits - 1); i >= 0; i--, bit++){
+        if((header >> i) & 1) ili9488_qr_data[bit >> 3] |= (uint8_t)(0x80 >> (bit & 7));
+    }
+    for(uint16_t i = 0; i < len; i++){
+        for(int8_t j = 7; j >= 0; j--, bit++){
+            if((data[i] >> j) & 1) ili9488_qr_data[bit >> 3] |= (uint8_t)(0x80 >> (bit & 7));
+        }
+    }
+
+    /* Terminator and byte alignment are already zero; pad bytes follow */
+    bit += 4;
+    if(bit > (uint32_t)capacity * 8) bit = (uint32_t)capacity * 8;
+    for(uint16_t i = (uint16_t)((bit + 7) / 8), pad = 0xEC; i < capacity; i++, pad ^= 0xEC ^ 0x11){
+        ili9488_qr_data[i] = (uint8_t)pad;
+    }
+
+    /* Interleave data codewords, then error correction codewords */
+    uint16_t out = 0;
+    for(uint16_t i = 0; i <= short_len; i++){
+        uint16_t offset = 0;
+        for(uint8_t b = 0; b < blocks; b++){
+            uint16_t block_len = short_len + (b >= short_blocks);
+            if(i < block_len) ili9488_qr_codewords[out++] = ili9488_qr_data[offset + i];
+            offset += block_len;
+        }
+    }
+    uint16_t offset = 0;
+    for(uint8_t b = 0; b < blocks; b++){
+        uint16_t block_len = short_len + (b >= short_blocks);
+        uint8_t block_ecc[QR_MAX_ECC_LEN];
+        ILI9488_QR_ReedSolomon(&ili9488_qr_data[offset], block_len, block_ecc, ecc_len);
+        for(uint8_t i = 0; i < ecc_len; i++){
+            ili9488_qr_codewords[capacity + (uint16_t)i * blocks + b] = block_ecc[i];
+        }
+        offset += block_len;
+    }
+}
+
+/**
+ * @brief Get the Chebyshev distance of a module from a pattern center
+ */
+static inline uint8_t ILI9488_QR_Distance(int8_t dx, int8_t dy){
+    uint8_t ax = (uint8_t)(dx < 0 ? -dx : dx);
+    uint8_t ay = (uint8_t)(dy < 0 ? -dy : dy);
+    return ax > ay ? ax : ay;
+}
+
+/**
+ * @brief Draw a finder pattern with its separator
+ * @param cx Center module column
+ * @param cy Center module row
+ */
+static void ILI9488_QR_Finder(int16_t cx, int16_t cy){
+    for(int8_t dy = -4; dy <= 4; dy++){
+        for(int8_t dx = -4; dx <= 4; dx++){
+            int16_t x = cx + dx, y = cy + dy;
+            if(x < 0 || y < 0 || x >= ili9488_qr_size || y >= ili9488_qr_size) continue;
+            uint8_t d = ILI9488_QR_Distance(dx, dy);
+            ILI9488_QR_Function((uint8_t)x, (uint8_t)y, d != 2 && d != 4);
+        }
+    }
+}
+
+/**
+ * @brief Draw the format information for a mask
+ * @param ecc Error correction level
+ * @param mask Mask pattern (0 to 7)
+ */
+static void ILI9488_QR_Format(ILI9488_QrEcc_t ecc, uint8_t mask){
+    uint16_t data = (uint16_t)(ili9488_qr_ecc_format[ecc] << 3 | mask);
+    uint16_t rem = data;
+    for(uint8_t i = 0; i < 10; i++) rem = (uint16_t)((rem << 1) ^ ((rem >> 9) * 0x537));
+    uint16_t bits = (uint16_t)((data << 10 | rem) ^ 0x5412);
+    uint8_t size = ili9488_qr_size;
+
+    /* First copy, around the top left finder */
+    for(uint8_t i = 0; i <= 5; i++) ILI9488_QR_Function(8, i, (bits >> i) & 1);
+    ILI9488_QR_Function(8, 7, (bits >> 6) & 1);
+    ILI9488_QR_Function(8, 8, (bits >> 7) & 1);
+    ILI9488_QR_Function(7, 8, (bits >> 8) & 1);
+    for(uint8_t i = 9; i < 15; i++) ILI9488_QR_Function(14 - i, 8, (bits >> i) & 1);
+
+    /* Second copy, split between the other two finders */
+    for(uint8_t i = 0; i < 8; i++) ILI9488_QR_Function(size - 1 - i, 8, (bits >> i) & 1);
+    for(uint8_t i = 8; i < 15; i++) ILI9488_QR_Function(8, size - 15 + i, (bits >> i) & 1);
+    ILI9488_QR_Function(8, size - 8, 1); /* Always dark */
+}
+
+/**
+ * @brief Draw all function patterns of a version
+ * @param version QR code version (1 to 10)
+ */
+static void ILI9488_QR_FunctionPatterns(uint8_t version){
+    uint8_t size = ili9488_qr_size;
+
+    /* Timing patterns */
+    for(uint8_t i = 0; i < size; i++){
+        ILI9488_QR_Function(6, i, i % 2 == 0);
+        ILI9488_QR_Function(i, 6, i % 2 == 0);
+    }
+
+    /* Finder patterns */
+    ILI9488_QR_Finder(3, 3);
+    ILI9488_QR_Finder(size - 4, 3);
+    ILI9488_QR_Finder(3, size - 4);
+
+    /* Alignment patterns, skipping the three finder corners */
+    if(version >= 2){
+        uint8_t align = version / 7 + 2;
+        uint8_t step = (uint8_t)((version * 4 + align * 2 + 1) / (align * 2 - 2) * 2);
+        uint8_t pos[7];
+        pos[0] = 6;
+        for(uint8_t i = align - 1, p = size - 7; i >= 1; i--, p -= step) pos[i] = p;
+        for(uint8_t i = 0; i < align; i++){
+            for(uint8_t j = 0; j < align; j++){
+                if((i == 0 && j == 0) || (i == 0 && j == align - 1) || (i == align - 1 && j == 0)) continue;
+                for(int8_t dy = -2; dy <= 2; dy++){
+                    for(int8_t dx = -2; dx <= 2; dx++){
+                        uint8_t d = ILI9488_QR_Distance(dx, dy);
+                        ILI9488_QR_Function((uint8_t)(pos[i] + dx), (uint8_t)(pos[j] + dy), d != 1);
+                    }
+                }
+            }
+        }
+    }
+
+    /* Reserve the format areas (real bits are drawn once the mask is known) */
+    ILI9488_QR_Format(ILI9488_QR_ECC_LOW, 0);
+
+    /* Version information from version 7 */
+    if(version >= 7){
+        uint32_t rem = version;
+        for(uint8_t i = 0; i < 12; i++) rem = (rem << 1) ^ ((rem >> 11) * 0x1F25);
+        uint32_t bits = (uint32_t)version << 12 | rem;
+        for(uint8_t i = 0; i < 18; i++){
+            uint8_t a = (uint8_t)(size - 11 + i % 3), b = i / 3;
+            ILI9488_QR_Function(a, b, (bits >> i) & 1);
+            ILI9488_QR_Function(b, a, (bits >> i) & 1);
+        }
+    }
+}
+
+/**
+ * @brief Place the codewords in the zigzag data area
+ * @param count Number of codewords
+ */
+static void ILI9488_QR_PlaceCodewords(uint16_t count){
+    uint32_t i = 0;
+    for(int16_t right = ili9488_qr_size - 1; right >= 1; right -= 2){
+        if(right == 6) right = 5; /* Skip the vertical timing pattern */
+        for(uint8_t vert = 0; vert < ili9488_qr_size; vert++){
+            for(uint8_t j = 0; j < 2; j++){
+                uint8_t x = (uint8_t)(right - j);
+                uint8_t y = ((right + 1) & 2) == 0 ? (uint8_t)(ili9488_qr_size - 1 - vert) : vert;
+                if(ILI9488_QR_Get(ili9488_qr_function, x, y)) continue;
+                uint8_t dark = 0;
+                if(i < (uint32_t)count * 8) dark = (ili9488_qr_codewords[i >> 3] >> (7 - (i & 7))) & 1;
+                ILI9488_QR_Put(ili9488_qr_modules, x, y, dark);
+                i++;
+            }
+        }
+    }
+}
+
+/**
+ * @brief XOR a mask pattern onto the data modules
+ * @param mask Mask pattern (0 to 7)
+ * @details Applying the same mask twice restores the unmasked symbol.
+ */
+static void ILI9488_QR_Mask(uint8_t mask){
+    for(uint8_t y = 0; y < ili9488_qr_size; y++){
+        for(uint8_t x = 0; x < ili9488_qr_size; x++){
+            uint8_t invert;
+            switch(mask){
+                case 0:  invert = (x + y) % 2 == 0; break;
+                case 1:  invert = y % 2 == 0; break;
+                case 2:  invert = x % 3 == 0; break;
+                case 3:  invert = (x + y) % 3 == 0; break;
+                case 4:  invert = (x / 3 + y / 2) % 2 == 0; break;
+                case 5:  invert = x * y % 2 + x * y % 3 == 0; break;
+                case 6:  invert = (x * y % 2 + x * y % 3) % 2 == 0; break;
+                default: invert = ((x + y) % 2 + x * y % 3) % 2 == 0; break;
+            }
+            if(invert && !ILI9488_QR_Get(ili9488_qr_function, x, y)){
+                ILI9488_QR_Put(ili9488_qr_modules, x, y, !ILI9488_QR_Get(ili9488_qr_modules, x, y));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Compute the mask penalty score of the current symbol
+ * @return Penalty score (lower is better)
+ * @details Implements the four penalty rules of ISO/IEC 18004: same color
+ *          runs, 2x2 blocks, finder-like patterns and dark module balance.
+ */
+static uint32_t ILI9488_QR_Penalty(void){
+    uint8_t size = ili9488_qr_size;
+    uint32_t penalty = 0;
+    uint16_t dark = 0;
+
+    for(uint8_t pass = 0; pass < 2; pass++){
+        for(uint8_t a = 0; a < size; a++){
+            uint8_t run = 0, last = 2;
+            uint16_t window = 0;
+            for(uint8_t b = 0; b < size; b++){
+                uint8_t m = pass ? ILI9488_QR_Get(ili9488_qr_modules, a, b) : ILI9488_QR_Get(ili9488_qr_modules, b, a);
+                /* Rule 1: runs of five or more modules of one color */
+                if(m == last){
+                    run++;
+                    if(run == 5) penalty += 3;
+                    else if(run > 5) penalty++;
+                }
+                else{
+                    run = 1;
+                    last = m;
+                }
+                /* Rule 3: 1:1:3:1:1 finder-like pattern next to four light modules */
+                window = (uint16_t)(((window << 1) | m) & 0x7FF);
+                if(b >= 10 && (window == 0x05D || window == 0x5D0)) penalty += 40;
+            }
+        }
+    }
+
+    for(uint8_t y = 0; y < size; y++){
+        for(uint8_t x = 0; x < size; x++){
+            uint8_t m = ILI9488_QR_Get(ili9488_qr_modules, x, y);
+            dark += m;
+            /* Rule 2: 2x2 blocks of one color */
+            if(x + 1 < size && y + 1 < size &&
+               m == ILI9488_QR_Get(ili9488_qr_modules, x + 1, y) &&
+               m == ILI9488_QR_Get(ili9488_qr_modules, x, y + 1) &&
+               m == ILI9488_QR_Get(ili9488_qr_modules, x + 1, y + 1)) penalty += 3;
+        }
+    }
+
+    /* Rule 4: 10 points per 5% deviation from a 50% dark ratio */
+    uint32_t total = (uint32_t)size * size;
+    uint32_t deviation = dark * 20 > total * 10 ? dark * 20 - total * 10 : total * 10 - dark * 20;
+    penalty += ((deviation + total - 1) / total - 1) * 10;
+    return penalty;
+}
+
+/**
+ * @brief Flush a merged rectangle of dark modules to the display
+ */
+static inline void ILI9488_QR_FillRun(uint16_t x, uint16_t y, const ILI9488_QrRun_t *run, uint8_t row,
+                                      uint8_t scale, uint32_t fg){
+    ILI9488_FillRect(x + (uint16_t)run->x0 * scale, y + (uint16_t)run->y0 * scale,
+                     (uint16_t)(run->x1 - run->x0 + 1) * scale, (uint16_t)(row - run->y0) * scale, fg);
+}
+
+/**
+ * @brief Encode and draw a QR code on the display
+ * @param x Left edge of the quiet zone
+ * @param y Top edge of the quiet zone
+ * @param data Payload bytes (encoded in byte mode)
+ * @param len Payload length in bytes
+ * @param ecc Error correction level
+ * @param scale Module size in pixels (1 or more)
+ * @param fg 18-bit RGB color of dark modules (RGB666 format)
+ * @param bg 18-bit RGB color of light modules and the quiet zone
+ * @return QR code version drawn, or 0 if the payload does not fit
+ * @details The whole symbol is first cleared with a single background fill.
+ *          Dark modules are then gathered into horizontal runs, and runs
+ *          that repeat with the same extent on the following rows are
+ *          stacked into one rectangle, so each rectangle costs one address
+ *          window instead of one window per module.
+ */
+uint8_t ILI9488_DrawQRCode(uint16_t x, uint16_t y, const uint8_t *data, uint16_t len,
+                           ILI9488_QrEcc_t ecc, uint8_t scale, uint32_t fg, uint32_t bg){
+    uint8_t version = ILI9488_QRCodeVersion(len, ecc);
+    if(version == 0 || scale == 0) return 0;
+
+    /* Build the symbol */
+    ili9488_qr_size = (uint8_t)(17 + 4 * version);
+    for(uint16_t i = 0; i < QR_MAX_BITMAP; i++){
+        ili9488_qr_modules[i] = 0;
+        ili9488_qr_function[i] = 0;
+    }
+    ILI9488_QR_FunctionPatterns(version);
+    ILI9488_QR_Codewords(data, len, version, ecc);
+    ILI9488_QR_PlaceCodewords(ILI9488_QR_RawModules(version) / 8);
+
+    /* Pick the mask with the lowest penalty */
+    uint8_t best_mask = 0;
+    uint32_t best_penalty = UINT32_MAX;
+    for(uint8_t mask = 0; mask < 8; mask++){
+        ILI9488_QR_Mask(mask);
+        ILI9488_QR_Format(ecc, mask);
+        uint32_t penalty = ILI9488_QR_Penalty();
+        if(penalty < best_penalty){
+            best_penalty = penalty;
+            best_mask = mask;
+        }
+        ILI9488_QR_Mask(mask);
+    }
+    ILI9488_QR_Mask(best_mask);
+    ILI9488_QR_Format(ecc, best_mask);
+
+    /* Background and quiet zone in one fill */
+    uint16_t side = (uint16_t)(ili9488_qr_size + 2 * ILI9488_QR_QUIET_ZONE) * scale;
+    ILI9488_FillRect(x, y, side, side, bg);
+    x += ILI9488_QR_QUIET_ZONE * scale;
+    y += ILI9488_QR_QUIET_ZONE * scale;
+
+    /* Merge dark runs row by row into rectangles */
+    static ILI9488_QrRun_t open[2][QR_MAX_RUNS];
+    uint8_t open_count = 0, cur = 0;
+    for(uint8_t row = 0; row <= ili9488_qr_size; row++){
+        ILI9488_QrRun_t runs[QR_MAX_RUNS];
+        uint8_t run_count = 0;
+        for(uint8_t col = 0; row < ili9488_qr_size && col < ili9488_qr_size; col++){
+            if(!ILI9488_QR_Get(ili9488_qr_modules, col, row)) continue;
+            runs[run_count].x0 = col;
+            while(col + 1 < ili9488_qr_size && ILI9488_QR_Get(ili9488_qr_modules, col + 1, row)) col++;
+            runs[run_count].x1 = col;
+            runs[run_count].y0 = row;
+            run_count++;
+        }
+
+        /* Both lists are sorted by column: carry exact matches, flush the rest */
+        ILI9488_QrRun_t *prev = open[cur], *next = open[cur ^ 1];
+        uint8_t i = 0, j = 0, n = 0;
+        while(i < open_count || j < run_count){
+            if(i < open_count && j < run_count && prev[i].x0 == runs[j].x0 && prev[i].x1 == runs[j].x1){
+                next[n++] = prev[i++];
+                j++;
+            }
+            else if(j >= run_count || (i < open_count && prev[i].x0 <= runs[j].x0)){
+                ILI9488_QR_FillRun(x, y, &prev[i++], row, scale, fg);
+            }
+            else{
+                next[n++] = runs[j++];
+            }
+        }
+        open_count = n;
+        cur ^= 1;
+    }
+    return version;
+}
+
+/**
+ * @brief Code128 bar and space widths of each symbol value
+ * @details Each hex digit is one element width in modules, starting with a
+ *          bar. Values 103 to 105 are Start A/B/C and 106 is the stop symbol.
+ */
+static const uint32_t ili9488_code128_patterns[107] = {
+    0x212222, 0x222122, 0x222221, 0x121223, 0x121322, 0x131222, 0x122213, 0x122312,
+    0x132212, 0x221213, 0x221312, 0x231212, 0x112232, 0x122132, 0x122231, 0x113222,
+    0x123122, 0x123221, 0x223211, 0x221132, 0x221231, 0x213212, 0x223112, 0x312131,
+    0x311222, 0x321122, 0x321221, 0x312212, 0x322112, 0x322211, 0x212123, 0x212321,
+    0x232121, 0x111323, 0x131123, 0x131321, 0x112313, 0x132113, 0x132311, 0x211313,
+    0x231113, 0x231311, 0x112133, 0x112331, 0x132131, 0x113123, 0x113321, 0x133121,
+    0x313121, 0x211331, 0x231131, 0x213113, 0x213311, 0x213131, 0x311123, 0x311321,
+    0x331121, 0x312113, 0x312311, 0x332111, 0x314111, 0x221411, 0x431111, 0x111224,
+    0x111422, 0x121124, 0x121421, 0x141122, 0x141221, 0x112214, 0x112412, 0x122114,
+    0x122411, 0x142112, 0x142211, 0x241211, 0x221114, 0x413111, 0x241112, 0x134111,
+    0x111242, 0x121142, 0x121241, 0x114212, 0x124112, 0x124211, 0x411212, 0x421112,
+    0x421211, 0x212141, 0x214121, 0x412121, 0x111143, 0x111341, 0x131141, 0x114113,
+    0x114311, 0x411113, 0x411311, 0x113141, 0x114131, 0x311141, 0x411131, 0x211412,
+    0x211214, 0x211232, 0x2331112
+};
+
+/* Code128 special symbol values */
+#define CODE128_CODE_C   99
+#define CODE128_CODE_B   100
+#define CODE128_START_B  104
+#define CODE128_START_C  105
+#define CODE128_STOP     106
+
+/**
+ * @brief Count consecutive digits at the start of a string
+ */
+static uint8_t ILI9488_Code128_Digits(const char *text){
+    uint8_t n = 0;
+    while(text[n] >= '0' && text[n] <= '9' && n < 255) n++;
+    return n;
+}
+
+/**
+ * @brief Draw a Code128 barcode on the display
+ * @param x Left edge of the quiet zone
+ * @param y Top edge of the bars
+ * @param text Null-terminated ASCII text (characters 32 to 127)
+ * @param module Narrow bar width in pixels (1 or more)
+ * @param height Bar height in pixels
+ * @param fg 18-bit RGB color of the bars (RGB666 format)
+ * @param bg 18-bit RGB color of the spaces and the quiet zone
+ * @return Total barcode width in pixels including quiet zones, or 0 if the
+ *         text is empty, too long or contains unsupported characters
+ * @details Text is encoded in code set B, switching to code set C for runs
+ *          of four or more digits (two digits per symbol). The background
+ *          is cleared with one fill and every bar is a single rectangle, so
+ *          the bus cost is one address window per bar.
+ */
+uint16_t ILI9488_DrawCode128(uint16_t x, uint16_t y, const char *text, uint8_t module,
+                             uint16_t height, uint32_t fg, uint32_t bg){
+    uint8_t values[ILI9488_CODE128_MAX_LENGTH + 3];
+    uint8_t count = 0;
+
+    if(text == 0 || text[0] == '\0' || module == 0 || height == 0) return 0;
+
+    /* Encode symbol values */
+    uint8_t digits = ILI9488_Code128_Digits(text);
+    uint8_t set_c = digits >= 4 || (digits == 2 && text[2] == '\0');
+    values[count++] = set_c ? CODE128_START_C : CODE128_START_B;
+    while(*text){
+        if(count >= ILI9488_CODE128_MAX_LENGTH + 1) return 0;
+        digits = ILI9488_Code128_Digits(text);
+        if(set_c){
+            if(digits >= 2){
+                values[count++] = (uint8_t)((text[0] - '0') * 10 + (text[1] - '0'));
+                text += 2;
+                continue;
+            }
+            values[count++] = CODE128_CODE_B;
+            set_c = 0;
+        }
+        else if(digits >= 4){
+            /* Odd runs keep their first digit in code set B */
+            if(digits % 2){
+                values[count++] = (uint8_t)(text[0] - ' ');
+                text++;
+            }
+            values[count++] = CODE128_CODE_C;
+            set_c = 1;
+            continue;
+        }
+        if((uint8_t)*text < ' ' || (uint8_t)*text > 127) return 0;
+        values[count++] = (uint8_t)(*text - ' ');
+        text++;
+    }
+    if(count > ILI9488_CODE128_MAX_LENGTH + 1) return 0;
+
+    /* Checksum and stop symbol */
+    uint32_t checksum = values[0];
+    for(uint8_t i = 1; i < count; i++) checksum += (uint32_t)values[i] * i;
+    values[count++] = (uint8_t)(checksum % 103);
+    values[count++] = CODE128_STOP;
+
+    /* 11 modules per symbol, 13 for the stop symbol, plus both quiet zones */
+    uint16_t width = (uint16_t)(((uint16_t)count * 11 + 2 + 2 * ILI9488_CODE128_QUIET_ZONE) * module);
+    ILI9488_FillRect(x, y, width, height, bg);
+
+    /* Each bar is already a maximal rectangle */
+    uint16_t pos = x + ILI9488_CODE128_QUIET_ZONE * module;
+    for(uint8_t i = 0; i < count; i++){
+        uint32_t pattern = ili9488_code128_patterns[values[i]];
+        uint8_t elements = values[i] == CODE128_STOP ? 7 : 6;
+        for(int8_t e = (int8_t)(elements - 1); e >= 0; e--){
+            uint16_t w = (uint16_t)(((pattern >> (e * 4)) & 0xF) * module);
+            if(((elements - 1 - e) & 1) == 0) ILI9488_FillRect(pos, y, w, height, fg);
+            pos += w;
+        }
+    }
+    return width;
+}
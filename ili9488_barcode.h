@@ -0,0 +1,84 @@
+/**
+ * @file ili9488_barcode.h
+ * @brief ILI9488 QR code and Code128 barcode rendering
+ * @details This header file contains the declarations for the built-in QR
+ *          code encoder (versions 1 to 10, byte mode) and the Code128
+ *          barcode renderer. Both render through ILI9488_FillRect() and merge
+ *          adjacent dark modules into rectangles before drawing.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_BARCODE_H
+#define __ILI9488_BARCODE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* For uint8_t, uint16_t, uint32_t */
+#include <stdint.h>
+#include "ili9488.h"
+
+/* Largest QR code version supported by the static encoder buffers */
+#define ILI9488_QR_MAX_VERSION      10
+/* Quiet zone drawn around a QR code, in modules */
+#define ILI9488_QR_QUIET_ZONE       4
+/* Quiet zone drawn on both sides of a Code128 barcode, in modules */
+#define ILI9488_CODE128_QUIET_ZONE  10
+/* Longest Code128 text accepted by the renderer */
+#define ILI9488_CODE128_MAX_LENGTH  48
+
+/* QR code error correction levels */
+typedef enum {
+    ILI9488_QR_ECC_LOW = 0,      ///< Recovers ~7% of the symbol
+    ILI9488_QR_ECC_MEDIUM = 1,   ///< Recovers ~15% of the symbol
+    ILI9488_QR_ECC_QUARTILE = 2, ///< Recovers ~25% of the symbol
+    ILI9488_QR_ECC_HIGH = 3      ///< Recovers ~30% of the symbol
+} ILI9488_QrEcc_t;
+
+/**
+ * @brief Get the QR code version needed for a payload
+ * @param len Payload length in bytes
+ * @param ecc Error correction level
+ * @return QR code version (1 to ILI9488_QR_MAX_VERSION), or 0 if the payload
+ *         does not fit. The symbol is (17 + 4 * version) modules wide.
+ */
+uint8_t ILI9488_QRCodeVersion(uint16_t len, ILI9488_QrEcc_t ecc);
+
+/**
+ * @brief Encode and draw a QR code on the display
+ * @param x Left edge of the quiet zone
+ * @param y Top edge of the quiet zone
+ * @param data Payload bytes (encoded in byte mode)
+ * @param len Payload length in bytes
+ * @param ecc Error correction level
+ * @param scale Module size in pixels (1 or more)
+ * @param fg 18-bit RGB color of dark modules (RGB666 format)
+ * @param bg 18-bit RGB color of light modules and the quiet zone
+ * @return QR code version drawn, or 0 if the payload does not fit
+ */
+uint8_t ILI9488_DrawQRCode(uint16_t x, uint16_t y, const uint8_t *data, uint16_t len,
+                           ILI9488_QrEcc_t ecc, uint8_t scale, uint32_t fg, uint32_t bg);
+
+/**
+ * @brief Draw a Code128 barcode on the display
+ * @param x Left edge of the quiet zone
+ * @param y Top edge of the bars
+ * @param text Null-terminated ASCII text (characters 32 to 127)
+ * @param module Narrow bar width in pixels (1 or more)
+ * @param height Bar height in pixels
+ * @param fg 18-bit RGB color of the bars (RGB666 format)
+ * @param bg 18-bit RGB color of the spaces and the quiet zone
+ * @return Total barcode width in pixels including quiet zones, or 0 if the
+ *         text is empty, too long or contains unsupported characters
+ */
+uint16_t ILI9488_DrawCode128(uint16_t x, uint16_t y, const char *text, uint8_t module,
+                             uint16_t height, uint32_t fg, uint32_t bg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ILI9488_BARCODE_H */
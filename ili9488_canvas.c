@@ -0,0 +1,321 @@
+/**
+ * @file ili9488_canvas.c
+ * @brief ILI9488 RAM canvases with DMA2D acceleration
+ * @details This file contains the implementation of the canvas operations.
+ *          With ILI9488_DMA2D each operation programs the DMA2D registers
+ *          directly and sets START; the HAL DMA2D driver is not needed. The
+ *          software path follows the DMA2D conversions and blending formula,
+ *          so both give the same pixels.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <stddef.h>
+#include "ili9488_canvas.h"
+
+#ifdef ILI9488_DMA2D
+/* DMA2D transfer modes (CR MODE field) */
+#define DMA2D_MODE_M2M         0x00000u  ///< Memory to memory
+#define DMA2D_MODE_M2M_PFC     0x10000u  ///< Memory to memory with pixel format conversion
+#define DMA2D_MODE_M2M_BLEND   0x20000u  ///< Memory to memory with blending
+#define DMA2D_MODE_R2M         0x30000u  ///< Register to memory
+#define DMA2D_ALPHA_MULTIPLY   0x20000u  ///< FGPFCCR AM: pixel alpha times the ALPHA field
+
+/* Called after START is set; the host model of tools/ili9488_dma2d.h runs the transfer here */
+#ifndef ILI9488_DMA2D_HOOK
+#define ILI9488_DMA2D_HOOK()  ((void)0)
+#endif
+#endif
+
+/* Bytes per pixel of each format */
+static const uint8_t ili9488_canvas_bytes[3] = { 4, 3, 2 };
+
+/* One row of bus words for ILI9488_CanvasFlush() */
+static uint32_t ili9488_canvas_row[ILI9488_LANDSCAPE_WIDTH];
+
+/**
+ * @brief Check that a rectangle lies inside a canvas
+ */
+static inline uint8_t ILI9488_Canvas_Inside(const ILI9488_Canvas_t *canvas, uint16_t x, uint16_t y, uint16_t w, uint16_t h){
+    return w > 0 && h > 0 && (uint32_t)x + w <= canvas->width && (uint32_t)y + h <= canvas->height;
+}
+
+/**
+ * @brief Address of a pixel
+ */
+static inline uint8_t *ILI9488_Canvas_Address(const ILI9488_Canvas_t *canvas, uint16_t x, uint16_t y){
+    return (uint8_t *)canvas->pixels + ((uint32_t)y * canvas->stride + x) * ili9488_canvas_bytes[canvas->format];
+}
+
+/**
+ * @brief Read a pixel as ARGB8888
+ * @details RGB565 channels are widened by repeating their high bits, as the
+ *          DMA2D pixel format converter does.
+ */
+static inline ILI9488_FAST_INLINE uint32_t ILI9488_Canvas_Read(const ILI9488_Canvas_t *canvas, uint16_t x, uint16_t y){
+    const uint8_t *p = ILI9488_Canvas_Address(canvas, x, y);
+    switch(canvas->format){
+        case ILI9488_CANVAS_ARGB8888:
+            return *(const uint32_t *)p;
+        case ILI9488_CANVAS_RGB888:
+            return 0xFF000000u | ((uint32_t)p[2] << 16) | ((uint32_t)p[1] << 8) | p[0];
+        default: {
+            uint32_t v = *(const uint16_t *)p;
+            uint32_t r = v >> 11, g = (v >> 5) & 0x3F, b = v & 0x1F;
+            return 0xFF000000u | (((r << 3) | (r >> 2)) << 16) | (((g << 2) | (g >> 4)) << 8) | ((b << 3) | (b >> 2));
+        }
+    }
+}
+
+/**
+ * @brief Convert an ARGB8888 color to the word of a format
+ * @details Formats without alpha drop it; RGB565 keeps the high bits of
+ *          each channel.
+ */
+static inline uint32_t ILI9488_Canvas_Pack(ILI9488_CanvasFormat_t format, uint32_t argb){
+    switch(format){
+        case ILI9488_CANVAS_ARGB8888:
+            return argb;
+        case ILI9488_CANVAS_RGB888:
+            return argb & 0xFFFFFF;
+        default:
+            return ((argb >> 8) & 0xF800) | ((argb >> 5) & 0x07E0) | ((argb >> 3) & 0x001F);
+    }
+}
+
+#ifndef ILI9488_DMA2D
+/**
+ * @brief Write a pixel given as ARGB8888
+ */
+static inline ILI9488_FAST_INLINE void ILI9488_Canvas_Write(const ILI9488_Canvas_t *canvas, uint16_t x, uint16_t y, uint32_t argb){
+    uint8_t *p = ILI9488_Canvas_Address(canvas, x, y);
+    uint32_t word = ILI9488_Canvas_Pack(canvas->format, argb);
+    switch(canvas->format){
+        case ILI9488_CANVAS_ARGB8888:
+            *(uint32_t *)p = word;
+            break;
+        case ILI9488_CANVAS_RGB888:
+            p[0] = (uint8_t)word;
+            p[1] = (uint8_t)(word >> 8);
+            p[2] = (uint8_t)(word >> 16);
+            break;
+        default:
+            *(uint16_t *)p = (uint16_t)word;
+            break;
+    }
+}
+
+/**
+ * @brief Blend a foreground pixel over a background pixel as the DMA2D does
+ * @param fg Foreground ARGB8888
+ * @param bg Background ARGB8888
+ * @param alpha Constant alpha multiplied with the foreground alpha
+ * @return Blended ARGB8888
+ */
+static inline ILI9488_FAST_INLINE uint32_t ILI9488_Canvas_Blend(uint32_t fg, uint32_t bg, uint8_t alpha){
+    uint32_t fa = (fg >> 24) * alpha / 255, ba = bg >> 24;
+    uint32_t both = fa * ba / 255, oa = fa + ba - both;
+    uint32_t out = oa << 24;
+    if(oa == 0) return 0;
+    for(uint8_t shift = 0; shift < 24; shift += 8){
+        uint32_t cf = (fg >> shift) & 0xFF, cb = (bg >> shift) & 0xFF;
+        out |= ((cf * fa + cb * ba - cb * both) / oa) << shift;
+    }
+    return out;
+}
+#endif
+
+/**
+ * @brief Describe a canvas with rows of width pixels
+ * @param canvas Canvas
+ * @param pixels width * height pixels of the format
+ * @param width Width in pixels
+ * @param height Height in pixels
+ * @param format Pixel format
+ */
+void ILI9488_CanvasInit(ILI9488_Canvas_t *canvas, void *pixels, uint16_t width, uint16_t height, ILI9488_CanvasFormat_t format){
+    canvas->pixels = pixels;
+    canvas->width = width;
+    canvas->height = height;
+    canvas->stride = width;
+    canvas->format = format;
+}
+
+/**
+ * @brief Wait for the canvas operation in progress
+ */
+void ILI9488_CanvasWait(void){
+#ifdef ILI9488_DMA2D
+    while(DMA2D->CR & DMA2D_CR_START){
+    }
+#endif
+}
+
+#ifdef ILI9488_DMA2D
+/**
+ * @brief Program the output of a transfer and start it
+ * @param mode DMA2D_MODE_* value
+ * @param dst Output canvas
+ * @param x Left edge in the output
+ * @param y Top edge in the output
+ * @param w Width
+ * @param h Height
+ */
+static void ILI9488_Canvas_Start(uint32_t mode, const ILI9488_Canvas_t *dst, uint16_t x, uint16_t y, uint16_t w, uint16_t h){
+    DMA2D->OPFCCR = dst->format;
+    DMA2D->OMAR = (uintptr_t)ILI9488_Canvas_Address(dst, x, y);
+    DMA2D->OOR = dst->stride - w;
+    DMA2D->NLR = ((uint32_t)w << 16) | h;
+    DMA2D->CR = mode | DMA2D_CR_START;
+    ILI9488_DMA2D_HOOK();
+}
+
+/**
+ * @brief Program the foreground of a transfer
+ */
+static inline void ILI9488_Canvas_Foreground(const ILI9488_Canvas_t *src, uint16_t x, uint16_t y, uint16_t w, uint32_t pfc){
+    DMA2D->FGMAR = (uintptr_t)ILI9488_Canvas_Address(src, x, y);
+    DMA2D->FGOR = src->stride - w;
+    DMA2D->FGPFCCR = pfc | src->format;
+}
+#endif
+
+/**
+ * @brief Fill a rectangle of a canvas with a color (DMA2D register-to-memory)
+ * @param canvas Canvas
+ * @param x Left edge
+ * @param y Top edge
+ * @param w Width (1 or more)
+ * @param h Height (1 or more)
+ * @param argb ARGB8888 color, converted to the canvas format
+ * @return 1 on success, 0 if the rectangle is not inside the canvas
+ */
+ILI9488_FAST uint8_t ILI9488_CanvasFill(const ILI9488_Canvas_t *canvas, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint32_t argb){
+    if(!ILI9488_Canvas_Inside(canvas, x, y, w, h)) return 0;
+    ILI9488_CanvasWait();
+#ifdef ILI9488_DMA2D
+    DMA2D->OCOLR = ILI9488_Canvas_Pack(canvas->format, argb);
+    ILI9488_Canvas_Start(DMA2D_MODE_R2M, canvas, x, y, w, h);
+#else
+    for(uint16_t row = 0; row < h; row++){
+        if(canvas->format == ILI9488_CANVAS_ARGB8888){
+            uint32_t *p = (uint32_t *)ILI9488_Canvas_Address(canvas, x, y + row);
+            for(uint16_t i = 0; i < w; i++) p[i] = argb;
+            continue;
+        }
+        for(uint16_t i = 0; i < w; i++) ILI9488_Canvas_Write(canvas, x + i, y + row, argb);
+    }
+#endif
+    return 1;
+}
+
+/**
+ * @brief Copy a rectangle between canvases (DMA2D memory-to-memory, with pixel format conversion if the formats differ)
+ * @param dst Destination canvas
+ * @param dx Left edge in the destination
+ * @param dy Top edge in the destination
+ * @param src Source canvas, not overlapping the destination rectangle
+ * @param sx Left edge in the source
+ * @param sy Top edge in the source
+ * @param w Width (1 or more)
+ * @param h Height (1 or more)
+ * @return 1 on success, 0 if a rectangle is not inside its canvas
+ */
+ILI9488_FAST uint8_t ILI9488_CanvasCopy(const ILI9488_Canvas_t *dst, uint16_t dx, uint16_t dy,
+                                        const ILI9488_Canvas_t *src, uint16_t sx, uint16_t sy, uint16_t w, uint16_t h){
+    if(!ILI9488_Canvas_Inside(dst, dx, dy, w, h) || !ILI9488_Canvas_Inside(src, sx, sy, w, h)) return 0;
+    ILI9488_CanvasWait();
+#ifdef ILI9488_DMA2D
+    ILI9488_Canvas_Foreground(src, sx, sy, w, 0);
+    ILI9488_Canvas_Start(src->format == dst->format ? DMA2D_MODE_M2M : DMA2D_MODE_M2M_PFC, dst, dx, dy, w, h);
+#else
+    for(uint16_t row = 0; row < h; row++){
+        if(src->format == dst->format){
+            const uint8_t *from = ILI9488_Canvas_Address(src, sx, sy + row);
+            uint8_t *to = ILI9488_Canvas_Address(dst, dx, dy + row);
+            for(uint32_t i = 0; i < (uint32_t)w * ili9488_canvas_bytes[dst->format]; i++) to[i] = from[i];
+            continue;
+        }
+        for(uint16_t i = 0; i < w; i++){
+            ILI9488_Canvas_Write(dst, dx + i, dy + row, ILI9488_Canvas_Read(src, sx + i, sy + row));
+        }
+    }
+#endif
+    return 1;
+}
+
+/**
+ * @brief Blend a rectangle of one canvas over another (DMA2D memory-to-memory with blending)
+ * @param dst Destination canvas, also the background
+ * @param dx Left edge in the destination
+ * @param dy Top edge in the destination
+ * @param src Foreground canvas
+ * @param sx Left edge in the foreground
+ * @param sy Top edge in the foreground
+ * @param w Width (1 or more)
+ * @param h Height (1 or more)
+ * @param alpha Opacity of the foreground, multiplied with its pixel alpha (255 for opaque)
+ * @return 1 on success, 0 if a rectangle is not inside its canvas
+ */
+ILI9488_FAST uint8_t ILI9488_CanvasBlend(const ILI9488_Canvas_t *dst, uint16_t dx, uint16_t dy,
+                                         const ILI9488_Canvas_t *src, uint16_t sx, uint16_t sy, uint16_t w, uint16_t h, uint8_t alpha){
+    if(!ILI9488_Canvas_Inside(dst, dx, dy, w, h) || !ILI9488_Canvas_Inside(src, sx, sy, w, h)) return 0;
+    ILI9488_CanvasWait();
+#ifdef ILI9488_DMA2D
+    ILI9488_Canvas_Foreground(src, sx, sy, w, ((uint32_t)alpha << 24) | DMA2D_ALPHA_MULTIPLY);
+    DMA2D->BGMAR = (uintptr_t)ILI9488_Canvas_Address(dst, dx, dy);
+    DMA2D->BGOR = dst->stride - w;
+    DMA2D->BGPFCCR = dst->format;
+    ILI9488_Canvas_Start(DMA2D_MODE_M2M_BLEND, dst, dx, dy, w, h);
+#else
+    for(uint16_t row = 0; row < h; row++){
+        for(uint16_t i = 0; i < w; i++){
+            uint32_t fg = ILI9488_Canvas_Read(src, sx + i, sy + row);
+            uint32_t bg = ILI9488_Canvas_Read(dst, dx + i, dy + row);
+            ILI9488_Canvas_Write(dst, dx + i, dy + row, ILI9488_Canvas_Blend(fg, bg, alpha));
+        }
+    }
+#endif
+    return 1;
+}
+
+/**
+ * @brief Read a pixel of a canvas
+ * @param canvas Canvas
+ * @param x Column
+ * @param y Row
+ * @return ARGB8888 color, alpha 0xFF for formats without alpha
+ */
+uint32_t ILI9488_CanvasGetPixel(const ILI9488_Canvas_t *canvas, uint16_t x, uint16_t y){
+    ILI9488_CanvasWait();
+    return ILI9488_Canvas_Read(canvas, x, y);
+}
+
+/**
+ * @brief Send a rectangle of a canvas to the panel
+ * @param canvas Canvas
+ * @param x Left edge in the canvas
+ * @param y Top edge in the canvas
+ * @param w Width (1 or more)
+ * @param h Height (1 or more)
+ * @param screen_x Left edge on the screen
+ * @param screen_y Top edge on the screen
+ * @return 1 on success, 0 if the rectangle is not inside the canvas or wider than the screen
+ * @details The rectangle goes through one address window, a row of bus
+ *          words at a time.
+ */
+ILI9488_FAST uint8_t ILI9488_CanvasFlush(const ILI9488_Canvas_t *canvas, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                                         uint16_t screen_x, uint16_t screen_y){
+    if(!ILI9488_Canvas_Inside(canvas, x, y, w, h) || w > ILI9488_LANDSCAPE_WIDTH) return 0;
+    ILI9488_CanvasWait();
+    ILI9488_SetWindow(screen_x, screen_y, w, h);
+    for(uint16_t row = 0; row < h; row++){
+        for(uint16_t i = 0; i < w; i++){
+            uint32_t argb = ILI9488_Canvas_Read(canvas, x + i, y + row);
+            ili9488_canvas_row[i] = ILI9488_ARGB_TO_BUS(argb);
+        }
+        ILI9488_WriteBus(ili9488_canvas_row, w);
+    }
+    return 1;
+}
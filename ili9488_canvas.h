@@ -0,0 +1,156 @@
+/**
+ * @file ili9488_canvas.h
+ * @brief ILI9488 RAM canvases with DMA2D acceleration
+ * @details This header file contains the declarations for compositing into
+ *          RAM before a region is flushed to the panel: rectangle fills,
+ *          copies between canvases with pixel format conversion, and alpha
+ *          blending. With ILI9488_DMA2D defined (in main.h or on the compiler
+ *          command line) the operations are run by the DMA2D (Chrom-ART) of
+ *          F4, F7 and H7 parts and return as soon as it has started; the next
+ *          operation, ILI9488_CanvasWait() or ILI9488_CanvasFlush() waits for
+ *          it. Otherwise the same operations run in software, with the same
+ *          results.
+ *
+ *          Canvases use the DMA2D pixel formats, with 8-bit channels:
+ *          ARGB8888, RGB888 and RGB565. Driver colors (RGB666) are expanded
+ *          with ILI9488_COLOR_TO_ARGB(), and ILI9488_CanvasFlush() sends a
+ *          region to the panel through the current transport.
+ *
+ *          On parts with a data cache, place canvases in a non-cacheable
+ *          region, as the DMA2D reads and writes them behind the cache.
+ *          tools/ili9488_dma2d.c models the DMA2D registers for host builds.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_CANVAS_H
+#define __ILI9488_CANVAS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* For uint8_t, uint16_t, uint32_t */
+#include <stdint.h>
+#include "ili9488.h"
+
+/**
+ * @brief Expand an RGB666 color to opaque ARGB8888
+ * @details Each 6-bit channel moves to the top of its byte and its two high
+ *          bits are repeated below, so 0x3F becomes 0xFF.
+ */
+#define ILI9488_COLOR_TO_ARGB(c)  (0xFF000000u | (((c) & 0x3F3F3Fu) << 2) | (((c) >> 4) & 0x030303u))
+
+/**
+ * @brief Convert an ARGB8888 color to an 18-bit bus word, dropping alpha
+ */
+#define ILI9488_ARGB_TO_BUS(c)    ((((c) >> 6) & 0x3F000u) | (((c) >> 4) & 0xFC0u) | (((c) >> 2) & 0x3Fu))
+
+/**
+ * @brief Canvas pixel formats, numbered as the DMA2D color modes
+ */
+typedef enum {
+    ILI9488_CANVAS_ARGB8888 = 0,  ///< uint32_t 0xAARRGGBB
+    ILI9488_CANVAS_RGB888 = 1,    ///< 3 bytes per pixel: blue, green, red
+    ILI9488_CANVAS_RGB565 = 2     ///< uint16_t, red in the top 5 bits
+} ILI9488_CanvasFormat_t;
+
+/**
+ * @brief Pixel array in RAM
+ */
+typedef struct {
+    void *pixels;                 ///< First pixel of the first row
+    uint16_t width;               ///< Width in pixels
+    uint16_t height;              ///< Height in pixels
+    uint16_t stride;              ///< Pixels from the start of one row to the next
+    ILI9488_CanvasFormat_t format;///< Pixel format
+} ILI9488_Canvas_t;
+
+/**
+ * @brief Describe a canvas with rows of width pixels
+ * @param canvas Canvas
+ * @param pixels width * height pixels of the format
+ * @param width Width in pixels
+ * @param height Height in pixels
+ * @param format Pixel format
+ */
+void ILI9488_CanvasInit(ILI9488_Canvas_t *canvas, void *pixels, uint16_t width, uint16_t height, ILI9488_CanvasFormat_t format);
+
+/**
+ * @brief Fill a rectangle of a canvas with a color (DMA2D register-to-memory)
+ * @param canvas Canvas
+ * @param x Left edge
+ * @param y Top edge
+ * @param w Width (1 or more)
+ * @param h Height (1 or more)
+ * @param argb ARGB8888 color, converted to the canvas format
+ * @return 1 on success, 0 if the rectangle is not inside the canvas
+ */
+uint8_t ILI9488_CanvasFill(const ILI9488_Canvas_t *canvas, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint32_t argb);
+
+/**
+ * @brief Copy a rectangle between canvases (DMA2D memory-to-memory, with pixel format conversion if the formats differ)
+ * @param dst Destination canvas
+ * @param dx Left edge in the destination
+ * @param dy Top edge in the destination
+ * @param src Source canvas, not overlapping the destination rectangle
+ * @param sx Left edge in the source
+ * @param sy Top edge in the source
+ * @param w Width (1 or more)
+ * @param h Height (1 or more)
+ * @return 1 on success, 0 if a rectangle is not inside its canvas
+ */
+uint8_t ILI9488_CanvasCopy(const ILI9488_Canvas_t *dst, uint16_t dx, uint16_t dy,
+                           const ILI9488_Canvas_t *src, uint16_t sx, uint16_t sy, uint16_t w, uint16_t h);
+
+/**
+ * @brief Blend a rectangle of one canvas over another (DMA2D memory-to-memory with blending)
+ * @param dst Destination canvas, also the background
+ * @param dx Left edge in the destination
+ * @param dy Top edge in the destination
+ * @param src Foreground canvas
+ * @param sx Left edge in the foreground
+ * @param sy Top edge in the foreground
+ * @param w Width (1 or more)
+ * @param h Height (1 or more)
+ * @param alpha Opacity of the foreground, multiplied with its pixel alpha (255 for opaque)
+ * @return 1 on success, 0 if a rectangle is not inside its canvas
+ */
+uint8_t ILI9488_CanvasBlend(const ILI9488_Canvas_t *dst, uint16_t dx, uint16_t dy,
+                            const ILI9488_Canvas_t *src, uint16_t sx, uint16_t sy, uint16_t w, uint16_t h, uint8_t alpha);
+
+/**
+ * @brief Wait for the canvas operation in progress
+ * @details Call before the CPU reads or writes pixels an operation touches.
+ */
+void ILI9488_CanvasWait(void);
+
+/**
+ * @brief Read a pixel of a canvas
+ * @param canvas Canvas
+ * @param x Column
+ * @param y Row
+ * @return ARGB8888 color, alpha 0xFF for formats without alpha
+ */
+uint32_t ILI9488_CanvasGetPixel(const ILI9488_Canvas_t *canvas, uint16_t x, uint16_t y);
+
+/**
+ * @brief Send a rectangle of a canvas to the panel
+ * @param canvas Canvas
+ * @param x Left edge in the canvas
+ * @param y Top edge in the canvas
+ * @param w Width (1 or more)
+ * @param h Height (1 or more)
+ * @param screen_x Left edge on the screen
+ * @param screen_y Top edge on the screen
+ * @return 1 on success, 0 if the rectangle is not inside the canvas or wider than the screen
+ */
+uint8_t ILI9488_CanvasFlush(const ILI9488_Canvas_t *canvas, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                            uint16_t screen_x, uint16_t screen_y);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ILI9488_CANVAS_H */
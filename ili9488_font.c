@@ -0,0 +1,415 @@
+/**
+ * @file ili9488_font.c
+ * @brief ILI9488 compressed fonts
+ * @details This file contains the glyph run decoder. A glyph cell is painted
+ *          in one address window, and every pixel of it goes through a small
+ *          sink that merges consecutive pixels of one color into a single
+ *          repeated-strobe run and gathers alpha pixels into short bursts.
+ *          The background above, below and beside the glyph box merges with
+ *          the background runs of the glyph itself, so a typical digit is
+ *          sent as a few dozen runs.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <stddef.h>
+#include "ili9488_font.h"
+
+/* Alpha pixels gathered before a burst is sent */
+#define FONT_BURST  32
+
+/**
+ * @brief Bus words for the 16 alpha levels between background and text color
+ */
+typedef struct {
+    uint32_t shade[16];
+} ILI9488_FontInk_t;
+
+/**
+ * @brief Pending output of the glyph decoder
+ * @details At most one of the run and the burst is non-empty at any time,
+ *          which keeps the pixels in order.
+ */
+typedef struct {
+    uint32_t word;                ///< Bus word of the pending run
+    uint32_t count;               ///< Length of the pending run
+    uint32_t burst[FONT_BURST];   ///< Pending alpha pixels
+    uint32_t burst_count;         ///< Number of pending alpha pixels
+    uint32_t *out;                ///< Memory to write to instead of the bus, or NULL
+} ILI9488_FontSink_t;
+
+/**
+ * @brief Run decoder state of one glyph
+ */
+typedef struct {
+    const uint8_t *p;    ///< Next glyph data byte
+    uint8_t kind;        ///< Current code: 0 background, 1 foreground, 2 alpha
+    uint8_t remaining;   ///< Pixels left in the current code
+    uint8_t nibble;      ///< Alpha runs: 1 if the low nibble of *p is next
+    uint8_t pair;        ///< Foreground pixels still owed by a pair code
+} ILI9488_FontCursor_t;
+
+/* Decoder state of every glyph of the line being drawn */
+static ILI9488_FontCursor_t ili9488_font_cursor[ILI9488_FONT_LINE_GLYPHS];
+
+/**
+ * @brief Get the glyph table of a font
+ */
+static inline const ILI9488_FontGlyph_t *ILI9488_Font_Glyphs(const ILI9488_FontHeader_t *header){
+    const ILI9488_FontRange_t *ranges = (const ILI9488_FontRange_t *)(header + 1);
+    return (const ILI9488_FontGlyph_t *)(ranges + header->range_count);
+}
+
+/**
+ * @brief Get the glyph data of a font
+ */
+static inline const uint8_t *ILI9488_Font_Data(const ILI9488_FontHeader_t *header){
+    const ILI9488_FontKern_t *kerns = (const ILI9488_FontKern_t *)(ILI9488_Font_Glyphs(header) + header->glyph_count);
+    return (const uint8_t *)(kerns + header->kern_count);
+}
+
+/**
+ * @brief Compute the bus words of all alpha levels
+ * @param ink Output table
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ */
+static void ILI9488_Font_Ink(ILI9488_FontInk_t *ink, uint32_t color, uint32_t bg){
+    uint32_t f = ILI9488_COLOR_TO_BUS(color), b = ILI9488_COLOR_TO_BUS(bg);
+    for(uint32_t a = 0; a < 16; a++){
+        uint32_t word = 0;
+        for(uint32_t shift = 0; shift < 18; shift += 6){
+            uint32_t fc = (f >> shift) & 0x3F, bc = (b >> shift) & 0x3F;
+            word |= ((fc * a + bc * (15 - a) + 7) / 15) << shift;
+        }
+        ink->shade[a] = word;
+    }
+}
+
+/**
+ * @brief Send whatever the sink holds
+ */
+static inline ILI9488_FAST_INLINE void ILI9488_Font_Flush(ILI9488_FontSink_t *sink){
+    if(sink->out){
+        for(uint32_t i = 0; i < sink->count; i++) *sink->out++ = sink->word;
+        for(uint32_t i = 0; i < sink->burst_count; i++) *sink->out++ = sink->burst[i];
+    }
+    else{
+        if(sink->count) ILI9488_WriteBusRun(sink->word, sink->count);
+        if(sink->burst_count) ILI9488_WriteBus(sink->burst, sink->burst_count);
+    }
+    sink->count = 0;
+    sink->burst_count = 0;
+}
+
+/**
+ * @brief Add a run of one bus word to the sink
+ */
+static inline void ILI9488_Font_Run(ILI9488_FontSink_t *sink, uint32_t word, uint32_t count){
+    if(count == 0) return;
+    if(sink->burst_count || (sink->count && sink->word != word)) ILI9488_Font_Flush(sink);
+    sink->word = word;
+    sink->count += count;
+}
+
+/**
+ * @brief Add one alpha pixel to the sink
+ */
+static inline void ILI9488_Font_Pixel(ILI9488_FontSink_t *sink, uint32_t word){
+    if(sink->count) ILI9488_Font_Flush(sink);
+    sink->burst[sink->burst_count++] = word;
+    if(sink->burst_count == FONT_BURST) ILI9488_Font_Flush(sink);
+}
+
+/**
+ * @brief Decode one glyph row into the sink
+ * @param cursor Glyph decoder state
+ * @param width Glyph box width
+ * @param skip Leading pixels of the row to decode without sending
+ * @param visible Pixels to send after the skipped ones
+ * @param sink Output
+ * @param ink Alpha level table
+ * @details The whole row is always consumed, so the cursor ends up at the
+ *          next row whatever part of it was visible.
+ */
+static inline ILI9488_FAST_INLINE void ILI9488_Font_Row(ILI9488_FontCursor_t *cursor, uint8_t width, int32_t skip, int32_t visible,
+                                                        ILI9488_FontSink_t *sink, const ILI9488_FontInk_t *ink){
+    int32_t end = skip + visible;
+    for(int32_t col = 0; col < width;){
+        if(cursor->remaining == 0 && cursor->pair){
+            /* Second half of a background/foreground pair */
+            cursor->kind = 1;
+            cursor->remaining = cursor->pair;
+            cursor->pair = 0;
+        }
+        else if(cursor->remaining == 0){
+            uint8_t code = *cursor->p++;
+            cursor->kind = code >> 6;
+            cursor->remaining = (code & 0x3F) + 1;
+            cursor->nibble = 0;
+            if(cursor->kind == 3){
+                cursor->kind = 0;
+                cursor->remaining = ((code >> 3) & 0x07) + 1;
+                cursor->pair = (code & 0x07) + 1;
+            }
+        }
+        int32_t n = cursor->remaining < width - col ? cursor->remaining : width - col;
+        if(cursor->kind == 2){
+            for(int32_t i = col; i < col + n; i++){
+                uint8_t level = cursor->nibble ? (*cursor->p++ & 0x0F) : (*cursor->p >> 4);
+                cursor->nibble ^= 1;
+                if(i >= skip && i < end) ILI9488_Font_Pixel(sink, ink->shade[level]);
+            }
+            /* An odd alpha run leaves a padding nibble */
+            if(cursor->remaining == n && cursor->nibble) cursor->p++;
+        }
+        else{
+            int32_t a = col > skip ? col : skip, b = col + n < end ? col + n : end;
+            if(b > a) ILI9488_Font_Run(sink, ink->shade[cursor->kind == 1 ? 15 : 0], (uint32_t)(b - a));
+        }
+        cursor->remaining -= (uint8_t)n;
+        col += n;
+    }
+}
+
+/**
+ * @brief Decode a line of glyphs into a sink
+ * @param width Width of the line
+ * @param header Font header
+ * @param glyphs Glyphs, left to right
+ * @param positions Cell position of every glyph from the left edge
+ * @param count Number of glyphs
+ * @param ink Alpha level table
+ * @param sink Output, width * line_height pixels
+ * @details Every pixel row of the line is built from the matching row of
+ *          each glyph it crosses, with background in between. Where glyph
+ *          boxes overlap, the earlier glyph wins.
+ */
+static ILI9488_FAST void ILI9488_Font_Paint(uint16_t width, const ILI9488_FontHeader_t *header,
+                                            const ILI9488_FontGlyph_t *const *glyphs, const int16_t *positions, uint16_t count,
+                                            const ILI9488_FontInk_t *ink, ILI9488_FontSink_t *sink){
+    const uint8_t *data = ILI9488_Font_Data(header);
+    uint32_t bg = ink->shade[0];
+
+    if(count > ILI9488_FONT_LINE_GLYPHS) count = ILI9488_FONT_LINE_GLYPHS;
+    for(uint16_t i = 0; i < count; i++){
+        ili9488_font_cursor[i].p = data + glyphs[i]->offset;
+        ili9488_font_cursor[i].kind = 0;
+        ili9488_font_cursor[i].remaining = 0;
+        ili9488_font_cursor[i].nibble = 0;
+        ili9488_font_cursor[i].pair = 0;
+    }
+    sink->count = 0;
+    sink->burst_count = 0;
+
+    for(uint16_t row = 0; row < header->line_height; row++){
+        int32_t col = 0;
+        for(uint16_t i = 0; i < count; i++){
+            const ILI9488_FontGlyph_t *glyph = glyphs[i];
+            if(row < glyph->y_offset || row >= glyph->y_offset + glyph->height) continue;
+            int32_t gx = positions[i] + glyph->x_offset;
+            if(gx > col){
+                int32_t gap = (gx < width ? gx : width) - col;
+                ILI9488_Font_Run(sink, bg, (uint32_t)gap);
+                col += gap;
+            }
+            int32_t visible = (gx + glyph->width < width ? gx + glyph->width : width) - col;
+            if(visible < 0) visible = 0;
+            ILI9488_Font_Row(&ili9488_font_cursor[i], glyph->width, col - gx, visible, sink, ink);
+            col += visible;
+        }
+        ILI9488_Font_Run(sink, bg, (uint32_t)(width - col));
+    }
+    ILI9488_Font_Flush(sink);
+}
+
+/**
+ * @brief Paint a line of glyphs in one address window
+ * @param x Left edge of the line
+ * @param y Top edge of the line
+ * @param width Width of the line window
+ * @param header Font header
+ * @param glyphs Glyphs, left to right
+ * @param positions Cell position of every glyph from the left edge
+ * @param count Number of glyphs
+ * @param ink Alpha level table
+ */
+static void ILI9488_Font_Line(uint16_t x, uint16_t y, uint16_t width, const ILI9488_FontHeader_t *header,
+                              const ILI9488_FontGlyph_t *const *glyphs, const int16_t *positions, uint16_t count,
+                              const ILI9488_FontInk_t *ink){
+    ILI9488_FontSink_t sink;
+
+    if(x >= ILI9488_GetWidth() || (uint32_t)y + header->line_height > ILI9488_GetHeight()) return;
+    if((uint32_t)x + width > ILI9488_GetWidth()) width = ILI9488_GetWidth() - x;
+    if(width == 0 || header->line_height == 0) return;
+
+    sink.out = NULL;
+    ILI9488_SetWindow(x, y, width, header->line_height);
+    ILI9488_Font_Paint(width, header, glyphs, positions, count, ink, &sink);
+}
+
+/**
+ * @brief Find the glyph of a code point
+ * @param font Font blob (4-byte aligned)
+ * @param codepoint Unicode code point
+ * @return Glyph metrics, or NULL if the font has no such glyph
+ * @details Binary search for the last range starting at or before the code
+ *          point.
+ */
+const ILI9488_FontGlyph_t *ILI9488_FontGlyph(const void *font, uint32_t codepoint){
+    const ILI9488_FontHeader_t *header = (const ILI9488_FontHeader_t *)font;
+    const ILI9488_FontRange_t *ranges = (const ILI9488_FontRange_t *)(header + 1);
+    uint32_t lo = 0, hi = header->range_count;
+
+    while(lo < hi){
+        uint32_t mid = (lo + hi) / 2;
+        if(ranges[mid].first <= codepoint) lo = mid + 1;
+        else hi = mid;
+    }
+    if(lo == 0) return NULL;
+    const ILI9488_FontRange_t *range = &ranges[lo - 1];
+    if(codepoint - range->first >= range->count) return NULL;
+    return ILI9488_Font_Glyphs(header) + range->glyph + (codepoint - range->first);
+}
+
+/**
+ * @brief Get the kerning adjustment between two glyphs
+ * @param font Font blob
+ * @param left Left glyph
+ * @param right Right glyph
+ * @return Advance adjustment in pixels
+ */
+int16_t ILI9488_FontKerning(const void *font, const ILI9488_FontGlyph_t *left, const ILI9488_FontGlyph_t *right){
+    const ILI9488_FontHeader_t *header = (const ILI9488_FontHeader_t *)font;
+    const ILI9488_FontGlyph_t *table = ILI9488_Font_Glyphs(header);
+    const ILI9488_FontKern_t *kerns = (const ILI9488_FontKern_t *)(table + header->glyph_count);
+    uint32_t pair = (uint32_t)(left - table) << 16 | (uint32_t)(right - table);
+    uint32_t lo = 0, hi = header->kern_count;
+
+    while(lo < hi){
+        uint32_t mid = (lo + hi) / 2;
+        if(kerns[mid].pair < pair) lo = mid + 1;
+        else hi = mid;
+    }
+    return (lo < header->kern_count && kerns[lo].pair == pair) ? kerns[lo].adjust : 0;
+}
+
+/**
+ * @brief Draw a line of glyphs in one address window
+ * @param x Left edge of the line
+ * @param y Top edge of the line
+ * @param width Width of the line window; pixels not covered by glyphs are background
+ * @param font Font blob
+ * @param glyphs Glyphs, left to right
+ * @param positions Cell position of every glyph from the left edge of the line
+ * @param count Number of glyphs (up to ILI9488_FONT_LINE_GLYPHS)
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ */
+void ILI9488_DrawGlyphLine(uint16_t x, uint16_t y, uint16_t width, const void *font,
+                           const ILI9488_FontGlyph_t *const *glyphs, const int16_t *positions, uint16_t count,
+                           uint32_t color, uint32_t bg){
+    ILI9488_FontInk_t ink;
+    ILI9488_Font_Ink(&ink, color, bg);
+    ILI9488_Font_Line(x, y, width, (const ILI9488_FontHeader_t *)font, glyphs, positions, count, &ink);
+}
+
+/**
+ * @brief Get the width of a glyph cell
+ * @param glyph Glyph
+ * @return The wider of the advance and the glyph box
+ */
+uint16_t ILI9488_GlyphCellWidth(const ILI9488_FontGlyph_t *glyph){
+    return glyph->advance > glyph->x_offset + glyph->width ? glyph->advance : glyph->x_offset + glyph->width;
+}
+
+/**
+ * @brief Expand a glyph cell into bus words
+ * @param font Font blob
+ * @param glyph Glyph from ILI9488_FontGlyph()
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @param buffer Output, ILI9488_GlyphCellWidth() * line_height words
+ * @return Number of words written
+ */
+uint32_t ILI9488_RenderGlyph(const void *font, const ILI9488_FontGlyph_t *glyph, uint32_t color, uint32_t bg,
+                             uint32_t *buffer){
+    const ILI9488_FontHeader_t *header = (const ILI9488_FontHeader_t *)font;
+    uint16_t width = ILI9488_GlyphCellWidth(glyph);
+    int16_t position = 0;
+    ILI9488_FontInk_t ink;
+    ILI9488_FontSink_t sink;
+
+    ILI9488_Font_Ink(&ink, color, bg);
+    sink.out = buffer;
+    ILI9488_Font_Paint(width, header, &glyph, &position, 1, &ink, &sink);
+    return (uint32_t)width * header->line_height;
+}
+
+/**
+ * @brief Draw one glyph cell
+ * @param x Left edge of the cell
+ * @param y Top edge of the cell
+ * @param font Font blob
+ * @param glyph Glyph from ILI9488_FontGlyph()
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Horizontal advance in pixels
+ */
+uint16_t ILI9488_DrawGlyph(uint16_t x, uint16_t y, const void *font, const ILI9488_FontGlyph_t *glyph,
+                           uint32_t color, uint32_t bg){
+    int16_t position = 0;
+    ILI9488_DrawGlyphLine(x, y, ILI9488_GlyphCellWidth(glyph), font, &glyph, &position, 1, color, bg);
+    return glyph->advance;
+}
+
+/**
+ * @brief Draw a character
+ * @param x Left edge of the cell
+ * @param y Top edge of the cell
+ * @param font Font blob
+ * @param codepoint Unicode code point
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Horizontal advance in pixels, 0 if the font has no such glyph
+ */
+uint16_t ILI9488_DrawChar(uint16_t x, uint16_t y, const void *font, uint32_t codepoint,
+                          uint32_t color, uint32_t bg){
+    const ILI9488_FontGlyph_t *glyph = ILI9488_FontGlyph(font, codepoint);
+    if(glyph == NULL) return 0;
+    return ILI9488_DrawGlyph(x, y, font, glyph, color, bg);
+}
+
+/**
+ * @brief Draw a single line of text
+ * @param x Left edge of the first cell
+ * @param y Top edge of the line
+ * @param font Font blob
+ * @param text Null-terminated text, one byte per code point (ASCII or Latin-1)
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Width of the text in pixels
+ * @details The text is kerned and drawn in one address window. Text beyond
+ *          ILI9488_FONT_LINE_GLYPHS glyphs is not drawn.
+ */
+uint16_t ILI9488_DrawText(uint16_t x, uint16_t y, const void *font, const char *text,
+                          uint32_t color, uint32_t bg){
+    const ILI9488_FontGlyph_t *glyphs[ILI9488_FONT_LINE_GLYPHS];
+    int16_t positions[ILI9488_FONT_LINE_GLYPHS];
+    uint16_t count = 0;
+    int32_t pen = 0, extent = 0;
+
+    for(; *text && count < ILI9488_FONT_LINE_GLYPHS; text++){
+        const ILI9488_FontGlyph_t *glyph = ILI9488_FontGlyph(font, (uint8_t)*text);
+        if(glyph == NULL) continue;
+        if(count) pen += ILI9488_FontKerning(font, glyphs[count - 1], glyph);
+        glyphs[count] = glyph;
+        positions[count++] = (int16_t)pen;
+        if(pen + glyph->x_offset + glyph->width > extent) extent = pen + glyph->x_offset + glyph->width;
+        pen += glyph->advance;
+    }
+    if(pen > extent) extent = pen;
+    if(count) ILI9488_DrawGlyphLine(x, y, (uint16_t)extent, font, glyphs, positions, count, color, bg);
+    return (uint16_t)pen;
+}
@@ -0,0 +1,198 @@
+/**
+ * @file ili9488_font.h
+ * @brief ILI9488 compressed fonts
+ * @details This header file contains the declarations for fonts converted
+ *          offline by tools/ili9488_font.c. Glyphs are stored as byte-coded
+ *          runs of background, foreground and anti-aliased (alpha) pixels.
+ *          The runs are decoded straight onto the bus: background and
+ *          foreground runs become repeated WR strobes of one latched word and
+ *          alpha pixels are blended into short bursts, so no glyph is ever
+ *          expanded into a bitmap buffer.
+ *
+ *          Glyph data codes (one byte, followed by data for alpha runs):
+ *          0x00-0x3F  1 to 64 background pixels
+ *          0x40-0x7F  1 to 64 foreground pixels
+ *          0x80-0xBF  1 to 64 alpha pixels, followed by their 4-bit levels,
+ *                     two per byte, high nibble first
+ *          0xC0-0xFF  1 to 8 background pixels (bits 5-3) then 1 to 8
+ *                     foreground pixels (bits 2-0)
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_FONT_H
+#define __ILI9488_FONT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* For uint8_t, uint16_t, uint32_t */
+#include <stdint.h>
+#include "ili9488.h"
+
+/* Font magic, "ILFN" in little-endian order */
+#define ILI9488_FONT_MAGIC  0x4E464C49
+
+/* Most glyphs drawn in one line window */
+#ifndef ILI9488_FONT_LINE_GLYPHS
+#define ILI9488_FONT_LINE_GLYPHS  96
+#endif
+
+/**
+ * @brief Font header
+ * @details Followed by range_count ranges sorted by first code point,
+ *          glyph_count glyphs, kern_count kerning pairs sorted by pair, and
+ *          data_size bytes of glyph data. All fields are little-endian.
+ */
+typedef struct {
+    uint32_t magic;         ///< ILI9488_FONT_MAGIC
+    uint8_t bpp;            ///< Alpha depth of the source: 1 (no alpha runs) or 4
+    uint8_t reserved;       ///< Always 0
+    uint16_t line_height;   ///< Height of every glyph cell in pixels
+    uint16_t baseline;      ///< Baseline position from the top of the cell
+    uint16_t range_count;   ///< Number of code point ranges
+    uint16_t glyph_count;   ///< Number of glyphs
+    uint16_t kern_count;    ///< Number of kerning pairs
+    uint32_t data_size;     ///< Glyph data size in bytes
+} ILI9488_FontHeader_t;
+
+/**
+ * @brief Run of consecutive code points with consecutive glyphs
+ */
+typedef struct {
+    uint32_t first;   ///< First code point
+    uint16_t count;   ///< Number of code points
+    uint16_t glyph;   ///< Glyph index of the first code point
+} ILI9488_FontRange_t;
+
+/**
+ * @brief Glyph metrics
+ * @details The glyph box lies inside the cell: x_offset + width may exceed
+ *          advance, y_offset + height never exceeds line_height.
+ */
+typedef struct {
+    uint32_t offset;     ///< Offset of the glyph's runs in the glyph data
+    uint8_t width;       ///< Glyph box width
+    uint8_t height;      ///< Glyph box height
+    uint8_t advance;     ///< Horizontal advance to the next glyph
+    uint8_t x_offset;    ///< Glyph box position from the left of the cell
+    uint8_t y_offset;    ///< Glyph box position from the top of the cell
+    uint8_t reserved[3]; ///< Always 0
+} ILI9488_FontGlyph_t;
+
+/**
+ * @brief Kerning pair
+ */
+typedef struct {
+    uint32_t pair;       ///< Left glyph index << 16 | right glyph index
+    int16_t adjust;      ///< Advance adjustment in pixels
+    uint16_t reserved;   ///< Always 0
+} ILI9488_FontKern_t;
+
+/**
+ * @brief Find the glyph of a code point
+ * @param font Font blob (4-byte aligned)
+ * @param codepoint Unicode code point
+ * @return Glyph metrics, or NULL if the font has no such glyph
+ */
+const ILI9488_FontGlyph_t *ILI9488_FontGlyph(const void *font, uint32_t codepoint);
+
+/**
+ * @brief Get the kerning adjustment between two glyphs
+ * @param font Font blob
+ * @param left Left glyph
+ * @param right Right glyph
+ * @return Advance adjustment in pixels
+ */
+int16_t ILI9488_FontKerning(const void *font, const ILI9488_FontGlyph_t *left, const ILI9488_FontGlyph_t *right);
+
+/**
+ * @brief Draw a line of glyphs in one address window
+ * @param x Left edge of the line
+ * @param y Top edge of the line
+ * @param width Width of the line window; pixels not covered by glyphs are background
+ * @param font Font blob
+ * @param glyphs Glyphs, left to right
+ * @param positions Cell position of every glyph from the left edge of the line
+ * @param count Number of glyphs (up to ILI9488_FONT_LINE_GLYPHS)
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @details The window is clipped at the right edge of the screen, and lines
+ *          that do not fit vertically are skipped. Where glyph boxes
+ *          overlap, the earlier glyph wins.
+ */
+void ILI9488_DrawGlyphLine(uint16_t x, uint16_t y, uint16_t width, const void *font,
+                           const ILI9488_FontGlyph_t *const *glyphs, const int16_t *positions, uint16_t count,
+                           uint32_t color, uint32_t bg);
+
+/**
+ * @brief Get the width of a glyph cell
+ * @param glyph Glyph
+ * @return The wider of the advance and the glyph box
+ */
+uint16_t ILI9488_GlyphCellWidth(const ILI9488_FontGlyph_t *glyph);
+
+/**
+ * @brief Expand a glyph cell into bus words
+ * @param font Font blob
+ * @param glyph Glyph from ILI9488_FontGlyph()
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @param buffer Output, ILI9488_GlyphCellWidth() * line_height words
+ * @return Number of words written
+ * @details The words are laid out like a window of the cell, ready for
+ *          ILI9488_WriteBus().
+ */
+uint32_t ILI9488_RenderGlyph(const void *font, const ILI9488_FontGlyph_t *glyph, uint32_t color, uint32_t bg,
+                             uint32_t *buffer);
+
+/**
+ * @brief Draw one glyph cell
+ * @param x Left edge of the cell
+ * @param y Top edge of the cell
+ * @param font Font blob
+ * @param glyph Glyph from ILI9488_FontGlyph()
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Horizontal advance in pixels
+ * @details The whole cell (the wider of the advance and the glyph box, by
+ *          line_height) is painted in one address window.
+ */
+uint16_t ILI9488_DrawGlyph(uint16_t x, uint16_t y, const void *font, const ILI9488_FontGlyph_t *glyph,
+                           uint32_t color, uint32_t bg);
+
+/**
+ * @brief Draw a character
+ * @param x Left edge of the cell
+ * @param y Top edge of the cell
+ * @param font Font blob
+ * @param codepoint Unicode code point
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Horizontal advance in pixels, 0 if the font has no such glyph
+ */
+uint16_t ILI9488_DrawChar(uint16_t x, uint16_t y, const void *font, uint32_t codepoint,
+                          uint32_t color, uint32_t bg);
+
+/**
+ * @brief Draw a single line of text
+ * @param x Left edge of the first cell
+ * @param y Top edge of the line
+ * @param font Font blob
+ * @param text Null-terminated text, one byte per code point (ASCII or Latin-1)
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Width of the text in pixels
+ * @details The text is kerned and painted in one address window. Characters
+ *          missing from the font are skipped.
+ */
+uint16_t ILI9488_DrawText(uint16_t x, uint16_t y, const void *font, const char *text,
+                          uint32_t color, uint32_t bg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ILI9488_FONT_H */
@@ -0,0 +1,223 @@
+/**
+ * @file ili9488_glyphcache.c
+ * @brief ILI9488 glyph cache
+ * @details This file contains the implementation of the glyph cache. Glyph
+ *          cells are kept contiguous in the arena and new ones are taken from
+ *          its top. When the top is full, least recently used glyphs are
+ *          dropped until the new cell fits, and the survivors are moved down
+ *          over the gaps. Entries are matched by font, glyph and both colors
+ *          with a linear search, which costs far less than the cell it saves.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "ili9488_glyphcache.h"
+
+/**
+ * @brief Cached glyph cell
+ */
+typedef struct {
+    const void *font;                   ///< Font, NULL for a free entry
+    const ILI9488_FontGlyph_t *glyph;   ///< Glyph
+    uint32_t color;                     ///< Text color it was expanded for
+    uint32_t bg;                        ///< Background color it was expanded for
+    uint32_t offset;                    ///< Position in the arena
+    uint32_t size;                      ///< Number of words
+    uint32_t last_use;                  ///< Age stamp
+    uint16_t width;                     ///< Cell width
+    uint16_t height;                    ///< Cell height
+} ILI9488_GlyphEntry_t;
+
+/* Arena, entries and counters */
+static uint32_t ili9488_glyph_arena[ILI9488_GLYPH_CACHE_WORDS];
+static ILI9488_GlyphEntry_t ili9488_glyph_entry[ILI9488_GLYPH_CACHE_ENTRIES];
+static ILI9488_GlyphCacheStats_t ili9488_glyph_stats;
+static uint32_t ili9488_glyph_top;
+static uint32_t ili9488_glyph_used;
+static uint32_t ili9488_glyph_clock;
+
+/**
+ * @brief Move the live cells down to the start of the arena
+ */
+static void ILI9488_GlyphCache_Compact(void){
+    uint32_t top = 0;
+
+    /* Place cells in ascending offset order so no move overwrites a cell still to be moved */
+    for(;;){
+        ILI9488_GlyphEntry_t *lowest = NULL;
+        for(uint8_t i = 0; i < ILI9488_GLYPH_CACHE_ENTRIES; i++){
+            ILI9488_GlyphEntry_t *entry = &ili9488_glyph_entry[i];
+            if(entry->font && entry->size == 0){
+                /* An empty cell would be found at the same offset on every pass */
+                entry->font = NULL;
+                continue;
+            }
+            if(entry->font && entry->offset >= top && (lowest == NULL || entry->offset < lowest->offset)) lowest = entry;
+        }
+        if(lowest == NULL) break;
+        if(lowest->offset != top){
+            memmove(&ili9488_glyph_arena[top], &ili9488_glyph_arena[lowest->offset], lowest->size * sizeof(uint32_t));
+            lowest->offset = top;
+        }
+        top += lowest->size;
+    }
+    ili9488_glyph_top = top;
+}
+
+/**
+ * @brief Make room for a cell
+ * @param size Words needed
+ * @return Free entry whose offset points at size free words
+ */
+static ILI9488_GlyphEntry_t *ILI9488_GlyphCache_Allocate(uint32_t size){
+    ILI9488_GlyphEntry_t *slot, *oldest;
+
+    for(;;){
+        slot = NULL;
+        oldest = NULL;
+        for(uint8_t i = 0; i < ILI9488_GLYPH_CACHE_ENTRIES; i++){
+            ILI9488_GlyphEntry_t *entry = &ili9488_glyph_entry[i];
+            if(entry->font == NULL){
+                if(slot == NULL) slot = entry;
+            }
+            else if(oldest == NULL || entry->last_use < oldest->last_use) oldest = entry;
+        }
+        if(slot){
+            if(ili9488_glyph_top + size <= ILI9488_GLYPH_CACHE_WORDS) break;
+            if(ili9488_glyph_used + size <= ILI9488_GLYPH_CACHE_WORDS){
+                /* Enough words are free between the cells */
+                ILI9488_GlyphCache_Compact();
+                continue;
+            }
+        }
+        oldest->font = NULL;
+        ili9488_glyph_used -= oldest->size;
+        ili9488_glyph_stats.evictions++;
+    }
+    slot->offset = ili9488_glyph_top;
+    slot->size = size;
+    ili9488_glyph_top += size;
+    ili9488_glyph_used += size;
+    return slot;
+}
+
+/**
+ * @brief Draw one glyph cell through the cache
+ * @param x Left edge of the cell
+ * @param y Top edge of the cell
+ * @param font Font blob
+ * @param glyph Glyph from ILI9488_FontGlyph()
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Horizontal advance in pixels
+ */
+uint16_t ILI9488_DrawGlyphCached(uint16_t x, uint16_t y, const void *font, const ILI9488_FontGlyph_t *glyph,
+                                 uint32_t color, uint32_t bg){
+    uint16_t width = ILI9488_GlyphCellWidth(glyph);
+    uint16_t height = ((const ILI9488_FontHeader_t *)font)->line_height;
+    uint32_t size = (uint32_t)width * height;
+    ILI9488_GlyphEntry_t *hit = NULL;
+
+    /* Nothing to draw, as in ILI9488_DrawGlyph() */
+    if(size == 0) return glyph->advance;
+    if(size > ILI9488_GLYPH_CACHE_WORDS || (uint32_t)x + width > ILI9488_GetWidth() ||
+       (uint32_t)y + height > ILI9488_GetHeight()){
+        ili9488_glyph_stats.uncached++;
+        return ILI9488_DrawGlyph(x, y, font, glyph, color, bg);
+    }
+
+    for(uint8_t i = 0; i < ILI9488_GLYPH_CACHE_ENTRIES; i++){
+        ILI9488_GlyphEntry_t *entry = &ili9488_glyph_entry[i];
+        if(entry->glyph == glyph && entry->font == font && entry->color == color && entry->bg == bg){
+            hit = entry;
+            break;
+        }
+    }
+
+    if(hit){
+        ili9488_glyph_stats.hits++;
+    }
+    else{
+        ili9488_glyph_stats.misses++;
+        hit = ILI9488_GlyphCache_Allocate(size);
+        hit->font = font;
+        hit->glyph = glyph;
+        hit->color = color;
+        hit->bg = bg;
+        hit->width = width;
+        hit->height = height;
+        ILI9488_RenderGlyph(font, glyph, color, bg, &ili9488_glyph_arena[hit->offset]);
+    }
+    hit->last_use = ++ili9488_glyph_clock;
+
+    ILI9488_SetWindow(x, y, hit->width, hit->height);
+    ILI9488_WriteBus(&ili9488_glyph_arena[hit->offset], hit->size);
+    return glyph->advance;
+}
+
+/**
+ * @brief Draw a character through the cache
+ * @param x Left edge of the cell
+ * @param y Top edge of the cell
+ * @param font Font blob
+ * @param codepoint Unicode code point
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Horizontal advance in pixels, 0 if the font has no such glyph
+ */
+uint16_t ILI9488_DrawCharCached(uint16_t x, uint16_t y, const void *font, uint32_t codepoint,
+                                uint32_t color, uint32_t bg){
+    const ILI9488_FontGlyph_t *glyph = ILI9488_FontGlyph(font, codepoint);
+    if(glyph == NULL) return 0;
+    return ILI9488_DrawGlyphCached(x, y, font, glyph, color, bg);
+}
+
+/**
+ * @brief Draw a single line of text through the cache
+ * @param x Left edge of the first cell
+ * @param y Top edge of the line
+ * @param font Font blob
+ * @param text Null-terminated text, one byte per code point (ASCII or Latin-1)
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Width of the text in pixels
+ */
+uint16_t ILI9488_DrawTextCached(uint16_t x, uint16_t y, const void *font, const char *text,
+                                uint32_t color, uint32_t bg){
+    const ILI9488_FontGlyph_t *previous = NULL;
+    int32_t pen = 0;
+
+    for(; *text; text++){
+        const ILI9488_FontGlyph_t *glyph = ILI9488_FontGlyph(font, (uint8_t)*text);
+        if(glyph == NULL) continue;
+        if(previous) pen += ILI9488_FontKerning(font, previous, glyph);
+        if(pen < 0) pen = 0;
+        ILI9488_DrawGlyphCached((uint16_t)(x + pen), y, font, glyph, color, bg);
+        pen += glyph->advance;
+        previous = glyph;
+    }
+    return (uint16_t)pen;
+}
+
+/**
+ * @brief Get the cache counters
+ * @param stats Output
+ */
+void ILI9488_GlyphCacheStats(ILI9488_GlyphCacheStats_t *stats){
+    *stats = ili9488_glyph_stats;
+    stats->words_used = ili9488_glyph_used;
+}
+
+/**
+ * @brief Drop all cached glyphs and reset the counters
+ */
+void ILI9488_ClearGlyphCache(void){
+    memset(ili9488_glyph_entry, 0, sizeof(ili9488_glyph_entry));
+    memset(&ili9488_glyph_stats, 0, sizeof(ili9488_glyph_stats));
+    ili9488_glyph_top = 0;
+    ili9488_glyph_used = 0;
+    ili9488_glyph_clock = 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file ili9488_glyphcache.h
+ * @brief ILI9488 glyph cache
+ * @details This header file contains the declarations for a RAM cache of
+ *          glyph cells already expanded into bus words for one text and
+ *          background color. A cached glyph is drawn with one address window
+ *          and a straight memory-to-bus copy, with no run decoding or alpha
+ *          blending. The cache lives in a fixed arena; the least recently
+ *          used glyphs are dropped to make room. It pays off for text that
+ *          repeats the same few glyphs, such as numeric readouts.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_GLYPHCACHE_H
+#define __ILI9488_GLYPHCACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* For uint8_t, uint16_t, uint32_t */
+#include <stdint.h>
+#include "ili9488_font.h"
+
+/* Arena size in bus words (4 bytes each) */
+#ifndef ILI9488_GLYPH_CACHE_WORDS
+#define ILI9488_GLYPH_CACHE_WORDS    4096
+#endif
+
+/* Most glyphs held at once */
+#ifndef ILI9488_GLYPH_CACHE_ENTRIES
+#define ILI9488_GLYPH_CACHE_ENTRIES  48
+#endif
+
+/**
+ * @brief Cache counters, for tuning the arena size
+ */
+typedef struct {
+    uint32_t hits;        ///< Glyphs drawn from the cache
+    uint32_t misses;      ///< Glyphs expanded into the cache
+    uint32_t evictions;   ///< Glyphs dropped to make room
+    uint32_t uncached;    ///< Glyphs drawn directly (cell larger than the arena, or clipped)
+    uint32_t words_used;  ///< Arena words holding glyphs now
+} ILI9488_GlyphCacheStats_t;
+
+/**
+ * @brief Draw one glyph cell through the cache
+ * @param x Left edge of the cell
+ * @param y Top edge of the cell
+ * @param font Font blob
+ * @param glyph Glyph from ILI9488_FontGlyph()
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Horizontal advance in pixels
+ * @details Cells that do not fit on the screen are drawn directly with
+ *          ILI9488_DrawGlyph().
+ */
+uint16_t ILI9488_DrawGlyphCached(uint16_t x, uint16_t y, const void *font, const ILI9488_FontGlyph_t *glyph,
+                                 uint32_t color, uint32_t bg);
+
+/**
+ * @brief Draw a character through the cache
+ * @param x Left edge of the cell
+ * @param y Top edge of the cell
+ * @param font Font blob
+ * @param codepoint Unicode code point
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Horizontal advance in pixels, 0 if the font has no such glyph
+ */
+uint16_t ILI9488_DrawCharCached(uint16_t x, uint16_t y, const void *font, uint32_t codepoint,
+                                uint32_t color, uint32_t bg);
+
+/**
+ * @brief Draw a single line of text through the cache
+ * @param x Left edge of the first cell
+ * @param y Top edge of the line
+ * @param font Font blob
+ * @param text Null-terminated text, one byte per code point (ASCII or Latin-1)
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Width of the text in pixels
+ * @details Cells are kerned and painted one after another, so ink reaching
+ *          into the next cell is covered by that cell's background.
+ */
+uint16_t ILI9488_DrawTextCached(uint16_t x, uint16_t y, const void *font, const char *text,
+                                uint32_t color, uint32_t bg);
+
+/**
+ * @brief Get the cache counters
+ * @param stats Output
+ */
+void ILI9488_GlyphCacheStats(ILI9488_GlyphCacheStats_t *stats);
+
+/**
+ * @brief Drop all cached glyphs and reset the counters
+ */
+void ILI9488_ClearGlyphCache(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ILI9488_GLYPHCACHE_H */
@@ -0,0 +1,173 @@
+/**
+ * @file ili9488_image.c
+ * @brief ILI9488 bus-ready image formats
+ * @details This file contains the decoders for images converted offline.
+ *          Bus word formats are streamed as they are stored; RLE runs map
+ *          onto repeated WR strobes; indexed and RGB565 images only need a
+ *          table lookup or a few shifts per pixel; transparent sprites open
+ *          one window per opaque run, so transparent pixels cost nothing.
+ *          Decoding is incremental: the pixel data may arrive in any number
+ *          of word-aligned chunks, which lets streamed images share the same
+ *          decoders as images in memory.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include "ili9488_image.h"
+
+/* Pixels converted per burst for the formats that need a lookup */
+#define IMAGE_CHUNK  64
+
+/**
+ * @brief Convert an RGB565 value to an 18-bit bus word
+ * @details The 5-bit channels get their top bit repeated into bit 0.
+ */
+static inline uint32_t ILI9488_Image_565ToBus(uint16_t c){
+    uint32_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+    return ((r << 1 | r >> 4) << 12) | (g << 6) | (b << 1 | b >> 4);
+}
+
+/**
+ * @brief Start decoding an image
+ * @param decoder Decoder state to initialize
+ * @param x Left edge of the image
+ * @param y Top edge of the image
+ * @param header Image header
+ * @param palette Palette of header->palette_count bus words (may be NULL if empty)
+ * @return 1 if the format is supported, 0 otherwise
+ * @details All formats except sprites open their single address window here.
+ */
+uint8_t ILI9488_ImageBegin(ILI9488_ImageDecoder_t *decoder, uint16_t x, uint16_t y,
+                           const ILI9488_ImageHeader_t *header, const uint32_t *palette){
+    if(header->format > ILI9488_IMAGE_SPRITE) return 0;
+
+    decoder->x = x;
+    decoder->y = y;
+    decoder->format = header->format;
+    decoder->palette = palette;
+    decoder->row = 0;
+    decoder->runs = 0;
+    decoder->pending = 0;
+    decoder->started = 0;
+
+    if(header->format != ILI9488_IMAGE_SPRITE && header->width && header->height){
+        ILI9488_SetWindow(x, y, header->width, header->height);
+        decoder->pending = (uint32_t)header->width * header->height;
+    }
+    return 1;
+}
+
+/**
+ * @brief Decode the next chunk of pixel data
+ * @param decoder Decoder state from ILI9488_ImageBegin()
+ * @param data Next bytes of pixel data (4-byte aligned)
+ * @param size Number of bytes (a multiple of 4, except at the end of the data)
+ * @details When a window is still being filled from an earlier chunk, the
+ *          memory write is resumed with ILI9488_WriteContinue() first.
+ */
+ILI9488_FAST void ILI9488_ImagePush(ILI9488_ImageDecoder_t *decoder, const void *data, uint32_t size){
+    uint32_t chunk[IMAGE_CHUNK];
+
+    if(decoder->started && decoder->pending) ILI9488_WriteContinue();
+    decoder->started = 1;
+
+    switch(decoder->format){
+        case ILI9488_IMAGE_BUS666: {
+            uint32_t n = size / 4;
+            if(n > decoder->pending) n = decoder->pending;
+            ILI9488_WriteBus((const uint32_t *)data, n);
+            decoder->pending -= n;
+            break;
+        }
+
+        case ILI9488_IMAGE_RGB565: {
+            const uint16_t *src = (const uint16_t *)data;
+            uint32_t count = size / 2;
+            if(count > decoder->pending) count = decoder->pending;
+            decoder->pending -= count;
+            while(count){
+                uint32_t n = count < IMAGE_CHUNK ? count : IMAGE_CHUNK;
+                for(uint32_t i = 0; i < n; i++) chunk[i] = ILI9488_Image_565ToBus(*src++);
+                ILI9488_WriteBus(chunk, n);
+                count -= n;
+            }
+            break;
+        }
+
+        case ILI9488_IMAGE_INDEXED8: {
+            const uint8_t *src = (const uint8_t *)data;
+            uint32_t count = size;
+            if(count > decoder->pending) count = decoder->pending;
+            decoder->pending -= count;
+            while(count){
+                uint32_t n = count < IMAGE_CHUNK ? count : IMAGE_CHUNK;
+                for(uint32_t i = 0; i < n; i++) chunk[i] = decoder->palette[*src++];
+                ILI9488_WriteBus(chunk, n);
+                count -= n;
+            }
+            break;
+        }
+
+        case ILI9488_IMAGE_RLE: {
+            const uint32_t *token = (const uint32_t *)data;
+            const uint32_t *end = token + size / 4;
+            for(; token < end && decoder->pending; token++){
+                uint32_t run = *token >> 18;
+                if(run > decoder->pending) run = decoder->pending;
+                ILI9488_WriteBusRun(*token & 0x3FFFF, run);
+                decoder->pending -= run;
+            }
+            break;
+        }
+
+        default: { /* ILI9488_IMAGE_SPRITE */
+            const uint32_t *p = (const uint32_t *)data;
+            const uint32_t *end = p + size / 4;
+            while(p < end){
+                if(decoder->pending){
+                    /* Pixels of the open run */
+                    uint32_t n = (uint32_t)(end - p);
+                    if(n > decoder->pending) n = decoder->pending;
+                    ILI9488_WriteBus(p, n);
+                    decoder->pending -= n;
+                    p += n;
+                }
+                else if(decoder->runs == 0){
+                    /* Run count of the next row */
+                    decoder->runs = *p++;
+                    decoder->row++;
+                }
+                else{
+                    /* Run header: x << 16 | length, on row (decoder->row - 1) */
+                    uint16_t rx = (uint16_t)(*p >> 16), len = (uint16_t)(*p & 0xFFFF);
+                    p++;
+                    decoder->runs--;
+                    if(len == 0) continue;
+                    ILI9488_SetWindow(decoder->x + rx, decoder->y + decoder->row - 1, len, 1);
+                    decoder->pending = len;
+                }
+            }
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Draw an image blob on the display
+ * @param x Left edge of the image
+ * @param y Top edge of the image
+ * @param image Image blob (4-byte aligned)
+ * @details The pixel data is decoded in place in a single push, so bus word
+ *          images go from memory to the data lines without a copy. Formats
+ *          that need conversion go through a small stack buffer so the bus
+ *          still sees bursts.
+ */
+void ILI9488_DrawImage(uint16_t x, uint16_t y, const void *image){
+    const ILI9488_ImageHeader_t *header = (const ILI9488_ImageHeader_t *)image;
+    const uint32_t *palette = (const uint32_t *)(header + 1);
+    ILI9488_ImageDecoder_t decoder;
+
+    if(!ILI9488_ImageBegin(&decoder, x, y, header, palette)) return;
+    ILI9488_ImagePush(&decoder, palette + header->palette_count, header->data_size);
+}
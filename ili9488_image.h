@@ -0,0 +1,102 @@
+/**
+ * @file ili9488_image.h
+ * @brief ILI9488 bus-ready image formats
+ * @details This header file contains the declarations for images converted
+ *          offline by tools/ili9488_pack.c. An image is one contiguous,
+ *          4-byte aligned blob: a header, an optional palette of bus words
+ *          and the pixel data. The same blob can live in a C array in flash
+ *          or inside an asset pack, and is drawn in place without copying.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_IMAGE_H
+#define __ILI9488_IMAGE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* For uint8_t, uint16_t, uint32_t */
+#include <stdint.h>
+#include "ili9488.h"
+
+/* Largest run length of an RLE token */
+#define ILI9488_IMAGE_RLE_MAX_RUN  0x3FFF
+
+/* Image pixel formats */
+typedef enum {
+    ILI9488_IMAGE_BUS666 = 0,   ///< One 18-bit bus word (uint32_t) per pixel
+    ILI9488_IMAGE_RGB565 = 1,   ///< One RGB565 value (uint16_t) per pixel
+    ILI9488_IMAGE_INDEXED8 = 2, ///< One palette index (uint8_t) per pixel
+    ILI9488_IMAGE_RLE = 3,      ///< uint32_t tokens: run length << 18 | bus word
+    ILI9488_IMAGE_SPRITE = 4    ///< Per-row opaque run tables followed by bus words
+} ILI9488_ImageFormat_t;
+
+/**
+ * @brief Image blob header
+ * @details Followed by palette_count bus words (uint32_t), then data_size
+ *          bytes of pixel data. Sprite data holds, for every row, a uint32_t
+ *          run count, then for each run a uint32_t (x << 16 | length) and
+ *          length bus words. All fields are little-endian.
+ */
+typedef struct {
+    uint16_t width;          ///< Image width in pixels
+    uint16_t height;         ///< Image height in pixels
+    uint8_t format;          ///< Pixel format (ILI9488_ImageFormat_t)
+    uint8_t reserved;        ///< Always 0
+    uint16_t palette_count;  ///< Number of palette entries
+    uint32_t data_size;      ///< Pixel data size in bytes
+} ILI9488_ImageHeader_t;
+
+/**
+ * @brief Incremental image decoder state
+ * @details Filled by ILI9488_ImageBegin(); the fields are internal.
+ */
+typedef struct {
+    uint16_t x;               ///< Left edge of the image
+    uint16_t y;               ///< Top edge of the image
+    uint8_t format;           ///< Pixel format (ILI9488_ImageFormat_t)
+    uint8_t started;          ///< Set once the first chunk was pushed
+    uint16_t row;             ///< Sprites: rows started so far
+    uint32_t runs;            ///< Sprites: runs left in the current row
+    uint32_t pending;         ///< Pixels left in the open address window
+    const uint32_t *palette;  ///< Palette of bus words
+} ILI9488_ImageDecoder_t;
+
+/**
+ * @brief Start decoding an image
+ * @param decoder Decoder state to initialize
+ * @param x Left edge of the image
+ * @param y Top edge of the image
+ * @param header Image header
+ * @param palette Palette of header->palette_count bus words (may be NULL if empty)
+ * @return 1 if the format is supported, 0 otherwise
+ * @details The palette must stay valid until the image is fully decoded.
+ */
+uint8_t ILI9488_ImageBegin(ILI9488_ImageDecoder_t *decoder, uint16_t x, uint16_t y,
+                           const ILI9488_ImageHeader_t *header, const uint32_t *palette);
+
+/**
+ * @brief Decode the next chunk of pixel data
+ * @param decoder Decoder state from ILI9488_ImageBegin()
+ * @param data Next bytes of pixel data (4-byte aligned)
+ * @param size Number of bytes (a multiple of 4, except at the end of the data)
+ */
+void ILI9488_ImagePush(ILI9488_ImageDecoder_t *decoder, const void *data, uint32_t size);
+
+/**
+ * @brief Draw an image blob on the display
+ * @param x Left edge of the image
+ * @param y Top edge of the image
+ * @param image Image blob (4-byte aligned)
+ * @details The image must fit on the screen.
+ */
+void ILI9488_DrawImage(uint16_t x, uint16_t y, const void *image);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ILI9488_IMAGE_H */
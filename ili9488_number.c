@@ -0,0 +1,263 @@
+/**
+ * @file ili9488_number.c
+ * @brief ILI9488 numeric rendering
+ * @details This file contains the implementation of numeric rendering. Every
+ *          call collects the glyphs of the number (sign, digits, point) with
+ *          their kerned pen positions, then hands them to
+ *          ILI9488_DrawGlyphLine(). A decimal digit is found by subtracting
+ *          its power of ten at most nine times, which is cheaper than a
+ *          division on cores without a hardware divider.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <stddef.h>
+#include "ili9488_number.h"
+
+/* Sign, 10 integer digits, point and 9 decimals */
+#define ILI9488_NUMBER_GLYPHS  21
+
+/* Largest number of decimals */
+#define ILI9488_NUMBER_DECIMALS  9
+
+/* Powers of ten up to 10^9 */
+static const uint32_t ili9488_number_pow10[10] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+};
+
+/**
+ * @brief Number being built
+ */
+typedef struct {
+    const void *font;                                             ///< Font
+    const ILI9488_FontGlyph_t *glyphs[ILI9488_NUMBER_GLYPHS];     ///< Glyphs
+    int16_t positions[ILI9488_NUMBER_GLYPHS];                     ///< Pen position of every glyph
+    uint16_t count;                                               ///< Number of glyphs
+    int32_t pen;                                                  ///< Pen after the last glyph
+    int32_t extent;                                               ///< Right edge of the widest cell
+} ILI9488_Number_t;
+
+/**
+ * @brief Append a character
+ */
+static void ILI9488_Number_Put(ILI9488_Number_t *number, char c){
+    const ILI9488_FontGlyph_t *glyph = ILI9488_FontGlyph(number->font, (uint8_t)c);
+    if(glyph == NULL || number->count == ILI9488_NUMBER_GLYPHS) return;
+    if(number->count) number->pen += ILI9488_FontKerning(number->font, number->glyphs[number->count - 1], glyph);
+    if(number->pen < 0) number->pen = 0;
+    number->glyphs[number->count] = glyph;
+    number->positions[number->count++] = (int16_t)number->pen;
+    if(number->pen + (int32_t)ILI9488_GlyphCellWidth(glyph) > number->extent){
+        number->extent = number->pen + ILI9488_GlyphCellWidth(glyph);
+    }
+    number->pen += glyph->advance;
+}
+
+/**
+ * @brief Append exactly count decimal digits of a value
+ * @param number Number
+ * @param value Value below 10^count (or any value for count 10)
+ * @param count Number of digits (1 to 10)
+ */
+static void ILI9488_Number_Digits(ILI9488_Number_t *number, uint32_t value, uint8_t count){
+    while(count-- > 0){
+        uint32_t power = ili9488_number_pow10[count];
+        char digit = '0';
+        while(value >= power){
+            value -= power;
+            digit++;
+        }
+        ILI9488_Number_Put(number, digit);
+    }
+}
+
+/**
+ * @brief Append the integer part of a number
+ * @param number Number
+ * @param value Magnitude
+ * @param digits Minimum number of digits
+ */
+static void ILI9488_Number_Integer(ILI9488_Number_t *number, uint32_t value, uint8_t digits){
+    uint8_t count = 1;
+    while(count < 10 && value >= ili9488_number_pow10[count]) count++;
+    if(digits > 10) digits = 10;
+    ILI9488_Number_Digits(number, value, count > digits ? count : digits);
+}
+
+/**
+ * @brief Start a number with its sign
+ */
+static void ILI9488_Number_Begin(ILI9488_Number_t *number, const void *font, uint8_t negative,
+                                 const ILI9488_NumberFormat_t *format){
+    number->font = font;
+    number->count = 0;
+    number->pen = 0;
+    number->extent = 0;
+    if(negative) ILI9488_Number_Put(number, '-');
+    else if(format && format->plus) ILI9488_Number_Put(number, '+');
+}
+
+/**
+ * @brief Append the decimal part of a number
+ * @param number Number
+ * @param fraction Decimal part, below 10^decimals
+ * @param decimals Number of decimals
+ */
+static void ILI9488_Number_Decimals(ILI9488_Number_t *number, uint32_t fraction, uint8_t decimals){
+    if(decimals == 0) return;
+    ILI9488_Number_Put(number, '.');
+    ILI9488_Number_Digits(number, fraction, decimals);
+}
+
+/**
+ * @brief Paint a number in its field
+ * @return Width drawn in pixels
+ */
+static uint16_t ILI9488_Number_Draw(uint16_t x, uint16_t y, ILI9488_Number_t *number,
+                                    const ILI9488_NumberFormat_t *format, uint32_t color, uint32_t bg){
+    int32_t width = number->extent > number->pen ? number->extent : number->pen;
+    int32_t shift = 0;
+
+    if(format && format->width){
+        if(format->align == ILI9488_ALIGN_RIGHT) shift = format->width - number->pen;
+        else if(format->align == ILI9488_ALIGN_CENTER) shift = (format->width - number->pen) / 2;
+        if(shift < 0) shift = 0;
+        width = format->width;
+    }
+    if(shift){
+        for(uint16_t i = 0; i < number->count; i++){
+            number->positions[i] = (int16_t)(number->positions[i] + shift);
+        }
+    }
+    ILI9488_DrawGlyphLine(x, y, (uint16_t)width, number->font, number->glyphs, number->positions, number->count,
+                          color, bg);
+    return (uint16_t)width;
+}
+
+/**
+ * @brief Draw an integer
+ * @param x Left edge of the field
+ * @param y Top edge of the field
+ * @param font Font blob
+ * @param value Value
+ * @param format Number format, or NULL
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Width drawn in pixels
+ */
+uint16_t ILI9488_DrawInt(uint16_t x, uint16_t y, const void *font, int32_t value,
+                         const ILI9488_NumberFormat_t *format, uint32_t color, uint32_t bg){
+    ILI9488_Number_t number;
+    uint32_t magnitude = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+
+    ILI9488_Number_Begin(&number, font, value < 0, format);
+    ILI9488_Number_Integer(&number, magnitude, format ? format->digits : 0);
+    return ILI9488_Number_Draw(x, y, &number, format, color, bg);
+}
+
+/**
+ * @brief Draw a fixed-point value
+ * @param x Left edge of the field
+ * @param y Top edge of the field
+ * @param font Font blob
+ * @param value Value with frac_bits fractional bits (for example Q16.16)
+ * @param frac_bits Number of fractional bits (0 to 31)
+ * @param decimals Digits after the decimal point (0 to 9), rounded half away from zero
+ * @param format Number format, or NULL
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Width drawn in pixels
+ */
+uint16_t ILI9488_DrawFixed(uint16_t x, uint16_t y, const void *font, int32_t value, uint8_t frac_bits,
+                           uint8_t decimals, const ILI9488_NumberFormat_t *format, uint32_t color, uint32_t bg){
+    ILI9488_Number_t number;
+    uint32_t magnitude = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+    uint32_t integer, fraction;
+
+    if(frac_bits > 31) frac_bits = 31;
+    if(decimals > ILI9488_NUMBER_DECIMALS) decimals = ILI9488_NUMBER_DECIMALS;
+    integer = magnitude >> frac_bits;
+    fraction = magnitude & ((1u << frac_bits) - 1);
+
+    /* Scale the fraction to the decimals with rounding; a carry goes to the integer part */
+    uint64_t scaled = (uint64_t)fraction * ili9488_number_pow10[decimals];
+    if(frac_bits) scaled = (scaled + (1u << (frac_bits - 1))) >> frac_bits;
+    if(scaled >= ili9488_number_pow10[decimals]){
+        scaled -= ili9488_number_pow10[decimals];
+        integer++;
+    }
+
+    ILI9488_Number_Begin(&number, font, value < 0 && (integer || scaled), format);
+    ILI9488_Number_Integer(&number, integer, format ? format->digits : 0);
+    ILI9488_Number_Decimals(&number, (uint32_t)scaled, decimals);
+    return ILI9488_Number_Draw(x, y, &number, format, color, bg);
+}
+
+/**
+ * @brief Draw a floating-point value
+ * @param x Left edge of the field
+ * @param y Top edge of the field
+ * @param font Font blob
+ * @param value Value
+ * @param decimals Digits after the decimal point (0 to 9), rounded half away from zero
+ * @param format Number format, or NULL
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Width drawn in pixels
+ */
+uint16_t ILI9488_DrawFloat(uint16_t x, uint16_t y, const void *font, float value, uint8_t decimals,
+                           const ILI9488_NumberFormat_t *format, uint32_t color, uint32_t bg){
+    ILI9488_Number_t number;
+    uint8_t negative = value < 0.0f;
+    float magnitude = negative ? -value : value;
+
+    if(decimals > ILI9488_NUMBER_DECIMALS) decimals = ILI9488_NUMBER_DECIMALS;
+    if(!(magnitude < 4294967040.0f)){
+        /* NaN, infinity or too large for the integer part */
+        ILI9488_Number_Begin(&number, font, 0, NULL);
+        for(uint8_t i = 0; i < 3; i++) ILI9488_Number_Put(&number, '-');
+        return ILI9488_Number_Draw(x, y, &number, format, color, bg);
+    }
+
+    uint32_t integer = (uint32_t)magnitude;
+    float fraction = (magnitude - (float)integer) * (float)ili9488_number_pow10[decimals] + 0.5f;
+    uint32_t scaled = (uint32_t)fraction;
+    if(scaled >= ili9488_number_pow10[decimals]){
+        scaled -= ili9488_number_pow10[decimals];
+        integer++;
+    }
+
+    ILI9488_Number_Begin(&number, font, negative && (integer || scaled), format);
+    ILI9488_Number_Integer(&number, integer, format ? format->digits : 0);
+    ILI9488_Number_Decimals(&number, scaled, decimals);
+    return ILI9488_Number_Draw(x, y, &number, format, color, bg);
+}
+
+/**
+ * @brief Draw a hexadecimal number
+ * @param x Left edge of the field
+ * @param y Top edge of the field
+ * @param font Font blob
+ * @param value Value
+ * @param format Number format, or NULL (digits sets the minimum number of hex digits)
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Width drawn in pixels
+ */
+uint16_t ILI9488_DrawHex(uint16_t x, uint16_t y, const void *font, uint32_t value,
+                         const ILI9488_NumberFormat_t *format, uint32_t color, uint32_t bg){
+    static const char hex[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+    ILI9488_Number_t number;
+    uint8_t count = 1, digits = format ? format->digits : 0;
+
+    while(count < 8 && (value >> (count * 4))) count++;
+    if(digits > 8) digits = 8;
+    if(digits > count) count = digits;
+
+    ILI9488_Number_Begin(&number, font, 0, NULL);
+    while(count-- > 0){
+        ILI9488_Number_Put(&number, hex[(value >> (count * 4)) & 0x0F]);
+    }
+    return ILI9488_Number_Draw(x, y, &number, format, color, bg);
+}
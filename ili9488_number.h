@@ -0,0 +1,104 @@
+/**
+ * @file ili9488_number.h
+ * @brief ILI9488 numeric rendering
+ * @details This header file contains the declarations for drawing integers,
+ *          fixed-point and floating-point values and hex numbers without
+ *          formatting them into a string first. Digits are extracted with a
+ *          power-of-ten table (no division), turned into glyphs of the fonts
+ *          of ili9488_font.h and painted in one address window as wide as the
+ *          field, so padding and alignment come from the background fill.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_NUMBER_H
+#define __ILI9488_NUMBER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* For uint8_t, uint16_t, uint32_t */
+#include <stdint.h>
+#include "ili9488_font.h"
+#include "ili9488_text.h"
+
+/**
+ * @brief Number format
+ * @details A NULL format draws the number as narrow as it is, left aligned.
+ */
+typedef struct {
+    uint16_t width;          ///< Field width in pixels, 0 to fit the number
+    ILI9488_Align_t align;   ///< Position of the number in the field
+    uint8_t digits;          ///< Minimum number of integer digits, padded with zeros (up to 10)
+    uint8_t plus;            ///< 1 to show '+' on positive values
+} ILI9488_NumberFormat_t;
+
+/**
+ * @brief Draw an integer
+ * @param x Left edge of the field
+ * @param y Top edge of the field
+ * @param font Font blob
+ * @param value Value
+ * @param format Number format, or NULL
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Width drawn in pixels
+ */
+uint16_t ILI9488_DrawInt(uint16_t x, uint16_t y, const void *font, int32_t value,
+                         const ILI9488_NumberFormat_t *format, uint32_t color, uint32_t bg);
+
+/**
+ * @brief Draw a fixed-point value
+ * @param x Left edge of the field
+ * @param y Top edge of the field
+ * @param font Font blob
+ * @param value Value with frac_bits fractional bits (for example Q16.16)
+ * @param frac_bits Number of fractional bits (0 to 31)
+ * @param decimals Digits after the decimal point (0 to 9), rounded half away from zero
+ * @param format Number format, or NULL
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Width drawn in pixels
+ */
+uint16_t ILI9488_DrawFixed(uint16_t x, uint16_t y, const void *font, int32_t value, uint8_t frac_bits,
+                           uint8_t decimals, const ILI9488_NumberFormat_t *format, uint32_t color, uint32_t bg);
+
+/**
+ * @brief Draw a floating-point value
+ * @param x Left edge of the field
+ * @param y Top edge of the field
+ * @param font Font blob
+ * @param value Value
+ * @param decimals Digits after the decimal point (0 to 9), rounded half away from zero
+ * @param format Number format, or NULL
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Width drawn in pixels
+ * @details NaN and values whose integer part does not fit in 32 bits are
+ *          drawn as "---".
+ */
+uint16_t ILI9488_DrawFloat(uint16_t x, uint16_t y, const void *font, float value, uint8_t decimals,
+                           const ILI9488_NumberFormat_t *format, uint32_t color, uint32_t bg);
+
+/**
+ * @brief Draw a hexadecimal number
+ * @param x Left edge of the field
+ * @param y Top edge of the field
+ * @param font Font blob
+ * @param value Value
+ * @param format Number format, or NULL (digits sets the minimum number of hex digits)
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Width drawn in pixels
+ * @details Uses the upper case digits A to F.
+ */
+uint16_t ILI9488_DrawHex(uint16_t x, uint16_t y, const void *font, uint32_t value,
+                         const ILI9488_NumberFormat_t *format, uint32_t color, uint32_t bg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ILI9488_NUMBER_H */
@@ -0,0 +1,56 @@
+/**
+ * @file ili9488_scale.h
+ * @brief ILI9488 scaled bitmap blits
+ * @details This header file contains the declarations for drawing bitmaps
+ *          at a different size than they are stored, with nearest-neighbour
+ *          or bilinear filtering. Output is streamed row by row into a single
+ *          address window, without a full-size intermediate buffer.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_SCALE_H
+#define __ILI9488_SCALE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* For uint8_t, uint16_t, uint32_t */
+#include <stdint.h>
+#include "ili9488.h"
+
+/**
+ * @brief Draw a bitmap scaled to a destination size
+ * @param x Left edge of the destination (may be off-screen)
+ * @param y Top edge of the destination (may be off-screen)
+ * @param dw Destination width
+ * @param dh Destination height
+ * @param pixels Source bitmap, sw * sh RGB666 colors, row by row
+ * @param sw Source width (1 to 2048)
+ * @param sh Source height (1 to 2048)
+ * @param filter Sampling filter
+ */
+void ILI9488_DrawBitmapScaled(int16_t x, int16_t y, uint16_t dw, uint16_t dh,
+                              const uint32_t *pixels, uint16_t sw, uint16_t sh, ILI9488_Filter_t filter);
+
+/**
+ * @brief Draw a bitmap enlarged by an integer factor
+ * @param x Left edge of the destination (may be off-screen)
+ * @param y Top edge of the destination (may be off-screen)
+ * @param pixels Source bitmap, sw * sh RGB666 colors, row by row
+ * @param sw Source width
+ * @param sh Source height
+ * @param factor Enlargement factor (1 or more)
+ * @details Every source pixel becomes a factor x factor block. Horizontal
+ *          repeats are sent as repeated WR strobes of one latched color.
+ *          Nothing is drawn if sw * factor or sh * factor exceeds 65535.
+ */
+void ILI9488_DrawBitmapZoom(int16_t x, int16_t y, const uint32_t *pixels, uint16_t sw, uint16_t sh, uint8_t factor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ILI9488_SCALE_H */
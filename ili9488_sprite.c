@@ -0,0 +1,221 @@
+/**
+ * @file ili9488_sprite.c
+ * @brief ILI9488 sprite engine with dirty region compositing
+ * @details This file contains the implementation of the sprite engine. For
+ *          every sprite that changed, the rectangle it occupied and the one
+ *          it now occupies are collected as dirty regions. Overlapping
+ *          regions are merged, then each region is composed (background,
+ *          then sprites in registration order) strip by strip in a scratch
+ *          buffer and streamed through one address window.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include "ili9488_sprite.h"
+
+#if ILI9488_SPRITE_SCRATCH_PIXELS < ILI9488_LANDSCAPE_WIDTH
+#error "ILI9488_SPRITE_SCRATCH_PIXELS must hold at least one full display row"
+#endif
+
+/* Up to two dirty regions per sprite (old and new bounds) */
+#define SPRITE_MAX_REGIONS  (ILI9488_SPRITE_MAX * 2)
+
+/**
+ * @brief Screen rectangle with exclusive right and bottom edges
+ */
+typedef struct {
+    int16_t x0;
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+} ILI9488_SpriteRect_t;
+
+static ILI9488_Sprite_t *ili9488_sprites[ILI9488_SPRITE_MAX];
+static uint8_t ili9488_sprite_count;
+static ILI9488_Background_t ili9488_sprite_background;
+static uint32_t ili9488_sprite_scratch[ILI9488_SPRITE_SCRATCH_PIXELS];
+
+/**
+ * @brief Initialize the sprite engine
+ * @param background Callback rendering the static background
+ */
+void ILI9488_SpriteInit(ILI9488_Background_t background){
+    ili9488_sprite_background = background;
+    ili9488_sprite_count = 0;
+}
+
+/**
+ * @brief Register a sprite
+ * @param sprite Sprite to register (drawn above previously added sprites)
+ * @return 1 on success, 0 if ILI9488_SPRITE_MAX sprites are registered
+ * @details The sprite is drawn on the next update if it is visible.
+ */
+uint8_t ILI9488_AddSprite(ILI9488_Sprite_t *sprite){
+    if(ili9488_sprite_count >= ILI9488_SPRITE_MAX) return 0;
+    if(sprite->frames == 0) sprite->frames = 1;
+    sprite->drawn = 0;
+    sprite->dirty = 1;
+    ili9488_sprites[ili9488_sprite_count++] = sprite;
+    return 1;
+}
+
+/**
+ * @brief Move a sprite
+ * @param sprite Registered sprite
+ * @param x New left edge
+ * @param y New top edge
+ */
+void ILI9488_MoveSprite(ILI9488_Sprite_t *sprite, int16_t x, int16_t y){
+    if(sprite->x == x && sprite->y == y) return;
+    sprite->x = x;
+    sprite->y = y;
+    sprite->dirty = 1;
+}
+
+/**
+ * @brief Select the animation frame of a sprite
+ * @param sprite Registered sprite
+ * @param frame Frame index (wraps around the number of frames)
+ */
+void ILI9488_SetSpriteFrame(ILI9488_Sprite_t *sprite, uint16_t frame){
+    frame %= sprite->frames;
+    if(sprite->frame == frame) return;
+    sprite->frame = frame;
+    sprite->dirty = 1;
+}
+
+/**
+ * @brief Show or hide a sprite
+ * @param sprite Registered sprite
+ * @param visible 1 to show the sprite, 0 to hide it
+ */
+void ILI9488_ShowSprite(ILI9488_Sprite_t *sprite, uint8_t visible){
+    if(sprite->visible == visible) return;
+    sprite->visible = visible;
+    sprite->dirty = 1;
+}
+
+/**
+ * @brief Clip a rectangle to the display
+ * @param r Rectangle to clip
+ * @return 1 if some part of the rectangle is on screen, 0 otherwise
+ */
+static uint8_t ILI9488_Sprite_Clip(ILI9488_SpriteRect_t *r){
+    ILI9488_Rotation_t rotation = ILI9488_GetRotation();
+    uint8_t landscape = rotation == ILI9488_ROTATION_LANDSCAPE || rotation == ILI9488_ROTATION_LANDSCAPE_INV;
+    int16_t width = landscape ? ILI9488_LANDSCAPE_WIDTH : ILI9488_PORTRAIT_WIDTH;
+    int16_t height = landscape ? ILI9488_LANDSCAPE_HEIGHT : ILI9488_PORTRAIT_HEIGHT;
+    if(r->x0 < 0) r->x0 = 0;
+    if(r->y0 < 0) r->y0 = 0;
+    if(r->x1 > width) r->x1 = width;
+    if(r->y1 > height) r->y1 = height;
+    return r->x0 < r->x1 && r->y0 < r->y1;
+}
+
+/**
+ * @brief Check whether two rectangles overlap or touch
+ */
+static inline uint8_t ILI9488_Sprite_Touch(const ILI9488_SpriteRect_t *a, const ILI9488_SpriteRect_t *b){
+    return a->x0 <= b->x1 && b->x0 <= a->x1 && a->y0 <= b->y1 && b->y0 <= a->y1;
+}
+
+/**
+ * @brief Add a dirty region, merging it with the regions it touches
+ * @param regions Region list
+ * @param count Number of regions in the list
+ * @param r Region to add (already clipped)
+ * @details A merged region can grow into regions it did not touch before,
+ *          so merging repeats until the new region touches none of the
+ *          others. Regions never overlap afterwards, so no pixel is sent
+ *          twice in a frame.
+ */
+static void ILI9488_Sprite_AddRegion(ILI9488_SpriteRect_t *regions, uint8_t *count, ILI9488_SpriteRect_t r){
+    uint8_t merged = 1;
+    while(merged){
+        merged = 0;
+        for(uint8_t i = 0; i < *count; i++){
+            if(!ILI9488_Sprite_Touch(&regions[i], &r)) continue;
+            if(regions[i].x0 < r.x0) r.x0 = regions[i].x0;
+            if(regions[i].y0 < r.y0) r.y0 = regions[i].y0;
+            if(regions[i].x1 > r.x1) r.x1 = regions[i].x1;
+            if(regions[i].y1 > r.y1) r.y1 = regions[i].y1;
+            regions[i] = regions[--(*count)];
+            merged = 1;
+            break;
+        }
+    }
+    regions[(*count)++] = r;
+}
+
+/**
+ * @brief Compose one strip of a region into the scratch buffer
+ * @param r Strip rectangle
+ */
+static void ILI9488_Sprite_Compose(const ILI9488_SpriteRect_t *r){
+    uint16_t w = (uint16_t)(r->x1 - r->x0);
+    ili9488_sprite_background((uint16_t)r->x0, (uint16_t)r->y0, w, (uint16_t)(r->y1 - r->y0), ili9488_sprite_scratch);
+
+    for(uint8_t i = 0; i < ili9488_sprite_count; i++){
+        const ILI9488_Sprite_t *s = ili9488_sprites[i];
+        if(!s->visible) continue;
+        int16_t x0 = s->x > r->x0 ? s->x : r->x0;
+        int16_t y0 = s->y > r->y0 ? s->y : r->y0;
+        int16_t x1 = s->x + (int16_t)s->w < r->x1 ? s->x + (int16_t)s->w : r->x1;
+        int16_t y1 = s->y + (int16_t)s->h < r->y1 ? s->y + (int16_t)s->h : r->y1;
+        if(x0 >= x1 || y0 >= y1) continue;
+
+        const uint32_t *src = s->pixels + (uint32_t)s->frame * s->w * s->h;
+        for(int16_t y = y0; y < y1; y++){
+            const uint32_t *in = src + (uint32_t)(y - s->y) * s->w + (x0 - s->x);
+            uint32_t *out = ili9488_sprite_scratch + (uint32_t)(y - r->y0) * w + (x0 - r->x0);
+            for(int16_t x = x0; x < x1; x++, in++, out++){
+                if(*in != s->transparent) *out = *in;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Redraw every region changed since the last update
+ * @details Dirty regions are the old and new bounds of each changed sprite
+ *          (one rectangle when they touch). Each merged region is composed
+ *          in strips that fit the scratch buffer; the strips of a region
+ *          share one address window, so the window commands are sent once
+ *          per region no matter how many strips it needs.
+ */
+void ILI9488_UpdateSprites(void){
+    ILI9488_SpriteRect_t regions[SPRITE_MAX_REGIONS];
+    uint8_t count = 0;
+
+    if(ili9488_sprite_background == 0) return;
+
+    /* Collect dirty regions */
+    for(uint8_t i = 0; i < ili9488_sprite_count; i++){
+        ILI9488_Sprite_t *s = ili9488_sprites[i];
+        if(!s->dirty) continue;
+        ILI9488_SpriteRect_t old = {s->drawn_x, s->drawn_y, (int16_t)(s->drawn_x + s->w), (int16_t)(s->drawn_y + s->h)};
+        ILI9488_SpriteRect_t now = {s->x, s->y, (int16_t)(s->x + s->w), (int16_t)(s->y + s->h)};
+        uint8_t has_old = s->drawn && ILI9488_Sprite_Clip(&old);
+        uint8_t has_now = s->visible && ILI9488_Sprite_Clip(&now);
+        if(has_old) ILI9488_Sprite_AddRegion(regions, &count, old);
+        if(has_now) ILI9488_Sprite_AddRegion(regions, &count, now);
+        s->drawn_x = s->x;
+        s->drawn_y = s->y;
+        s->drawn = s->visible;
+        s->dirty = 0;
+    }
+
+    /* Compose and flush each region strip by strip */
+    for(uint8_t i = 0; i < count; i++){
+        ILI9488_SpriteRect_t *r = &regions[i];
+        uint16_t w = (uint16_t)(r->x1 - r->x0);
+        uint16_t rows = ILI9488_SPRITE_SCRATCH_PIXELS / w;
+        ILI9488_SetWindow((uint16_t)r->x0, (uint16_t)r->y0, w, (uint16_t)(r->y1 - r->y0));
+        for(int16_t y = r->y0; y < r->y1; y += rows){
+            ILI9488_SpriteRect_t strip = {r->x0, y, r->x1, (int16_t)(y + rows < r->y1 ? y + rows : r->y1)};
+            ILI9488_Sprite_Compose(&strip);
+            ILI9488_WritePixels(ili9488_sprite_scratch, (uint32_t)w * (uint16_t)(strip.y1 - strip.y0));
+        }
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ * @file ili9488_sprite.h
+ * @brief ILI9488 sprite engine with dirty region compositing
+ * @details This header file contains the declarations for animated sprites
+ *          drawn over a static background. Only the areas a sprite leaves or
+ *          enters are recomposed each frame, in a small scratch buffer, and
+ *          each area is flushed through a single address window.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_SPRITE_H
+#define __ILI9488_SPRITE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* For uint8_t, uint16_t, uint32_t */
+#include <stdint.h>
+#include "ili9488.h"
+
+/* Maximum number of registered sprites */
+#ifndef ILI9488_SPRITE_MAX
+#define ILI9488_SPRITE_MAX             32
+#endif
+
+/* Scratch buffer size in pixels (4 bytes each) used for compositing */
+#ifndef ILI9488_SPRITE_SCRATCH_PIXELS
+#define ILI9488_SPRITE_SCRATCH_PIXELS  2048
+#endif
+
+/**
+ * @brief Callback rendering the static background
+ * @param x Left edge of the region
+ * @param y Top edge of the region
+ * @param w Width of the region
+ * @param h Height of the region
+ * @param dst Output buffer of w * h RGB666 colors, row by row
+ */
+typedef void (*ILI9488_Background_t)(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint32_t *dst);
+
+/**
+ * @brief Sprite description and state
+ * @details The structure is owned by the application and registered with
+ *          ILI9488_AddSprite(). Fields marked as internal are managed by
+ *          the sprite engine.
+ */
+typedef struct {
+    const uint32_t *pixels;  ///< Animation frames, w * h RGB666 colors each
+    uint16_t w;              ///< Sprite width in pixels
+    uint16_t h;              ///< Sprite height in pixels
+    uint16_t frames;         ///< Number of animation frames
+    uint32_t transparent;    ///< Color key that is not drawn
+    int16_t x;               ///< Requested left edge (may be off-screen)
+    int16_t y;               ///< Requested top edge (may be off-screen)
+    uint16_t frame;          ///< Requested animation frame
+    uint8_t visible;         ///< Requested visibility
+    int16_t drawn_x;         ///< Internal: left edge currently on screen
+    int16_t drawn_y;         ///< Internal: top edge currently on screen
+    uint8_t drawn;           ///< Internal: sprite is currently on screen
+    uint8_t dirty;           ///< Internal: state changed since the last update
+} ILI9488_Sprite_t;
+
+/**
+ * @brief Initialize the sprite engine
+ * @param background Callback rendering the static background
+ * @details Removes all registered sprites. The background is assumed to be
+ *          on screen already.
+ */
+void ILI9488_SpriteInit(ILI9488_Background_t background);
+
+/**
+ * @brief Register a sprite
+ * @param sprite Sprite to register (drawn above previously added sprites)
+ * @return 1 on success, 0 if ILI9488_SPRITE_MAX sprites are registered
+ */
+uint8_t ILI9488_AddSprite(ILI9488_Sprite_t *sprite);
+
+/**
+ * @brief Move a sprite
+ * @param sprite Registered sprite
+ * @param x New left edge
+ * @param y New top edge
+ */
+void ILI9488_MoveSprite(ILI9488_Sprite_t *sprite, int16_t x, int16_t y);
+
+/**
+ * @brief Select the animation frame of a sprite
+ * @param sprite Registered sprite
+ * @param frame Frame index (wraps around the number of frames)
+ */
+void ILI9488_SetSpriteFrame(ILI9488_Sprite_t *sprite, uint16_t frame);
+
+/**
+ * @brief Show or hide a sprite
+ * @param sprite Registered sprite
+ * @param visible 1 to show the sprite, 0 to hide it
+ */
+void ILI9488_ShowSprite(ILI9488_Sprite_t *sprite, uint8_t visible);
+
+/**
+ * @brief Redraw every region changed since the last update
+ * @details Call once per frame, after moving sprites.
+ */
+void ILI9488_UpdateSprites(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ILI9488_SPRITE_H */
@@ -0,0 +1,127 @@
+/**
+ * @file ili9488_stream.c
+ * @brief ILI9488 streamed images
+ * @details This file contains the implementation of streamed images. The
+ *          pixel data is read in ILI9488_STREAM_CHUNK sized chunks into two
+ *          buffers. The read of chunk N+1 is started before chunk N is handed
+ *          to the image decoder, which resumes the panel's memory write with
+ *          Memory Write Continue between chunks. With a blocking reader the
+ *          two simply alternate.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <stddef.h>
+#include "ili9488_stream.h"
+#include "ili9488_image.h"
+
+#if (ILI9488_STREAM_CHUNK % 4) != 0
+#error "ILI9488_STREAM_CHUNK must be a multiple of 4"
+#endif
+
+/* Chunk buffers, one being read while the other is sent */
+static uint32_t ili9488_stream_buffer[2][ILI9488_STREAM_CHUNK / 4];
+
+/* Palette of the streamed image */
+static uint32_t ili9488_stream_palette[256];
+
+/**
+ * @brief Start a read
+ * @return The read callback's result
+ */
+static inline uint32_t ILI9488_Stream_Start(const ILI9488_Reader_t *reader, uint32_t offset, void *buffer, uint32_t size){
+    return reader->read(reader->context, offset, buffer, size);
+}
+
+/**
+ * @brief Complete a read
+ * @param started Result of ILI9488_Stream_Start()
+ * @return Number of bytes read
+ */
+static inline uint32_t ILI9488_Stream_Finish(const ILI9488_Reader_t *reader, uint32_t started){
+    return reader->wait ? reader->wait(reader->context) : started;
+}
+
+/**
+ * @brief Read a block and wait for it
+ * @return 1 if all bytes were read, 0 otherwise
+ */
+static uint8_t ILI9488_Stream_Read(const ILI9488_Reader_t *reader, uint32_t offset, void *buffer, uint32_t size){
+    return ILI9488_Stream_Finish(reader, ILI9488_Stream_Start(reader, offset, buffer, size)) == size;
+}
+
+/**
+ * @brief Feed pixel data from a reader to an image decoder
+ * @param decoder Decoder started with ILI9488_ImageBegin()
+ * @param reader Data source
+ * @param offset Byte offset of the pixel data
+ * @param size Number of bytes of pixel data
+ * @return 1 if all data was read, 0 otherwise
+ */
+static uint8_t ILI9488_Stream_Data(ILI9488_ImageDecoder_t *decoder, const ILI9488_Reader_t *reader,
+                                   uint32_t offset, uint32_t size){
+    uint8_t current = 0;
+    uint32_t requested = size < ILI9488_STREAM_CHUNK ? size : ILI9488_STREAM_CHUNK;
+    uint32_t started = 0;
+
+    if(size) started = ILI9488_Stream_Start(reader, offset, ili9488_stream_buffer[0], requested);
+    while(size){
+        uint32_t got = ILI9488_Stream_Finish(reader, started);
+        if(got != requested) return 0;
+        offset += got;
+        size -= got;
+
+        /* Prefetch the next chunk into the other buffer before sending this one */
+        if(size){
+            requested = size < ILI9488_STREAM_CHUNK ? size : ILI9488_STREAM_CHUNK;
+            started = ILI9488_Stream_Start(reader, offset, ili9488_stream_buffer[current ^ 1], requested);
+        }
+        ILI9488_ImagePush(decoder, ili9488_stream_buffer[current], got);
+        current ^= 1;
+    }
+    return 1;
+}
+
+/**
+ * @brief Draw an image blob read through a reader
+ * @param x Left edge of the image
+ * @param y Top edge of the image
+ * @param reader Data source
+ * @param offset Byte offset of the image blob in the source
+ * @return 1 if the image was drawn, 0 on a read error or unsupported image
+ */
+uint8_t ILI9488_DrawImageStream(uint16_t x, uint16_t y, const ILI9488_Reader_t *reader, uint32_t offset){
+    ILI9488_ImageHeader_t header;
+    ILI9488_ImageDecoder_t decoder;
+
+    if(!ILI9488_Stream_Read(reader, offset, &header, sizeof(header))) return 0;
+    offset += sizeof(header);
+    if(header.palette_count > 256) return 0;
+    if(header.palette_count){
+        uint32_t size = header.palette_count * 4u;
+        if(!ILI9488_Stream_Read(reader, offset, ili9488_stream_palette, size)) return 0;
+        offset += size;
+    }
+    if(!ILI9488_ImageBegin(&decoder, x, y, &header, ili9488_stream_palette)) return 0;
+    return ILI9488_Stream_Data(&decoder, reader, offset, header.data_size);
+}
+
+/**
+ * @brief Draw raw bus words read through a reader
+ * @param x Left edge of the image
+ * @param y Top edge of the image
+ * @param w Image width
+ * @param h Image height
+ * @param reader Data source
+ * @param offset Byte offset of the first bus word (uint32_t) in the source
+ * @return 1 if the image was drawn, 0 on a read error
+ */
+uint8_t ILI9488_DrawRawStream(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                              const ILI9488_Reader_t *reader, uint32_t offset){
+    ILI9488_ImageHeader_t header = {w, h, ILI9488_IMAGE_BUS666, 0, 0, (uint32_t)w * h * 4u};
+    ILI9488_ImageDecoder_t decoder;
+
+    ILI9488_ImageBegin(&decoder, x, y, &header, NULL);
+    return ILI9488_Stream_Data(&decoder, reader, offset, header.data_size);
+}
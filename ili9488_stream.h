@@ -0,0 +1,88 @@
+/**
+ * @file ili9488_stream.h
+ * @brief ILI9488 streamed images
+ * @details This header file contains the declarations for drawing images
+ *          that cannot be memory-mapped, such as files on an SD card. Data is
+ *          pulled through a reader callback into two chunk buffers: while one
+ *          chunk is pushed to the panel, the next one is already being read,
+ *          so an asynchronous (DMA) reader overlaps storage latency with bus
+ *          time.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_STREAM_H
+#define __ILI9488_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* For uint8_t, uint16_t, uint32_t */
+#include <stdint.h>
+#include "ili9488.h"
+
+/* Size of each of the two chunk buffers in bytes (a multiple of 4) */
+#ifndef ILI9488_STREAM_CHUNK
+#define ILI9488_STREAM_CHUNK  2048
+#endif
+
+/**
+ * @brief Read callback
+ * @param context Reader context
+ * @param offset Byte offset in the source
+ * @param buffer Destination buffer (4-byte aligned)
+ * @param size Number of bytes to read
+ * @return Blocking readers: number of bytes read. Asynchronous readers: ignored.
+ * @details An asynchronous reader only starts the transfer and reports its
+ *          completion through the wait callback.
+ */
+typedef uint32_t (*ILI9488_ReadFn_t)(void *context, uint32_t offset, void *buffer, uint32_t size);
+
+/**
+ * @brief Wait callback of asynchronous readers
+ * @param context Reader context
+ * @return Number of bytes read by the transfer started last
+ */
+typedef uint32_t (*ILI9488_WaitFn_t)(void *context);
+
+/**
+ * @brief Data source for streamed images
+ */
+typedef struct {
+    ILI9488_ReadFn_t read;  ///< Reads, or starts reading, a block of bytes
+    ILI9488_WaitFn_t wait;  ///< NULL for blocking readers
+    void *context;          ///< Passed to both callbacks
+} ILI9488_Reader_t;
+
+/**
+ * @brief Draw an image blob read through a reader
+ * @param x Left edge of the image
+ * @param y Top edge of the image
+ * @param reader Data source
+ * @param offset Byte offset of the image blob in the source
+ * @return 1 if the image was drawn, 0 on a read error or unsupported image
+ * @details Accepts every format of ili9488_image.h. Palettes are limited to
+ *          256 entries.
+ */
+uint8_t ILI9488_DrawImageStream(uint16_t x, uint16_t y, const ILI9488_Reader_t *reader, uint32_t offset);
+
+/**
+ * @brief Draw raw bus words read through a reader
+ * @param x Left edge of the image
+ * @param y Top edge of the image
+ * @param w Image width
+ * @param h Image height
+ * @param reader Data source
+ * @param offset Byte offset of the first bus word (uint32_t) in the source
+ * @return 1 if the image was drawn, 0 on a read error
+ */
+uint8_t ILI9488_DrawRawStream(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                              const ILI9488_Reader_t *reader, uint32_t offset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ILI9488_STREAM_H */
@@ -0,0 +1,284 @@
+/**
+ * @file ili9488_text.c
+ * @brief ILI9488 text layout
+ * @details This file contains the implementation of the text layout. A
+ *          layout is looked up by font, box width, text length and a 32-bit
+ *          hash of the text, and a hit is confirmed against the copy of the
+ *          text kept in the entry, so neither a string edited in place nor a
+ *          hash collision returns a stale layout; the least recently used
+ *          entry is replaced on a miss. Line breaking
+ *          is greedy: the last break opportunity that fits is taken, and a
+ *          line with none is broken before the glyph that overflows.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "ili9488_text.h"
+
+/* Replacement character for invalid UTF-8 and missing glyphs */
+#define ILI9488_TEXT_REPLACEMENT  0xFFFD
+
+/* Layout cache */
+static ILI9488_TextLayout_t ili9488_text_cache[ILI9488_TEXT_CACHE];
+static uint32_t ili9488_text_clock;
+
+/**
+ * @brief Break opportunity while laying out a line
+ */
+typedef struct {
+    uint32_t next;          ///< Byte offset where the next line starts
+    uint16_t glyph_count;   ///< Layout glyph count at the break
+    int32_t width;          ///< Line width at the break
+} ILI9488_TextBreak_t;
+
+/**
+ * @brief Decode one UTF-8 sequence
+ * @param p Text
+ * @param left Bytes left in the text (at least 1)
+ * @param length Output: bytes consumed (at least 1)
+ * @return Code point, or U+FFFD for an invalid sequence
+ */
+static uint32_t ILI9488_Text_Decode(const uint8_t *p, uint32_t left, uint32_t *length){
+    uint32_t codepoint, need;
+
+    *length = 1;
+    if(p[0] < 0x80) return p[0];
+    if(p[0] >= 0xC2 && p[0] <= 0xDF){ codepoint = p[0] & 0x1F; need = 1; }
+    else if(p[0] >= 0xE0 && p[0] <= 0xEF){ codepoint = p[0] & 0x0F; need = 2; }
+    else if(p[0] >= 0xF0 && p[0] <= 0xF4){ codepoint = p[0] & 0x07; need = 3; }
+    else return ILI9488_TEXT_REPLACEMENT;
+
+    for(uint32_t i = 1; i <= need; i++){
+        if(i >= left || (p[i] & 0xC0) != 0x80) return ILI9488_TEXT_REPLACEMENT;
+        codepoint = codepoint << 6 | (p[i] & 0x3F);
+        *length = i + 1;
+    }
+    /* Overlong forms, surrogates and code points past U+10FFFF */
+    if((need == 2 && codepoint < 0x800) || (need == 3 && (codepoint < 0x10000 || codepoint > 0x10FFFF)) ||
+       (codepoint >= 0xD800 && codepoint <= 0xDFFF)) return ILI9488_TEXT_REPLACEMENT;
+    return codepoint;
+}
+
+/**
+ * @brief Check for characters that may be broken around without a space
+ */
+static inline uint8_t ILI9488_Text_Ideograph(uint32_t codepoint){
+    return (codepoint >= 0x2E80 && codepoint <= 0x9FFF) || (codepoint >= 0xF900 && codepoint <= 0xFAFF) ||
+           (codepoint >= 0xFF00 && codepoint <= 0xFF60) || codepoint >= 0x20000;
+}
+
+/**
+ * @brief Hash the text bytes
+ */
+static uint32_t ILI9488_Text_Hash(const char *text, uint32_t *size){
+    uint32_t hash = 2166136261u;
+    const uint8_t *p = (const uint8_t *)text;
+    while(*p){
+        hash = (hash ^ *p++) * 16777619u;
+    }
+    *size = (uint32_t)(p - (const uint8_t *)text);
+    return hash;
+}
+
+/**
+ * @brief Wrap text into a layout
+ * @param layout Layout with font and box_width set
+ * @param text Text
+ * @param size Text length in bytes
+ */
+static void ILI9488_Text_Wrap(ILI9488_TextLayout_t *layout, const uint8_t *text, uint32_t size){
+    const void *font = layout->font;
+    int32_t box = layout->box_width ? layout->box_width : INT32_MAX;
+    uint32_t pos = 0;
+
+    layout->line_count = 0;
+    layout->glyph_count = 0;
+    layout->width = 0;
+    layout->truncated = 0;
+
+    while(pos < size){
+        ILI9488_TextLine_t *line = &layout->lines[layout->line_count];
+        ILI9488_TextBreak_t chosen, candidate = {0, 0, -1}, ink;
+        const ILI9488_FontGlyph_t *previous = NULL;
+        int32_t pen = 0;
+        uint16_t line_glyphs = 0;
+        uint32_t p = pos;
+
+        if(layout->line_count == ILI9488_TEXT_MAX_LINES){
+            layout->truncated = 1;
+            break;
+        }
+        line->first = layout->glyph_count;
+        ink.next = pos;
+        ink.glyph_count = layout->glyph_count;
+        ink.width = 0;
+
+        for(;;){
+            uint32_t length;
+            if(p >= size){
+                /* End of text, trailing spaces excluded */
+                chosen = ink;
+                chosen.next = size;
+                break;
+            }
+            uint32_t codepoint = ILI9488_Text_Decode(text + p, size - p, &length);
+            if(codepoint == '\n'){
+                chosen = ink;
+                chosen.next = p + length;
+                break;
+            }
+            const ILI9488_FontGlyph_t *glyph = ILI9488_FontGlyph(font, codepoint);
+            if(glyph == NULL) glyph = ILI9488_FontGlyph(font, ILI9488_TEXT_REPLACEMENT);
+            if(glyph == NULL){
+                p += length;
+                continue;
+            }
+
+            uint8_t space = codepoint == ' ';
+            uint8_t ideograph = ILI9488_Text_Ideograph(codepoint);
+            uint8_t drawn = glyph->width && glyph->height;
+            int32_t x = pen + (previous ? ILI9488_FontKerning(font, previous, glyph) : 0);
+
+            if(space){
+                /* Break after the space, measure up to the last ink */
+                candidate = ink;
+                candidate.next = p + length;
+            }
+            else if(ideograph && p > pos){
+                candidate.next = p;
+                candidate.glyph_count = layout->glyph_count;
+                candidate.width = pen;
+            }
+
+            if(!space && p > pos && (x + glyph->advance > box || (drawn && line_glyphs == ILI9488_FONT_LINE_GLYPHS))){
+                if(candidate.width >= 0 && candidate.next > pos) chosen = candidate;
+                else{
+                    chosen = ink;
+                    chosen.next = p;
+                }
+                break;
+            }
+            if(drawn){
+                if(layout->glyph_count == ILI9488_TEXT_MAX_GLYPHS){
+                    layout->truncated = 1;
+                    chosen = ink;
+                    chosen.next = size;
+                    break;
+                }
+                layout->glyphs[layout->glyph_count] = glyph;
+                layout->positions[layout->glyph_count++] = (int16_t)x;
+                line_glyphs++;
+            }
+            pen = x + glyph->advance;
+            previous = glyph;
+            p += length;
+            if(!space){
+                ink.next = p;
+                ink.glyph_count = layout->glyph_count;
+                ink.width = pen;
+                if(ideograph) candidate = ink;
+            }
+        }
+
+        /* Glyphs past the break belong to the next line */
+        layout->glyph_count = chosen.glyph_count;
+        line->count = (uint16_t)(chosen.glyph_count - line->first);
+        line->width = (uint16_t)chosen.width;
+        if(line->width > layout->width) layout->width = line->width;
+        layout->line_count++;
+        pos = chosen.next;
+    }
+}
+
+/**
+ * @brief Lay out text
+ * @param font Font blob
+ * @param text Null-terminated UTF-8 text
+ * @param width Box width to wrap to, 0 to break only at newlines
+ * @return Layout, valid until the cache entry is reused
+ */
+const ILI9488_TextLayout_t *ILI9488_LayoutText(const void *font, const char *text, uint16_t width){
+    uint32_t size;
+    uint32_t hash = ILI9488_Text_Hash(text, &size);
+    ILI9488_TextLayout_t *layout = &ili9488_text_cache[0];
+
+    ili9488_text_clock++;
+    for(uint8_t i = 0; i < ILI9488_TEXT_CACHE; i++){
+        ILI9488_TextLayout_t *entry = &ili9488_text_cache[i];
+        if(entry->font == font && entry->hash == hash && entry->size == size && entry->box_width == width &&
+           size <= ILI9488_TEXT_CACHE_BYTES && memcmp(entry->text, text, size) == 0){
+            entry->last_use = ili9488_text_clock;
+            return entry;
+        }
+        if(entry->font == NULL || (layout->font != NULL && entry->last_use < layout->last_use)) layout = entry;
+    }
+
+    layout->font = font;
+    layout->hash = hash;
+    layout->size = size;
+    layout->box_width = width;
+    layout->last_use = ili9488_text_clock;
+    if(size <= ILI9488_TEXT_CACHE_BYTES) memcpy(layout->text, text, size);
+    ILI9488_Text_Wrap(layout, (const uint8_t *)text, size);
+    return layout;
+}
+
+/**
+ * @brief Draw text in a box
+ * @param x Left edge of the box
+ * @param y Top edge of the box
+ * @param width Box width, 0 for the width of the widest line
+ * @param font Font blob
+ * @param text Null-terminated UTF-8 text
+ * @param align Horizontal alignment of the lines
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Height of the laid out text in pixels
+ */
+uint16_t ILI9488_DrawTextBox(uint16_t x, uint16_t y, uint16_t width, const void *font, const char *text,
+                             ILI9488_Align_t align, uint32_t color, uint32_t bg){
+    const ILI9488_TextLayout_t *layout = ILI9488_LayoutText(font, text, width);
+    uint16_t line_height = ((const ILI9488_FontHeader_t *)font)->line_height;
+    static int16_t positions[ILI9488_FONT_LINE_GLYPHS];
+
+    if(width == 0) width = layout->width;
+    for(uint16_t i = 0; i < layout->line_count; i++){
+        const ILI9488_TextLine_t *line = &layout->lines[i];
+        const int16_t *line_positions = &layout->positions[line->first];
+        int16_t shift = 0;
+
+        if(align == ILI9488_ALIGN_CENTER) shift = (int16_t)((width - line->width) / 2);
+        else if(align == ILI9488_ALIGN_RIGHT) shift = (int16_t)(width - line->width);
+        if(width < line->width) shift = 0;
+        if(shift){
+            for(uint16_t g = 0; g < line->count; g++){
+                positions[g] = (int16_t)(line_positions[g] + shift);
+            }
+            line_positions = positions;
+        }
+        ILI9488_DrawGlyphLine(x, (uint16_t)(y + i * line_height), width, font, &layout->glyphs[line->first],
+                              line_positions, line->count, color, bg);
+    }
+    return (uint16_t)(layout->line_count * line_height);
+}
+
+/**
+ * @brief Measure text
+ * @param font Font blob
+ * @param text Null-terminated UTF-8 text
+ * @return Width of the widest line in pixels
+ */
+uint16_t ILI9488_TextWidth(const void *font, const char *text){
+    return ILI9488_LayoutText(font, text, 0)->width;
+}
+
+/**
+ * @brief Drop all cached layouts
+ */
+void ILI9488_ClearTextCache(void){
+    memset(ili9488_text_cache, 0, sizeof(ili9488_text_cache));
+    ili9488_text_clock = 0;
+}
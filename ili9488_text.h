@@ -0,0 +1,132 @@
+/**
+ * @file ili9488_text.h
+ * @brief ILI9488 text layout
+ * @details This header file contains the declarations for laying out UTF-8
+ *          text in a box with the fonts of ili9488_font.h. Text is decoded,
+ *          kerned and word-wrapped to the box width once; the result (line
+ *          breaks, glyphs and pen positions) is kept in a small cache, so a
+ *          label redrawn every frame costs only a hash and a compare of its
+ *          bytes before the glyphs go to the bus. Every line is painted in one address
+ *          window as wide as the box.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_TEXT_H
+#define __ILI9488_TEXT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* For uint8_t, uint16_t, uint32_t */
+#include <stdint.h>
+#include "ili9488_font.h"
+
+/* Number of layouts kept in the cache */
+#ifndef ILI9488_TEXT_CACHE
+#define ILI9488_TEXT_CACHE  4
+#endif
+
+/* Longest text kept in a cache entry to verify hits; longer text is laid out on every call */
+#ifndef ILI9488_TEXT_CACHE_BYTES
+#define ILI9488_TEXT_CACHE_BYTES  256
+#endif
+
+/* Most lines and glyphs in one layout; the rest of the text is dropped */
+#ifndef ILI9488_TEXT_MAX_LINES
+#define ILI9488_TEXT_MAX_LINES   16
+#endif
+#ifndef ILI9488_TEXT_MAX_GLYPHS
+#define ILI9488_TEXT_MAX_GLYPHS  128
+#endif
+
+/* Horizontal alignment of the lines in the box */
+typedef enum {
+    ILI9488_ALIGN_LEFT = 0,
+    ILI9488_ALIGN_CENTER = 1,
+    ILI9488_ALIGN_RIGHT = 2
+} ILI9488_Align_t;
+
+/**
+ * @brief Laid out line
+ */
+typedef struct {
+    uint16_t first;   ///< Index of the line's first glyph in the layout
+    uint16_t count;   ///< Number of glyphs on the line
+    uint16_t width;   ///< Line width in pixels, trailing spaces excluded
+} ILI9488_TextLine_t;
+
+/**
+ * @brief Laid out text
+ * @details Only glyphs with ink are stored; spaces just move the pen.
+ *          Positions are relative to the left edge of their line.
+ */
+typedef struct {
+    const void *font;       ///< Font, NULL for an unused cache entry
+    uint32_t hash;          ///< Hash of the text bytes
+    uint32_t size;          ///< Length of the text in bytes
+    uint32_t last_use;      ///< Cache age stamp
+    uint16_t box_width;     ///< Width the text was wrapped to, 0 for no wrapping
+    uint16_t width;         ///< Width of the widest line
+    uint16_t line_count;    ///< Number of lines
+    uint16_t glyph_count;   ///< Number of glyphs
+    uint8_t truncated;      ///< 1 if the text did not fit in the layout limits
+    char text[ILI9488_TEXT_CACHE_BYTES];                          ///< Copy of the text, compared on a cache hit
+    ILI9488_TextLine_t lines[ILI9488_TEXT_MAX_LINES];             ///< Lines
+    const ILI9488_FontGlyph_t *glyphs[ILI9488_TEXT_MAX_GLYPHS];   ///< Glyphs, line after line
+    int16_t positions[ILI9488_TEXT_MAX_GLYPHS];                   ///< Cell position of every glyph
+} ILI9488_TextLayout_t;
+
+/**
+ * @brief Lay out text
+ * @param font Font blob
+ * @param text Null-terminated UTF-8 text
+ * @param width Box width to wrap to, 0 to break only at newlines
+ * @return Layout, valid until the cache entry is reused
+ * @details Lines break after spaces and around CJK ideographs; a word wider
+ *          than the box is broken where it overflows. Invalid UTF-8 and
+ *          characters missing from the font are drawn as U+FFFD if the font
+ *          has it, and skipped otherwise. Repeated calls with the same font,
+ *          width and text (up to ILI9488_TEXT_CACHE_BYTES bytes) return the
+ *          cached layout.
+ */
+const ILI9488_TextLayout_t *ILI9488_LayoutText(const void *font, const char *text, uint16_t width);
+
+/**
+ * @brief Draw text in a box
+ * @param x Left edge of the box
+ * @param y Top edge of the box
+ * @param width Box width, 0 for the width of the widest line
+ * @param font Font blob
+ * @param text Null-terminated UTF-8 text
+ * @param align Horizontal alignment of the lines
+ * @param color Text color (RGB666 format)
+ * @param bg Background color (RGB666 format)
+ * @return Height of the laid out text in pixels
+ * @details Each line fills the whole box width, so text drawn over older
+ *          text in the same box needs no clear.
+ */
+uint16_t ILI9488_DrawTextBox(uint16_t x, uint16_t y, uint16_t width, const void *font, const char *text,
+                             ILI9488_Align_t align, uint32_t color, uint32_t bg);
+
+/**
+ * @brief Measure text
+ * @param font Font blob
+ * @param text Null-terminated UTF-8 text
+ * @return Width of the widest line in pixels
+ */
+uint16_t ILI9488_TextWidth(const void *font, const char *text);
+
+/**
+ * @brief Drop all cached layouts
+ * @details Needed only when a font blob is replaced at the same address.
+ */
+void ILI9488_ClearTextCache(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ILI9488_TEXT_H */
@@ -0,0 +1,48 @@
+/**
+ * @file ili9488_toggle.c
+ * @brief ILI9488 bus line toggle counters
+ * @details This file contains the counters updated by the inline hooks of
+ *          ili9488_toggle.h and the functions to read them. The lines are
+ *          assumed low before the first word, with DCX high, as the GPIO
+ *          setup leaves them on most boards.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <string.h>
+#include "ili9488_toggle.h"
+
+#ifdef ILI9488_TOGGLE
+
+ILI9488_Toggles_t ili9488_toggles;
+uint32_t ili9488_toggle_bus;
+uint8_t ili9488_toggle_dcx = 1;
+
+/**
+ * @brief Copy the counters
+ * @param toggles Output counts
+ */
+void ILI9488_ToggleRead(ILI9488_Toggles_t *toggles){
+    *toggles = ili9488_toggles;
+}
+
+/**
+ * @brief Set all counters to zero, keeping the line levels
+ */
+void ILI9488_ToggleClear(void){
+    memset(&ili9488_toggles, 0, sizeof(ili9488_toggles));
+}
+
+/**
+ * @brief Sum of the data line transitions
+ * @param toggles Counts
+ * @return Transitions on DB0-DB17
+ */
+uint32_t ILI9488_ToggleData(const ILI9488_Toggles_t *toggles){
+    uint32_t sum = 0;
+    for(uint8_t line = 0; line < 18; line++) sum += toggles->lines[line];
+    return sum;
+}
+
+#endif /* ILI9488_TOGGLE */
@@ -0,0 +1,132 @@
+/**
+ * @file ili9488_toggle.h
+ * @brief ILI9488 bus line toggle counters
+ * @details This header file contains the declarations for counting the
+ *          transitions on each bus line as the driver drives them: DB0-DB17,
+ *          WR, CS and DCX. The counters are compiled in when ILI9488_TOGGLE
+ *          is defined (in main.h or on the compiler command line); otherwise
+ *          every hook below is an empty macro and costs nothing.
+ *
+ *          ILI9488_Write18() clears all data lines and then sets the 1 bits,
+ *          so a line that is 1 in two words in a row goes low and high again:
+ *          it toggles as often as it is 1 in the old and the new word. Runs
+ *          sent by ILI9488_WriteBusRun() toggle only WR. The counters also keep
+ *          the transitions a write of only the changed lines would have
+ *          caused, to size the gain of such an encoding.
+ *
+ *          To report per API call, read the counters before and after it:
+ *
+ *              ILI9488_Toggles_t before, after;
+ *              ILI9488_ToggleRead(&before);
+ *              ILI9488_FillRect(0, 0, 100, 100, ILI9488_RED);
+ *              ILI9488_ToggleRead(&after);
+ *              data = ILI9488_ToggleData(&after) - ILI9488_ToggleData(&before);
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_TOGGLE_H
+#define __ILI9488_TOGGLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* For uint8_t, uint32_t */
+#include <stdint.h>
+#include "main.h"
+
+/* Line indices of ILI9488_Toggles_t.lines, after DB0-DB17 */
+#define ILI9488_TOGGLE_WR     18
+#define ILI9488_TOGGLE_CS     19
+#define ILI9488_TOGGLE_DCX    20
+#define ILI9488_TOGGLE_LINES  21
+
+/**
+ * @brief Transition counts
+ */
+typedef struct {
+    uint32_t lines[ILI9488_TOGGLE_LINES]; ///< Transitions per line: DB0-DB17, WR, CS, DCX
+    uint32_t changed;                     ///< Data line transitions if only changed lines were driven
+} ILI9488_Toggles_t;
+
+#ifdef ILI9488_TOGGLE
+
+/* Counters, and the line levels the counting starts from */
+extern ILI9488_Toggles_t ili9488_toggles;
+extern uint32_t ili9488_toggle_bus;   ///< Data lines after the last word
+extern uint8_t ili9488_toggle_dcx;    ///< DCX level
+
+/**
+ * @brief Count the data line transitions of ILI9488_Write18()
+ * @param word 18-bit bus word
+ */
+static inline void ILI9488_ToggleWord(uint32_t word){
+    uint32_t old = ili9488_toggle_bus;
+    word &= 0x3FFFF;
+    /* Cleared if 1 before, set if 1 now */
+    for(uint32_t bits = old | word; bits; bits &= bits - 1){
+        uint32_t line = (uint32_t)__builtin_ctz(bits);
+        ili9488_toggles.lines[line] += ((old >> line) & 1) + ((word >> line) & 1);
+    }
+    ili9488_toggles.changed += (uint32_t)__builtin_popcount(old ^ word);
+    ili9488_toggle_bus = word;
+}
+
+/**
+ * @brief Count the two WR transitions of a strobe
+ */
+static inline void ILI9488_ToggleStrobe(void){
+    ili9488_toggles.lines[ILI9488_TOGGLE_WR] += 2;
+}
+
+/**
+ * @brief Count CS going low and DCX taking a level
+ * @param dcx 0 for a command, 1 for data
+ */
+static inline void ILI9488_ToggleSelect(uint8_t dcx){
+    ili9488_toggles.lines[ILI9488_TOGGLE_CS]++;
+    if(dcx != ili9488_toggle_dcx) ili9488_toggles.lines[ILI9488_TOGGLE_DCX]++;
+    ili9488_toggle_dcx = dcx;
+}
+
+/**
+ * @brief Count CS going high
+ */
+static inline void ILI9488_ToggleDeselect(void){
+    ili9488_toggles.lines[ILI9488_TOGGLE_CS]++;
+}
+
+/**
+ * @brief Copy the counters
+ * @param toggles Output counts
+ */
+void ILI9488_ToggleRead(ILI9488_Toggles_t *toggles);
+
+/**
+ * @brief Set all counters to zero, keeping the line levels
+ */
+void ILI9488_ToggleClear(void);
+
+/**
+ * @brief Sum of the data line transitions
+ * @param toggles Counts
+ * @return Transitions on DB0-DB17
+ */
+uint32_t ILI9488_ToggleData(const ILI9488_Toggles_t *toggles);
+
+#else
+
+#define ILI9488_ToggleWord(word)      ((void)0)
+#define ILI9488_ToggleStrobe()        ((void)0)
+#define ILI9488_ToggleSelect(dcx)     ((void)0)
+#define ILI9488_ToggleDeselect()      ((void)0)
+
+#endif /* ILI9488_TOGGLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ILI9488_TOGGLE_H */
@@ -0,0 +1,214 @@
+/**
+ * @file ili9488_trace.c
+ * @brief ILI9488 bus trace recorder
+ * @details This file contains the implementation of the trace recorder.
+ *          Records go into a power-of-two ring indexed by a free-running byte
+ *          counter, so appending is a mask and a store per byte. Data words
+ *          are stored as differences from the previous word, which puts
+ *          command parameters and smooth image data in one or two bytes, and
+ *          equal words only bump a pending repeat count that is written out
+ *          when something else arrives. A full-screen fill costs about twenty
+ *          bytes of trace.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include "ili9488_trace.h"
+
+#ifdef ILI9488_TRACE
+
+/* Ring buffer and its write counter */
+static uint8_t ili9488_trace_ring[ILI9488_TRACE_SIZE];
+static uint32_t ili9488_trace_head;
+
+/* Recorder state */
+static uint32_t ili9488_trace_previous;   ///< Last recorded data word
+static uint32_t ili9488_trace_words;      ///< Data words recorded since the last command
+static uint32_t ili9488_trace_repeat;     ///< Copies of the last data word not written yet
+static uint32_t ili9488_trace_time;       ///< Clock at the last command
+static uint8_t ili9488_trace_enabled = 1;
+uint32_t ili9488_trace_checksum;
+
+/**
+ * @brief Append one record
+ * @param type Record type
+ * @param value Payload
+ */
+static void ILI9488_Trace_Put(uint8_t type, uint32_t value){
+    uint8_t length = 0;
+    uint32_t head = ili9488_trace_head;
+    uint32_t tag = head++;
+
+    while(value){
+        ili9488_trace_ring[head++ & (ILI9488_TRACE_SIZE - 1)] = value & 0x7F;
+        value >>= 7;
+        length++;
+    }
+    ili9488_trace_ring[tag & (ILI9488_TRACE_SIZE - 1)] = 0x80 | (type << 4) | length;
+    ili9488_trace_head = head;
+}
+
+/**
+ * @brief Write out a pending repeat count
+ */
+static inline void ILI9488_Trace_Flush(void){
+    if(ili9488_trace_repeat){
+        ILI9488_Trace_Put(ILI9488_TRACE_REPEAT, ili9488_trace_repeat);
+        ili9488_trace_repeat = 0;
+    }
+}
+
+/**
+ * @brief Record a command
+ * @param cmd Command byte
+ */
+void ILI9488_TraceCommand(uint8_t cmd){
+    if(!ili9488_trace_enabled) return;
+    uint32_t now = ILI9488_TRACE_CLOCK();
+    uint32_t elapsed = now - ili9488_trace_time;
+    if(elapsed > 0xFFFFFF) elapsed = 0xFFFFFF;
+    ili9488_trace_time = now;
+
+    ILI9488_Trace_Flush();
+    ILI9488_Trace_Put(ILI9488_TRACE_COMMAND, elapsed << 8 | cmd);
+    ili9488_trace_previous = 0;
+    ili9488_trace_words = 0;
+}
+
+/**
+ * @brief Record a data word (command parameter or pixel)
+ * @param word 18-bit bus word
+ */
+void ILI9488_TraceData(uint32_t word){
+    if(!ili9488_trace_enabled) return;
+    if(ili9488_trace_words && word == ili9488_trace_previous){
+        ili9488_trace_repeat++;
+        return;
+    }
+    int32_t delta = (int32_t)(word - ili9488_trace_previous);
+    ILI9488_Trace_Flush();
+    ILI9488_Trace_Put(ILI9488_TRACE_DATA, ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31));
+    ili9488_trace_previous = word;
+    ili9488_trace_words++;
+}
+
+/**
+ * @brief Record a run of one data word, latched once and repeated with WR strobes
+ * @param word 18-bit bus word
+ * @param count Number of words (1 or more)
+ */
+void ILI9488_TraceRun(uint32_t word, uint32_t count){
+    if(!ili9488_trace_enabled) return;
+    ILI9488_TraceData(word);
+    ili9488_trace_repeat += count - 1;
+}
+
+/**
+ * @brief Start a burst of pixel words
+ * @param count Number of words that will follow through ILI9488_TracePixel()
+ */
+void ILI9488_TraceBurst(uint32_t count){
+#if ILI9488_TRACE_PIXELS
+    (void)count;
+#else
+    if(!ili9488_trace_enabled) return;
+    ILI9488_Trace_Flush();
+    ILI9488_Trace_Put(ILI9488_TRACE_BURST, count);
+    ili9488_trace_checksum = 2166136261u;
+#endif
+}
+
+/**
+ * @brief Finish a burst of pixel words
+ */
+void ILI9488_TraceBurstEnd(void){
+#if !ILI9488_TRACE_PIXELS
+    if(!ili9488_trace_enabled) return;
+    ILI9488_Trace_Put(ILI9488_TRACE_CHECKSUM, ili9488_trace_checksum);
+#endif
+}
+
+/**
+ * @brief Record a hardware reset pulse
+ */
+void ILI9488_TraceReset(void){
+    if(!ili9488_trace_enabled) return;
+    ILI9488_Trace_Flush();
+    ILI9488_Trace_Put(ILI9488_TRACE_RESET, 0);
+}
+
+/**
+ * @brief Record a TE rising edge, the start of the vertical blanking
+ */
+void ILI9488_TraceVsync(void){
+    if(!ili9488_trace_enabled) return;
+    uint32_t elapsed = ILI9488_TRACE_CLOCK() - ili9488_trace_time;
+    if(elapsed > 0x0FFFFFFF) elapsed = 0x0FFFFFFF;
+    ILI9488_Trace_Flush();
+    ILI9488_Trace_Put(ILI9488_TRACE_VSYNC, elapsed);
+}
+
+/**
+ * @brief Record an application marker, for example a frame number
+ * @param value Marker value
+ */
+void ILI9488_TraceMark(uint32_t value){
+    if(!ili9488_trace_enabled) return;
+    ILI9488_Trace_Flush();
+    ILI9488_Trace_Put(ILI9488_TRACE_MARK, value);
+}
+
+/**
+ * @brief Pause or resume recording
+ * @param enable 1 to record (the default), 0 to pause
+ */
+void ILI9488_TraceEnable(uint8_t enable){
+    if(!enable) ILI9488_Trace_Flush();
+    ili9488_trace_enabled = enable;
+}
+
+/**
+ * @brief Drop all recorded bytes
+ */
+void ILI9488_TraceClear(void){
+    ili9488_trace_head = 0;
+    ili9488_trace_repeat = 0;
+    ili9488_trace_words = 0;
+    ili9488_trace_previous = 0;
+}
+
+/**
+ * @brief Send the header and the recorded bytes, oldest first
+ * @param write Byte channel
+ * @param context Passed to the channel
+ * @return Number of record bytes sent
+ */
+uint32_t ILI9488_TraceDump(ILI9488_TraceWriteFn_t write, void *context){
+    ILI9488_TraceHeader_t header;
+    uint8_t enabled = ili9488_trace_enabled;
+    uint32_t size, start;
+
+    ILI9488_Trace_Flush();
+    ili9488_trace_enabled = 0;
+
+    size = ili9488_trace_head < ILI9488_TRACE_SIZE ? ili9488_trace_head : ILI9488_TRACE_SIZE;
+    start = (ili9488_trace_head - size) & (ILI9488_TRACE_SIZE - 1);
+    header.magic = ILI9488_TRACE_MAGIC;
+    header.version = 1;
+    header.pixels = ILI9488_TRACE_PIXELS;
+    header.wrapped = ili9488_trace_head > ILI9488_TRACE_SIZE;
+    header.clock_hz = ILI9488_TRACE_CLOCK_HZ;
+    header.size = size;
+    write(context, (const uint8_t *)&header, sizeof(header));
+
+    /* The oldest bytes run to the end of the ring, the rest start at 0 */
+    uint32_t first = ILI9488_TRACE_SIZE - start < size ? ILI9488_TRACE_SIZE - start : size;
+    if(first) write(context, &ili9488_trace_ring[start], first);
+    if(size > first) write(context, ili9488_trace_ring, size - first);
+
+    ili9488_trace_enabled = enabled;
+    return size;
+}
+
+#endif /* ILI9488_TRACE */
@@ -0,0 +1,202 @@
+/**
+ * @file ili9488_trace.h
+ * @brief ILI9488 bus trace recorder
+ * @details This header file contains the declarations for recording the
+ *          commands and data sent to the panel into a RAM ring buffer. The
+ *          recorder is compiled in when ILI9488_TRACE is defined (in main.h
+ *          or on the compiler command line); otherwise every hook below is an
+ *          empty macro and costs nothing. The ring can be dumped over any byte
+ *          channel (UART, USB, a file) and replayed on a PC with
+ *          tools/ili9488_replay.c, which rebuilds the panel memory as images
+ *          and reports the time spent per command.
+ *
+ *          Records are one tag byte (bit 7 set, record type in bits 6-4,
+ *          payload length in bits 3-0) followed by up to 15 payload bytes of
+ *          7 bits each, least significant group first. Since only tag bytes
+ *          have bit 7 set, a reader can pick up the stream at any byte after
+ *          the ring wrapped.
+ *          0 Command   payload: time since the previous command << 8 | command
+ *          1 Data      payload: zig-zag difference from the previous data word
+ *                      (0 after a command)
+ *          2 Repeat    payload: number of extra copies of the last data word
+ *          3 Burst     payload: number of pixels sent but not recorded
+ *          4 Checksum  payload: FNV-1a hash of the words of that burst
+ *          5 Mark      payload: application value (ILI9488_TraceMark())
+ *          6 Reset     payload: none, hardware reset pulse
+ *          7 Vsync     payload: time since the previous command of a TE
+ *                      rising edge seen by ILI9488_WaitForTE()
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_TRACE_H
+#define __ILI9488_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* For uint8_t, uint16_t, uint32_t */
+#include <stdint.h>
+#include "main.h"
+
+/* Dump magic, "ILTR" in little-endian order */
+#define ILI9488_TRACE_MAGIC  0x52544C49
+
+/* Record types */
+#define ILI9488_TRACE_COMMAND   0
+#define ILI9488_TRACE_DATA      1
+#define ILI9488_TRACE_REPEAT    2
+#define ILI9488_TRACE_BURST     3
+#define ILI9488_TRACE_CHECKSUM  4
+#define ILI9488_TRACE_MARK      5
+#define ILI9488_TRACE_RESET     6
+#define ILI9488_TRACE_VSYNC     7
+
+/**
+ * @brief Dump header
+ * @details Followed by size bytes of records, oldest first.
+ */
+typedef struct {
+    uint32_t magic;       ///< ILI9488_TRACE_MAGIC
+    uint16_t version;     ///< Format version, 1
+    uint8_t pixels;       ///< ILI9488_TRACE_PIXELS of the recorder
+    uint8_t wrapped;      ///< 1 if older records were overwritten
+    uint32_t clock_hz;    ///< Rate of the command timestamps
+    uint32_t size;        ///< Number of record bytes that follow
+} ILI9488_TraceHeader_t;
+
+/**
+ * @brief Byte channel for ILI9488_TraceDump()
+ * @param context Channel context
+ * @param data Bytes to send
+ * @param size Number of bytes
+ */
+typedef void (*ILI9488_TraceWriteFn_t)(void *context, const uint8_t *data, uint32_t size);
+
+#ifdef ILI9488_TRACE
+
+/* Ring buffer size in bytes, a power of two */
+#ifndef ILI9488_TRACE_SIZE
+#define ILI9488_TRACE_SIZE  4096
+#endif
+
+#if (ILI9488_TRACE_SIZE & (ILI9488_TRACE_SIZE - 1)) != 0
+#error "ILI9488_TRACE_SIZE must be a power of two"
+#endif
+
+/* 0: pixel bursts are recorded as a count and checksum, 1: every pixel word is recorded */
+#ifndef ILI9488_TRACE_PIXELS
+#define ILI9488_TRACE_PIXELS  0
+#endif
+
+/* Clock of the command timestamps, and its rate in ticks per second */
+#ifndef ILI9488_TRACE_CLOCK
+#define ILI9488_TRACE_CLOCK()     HAL_GetTick()
+#define ILI9488_TRACE_CLOCK_HZ    1000
+#endif
+
+/* Checksum of the burst in progress, updated inline for every pixel */
+extern uint32_t ili9488_trace_checksum;
+
+/**
+ * @brief Record a command
+ * @param cmd Command byte
+ */
+void ILI9488_TraceCommand(uint8_t cmd);
+
+/**
+ * @brief Record a data word (command parameter or pixel)
+ * @param word 18-bit bus word
+ */
+void ILI9488_TraceData(uint32_t word);
+
+/**
+ * @brief Record a run of one data word, latched once and repeated with WR strobes
+ * @param word 18-bit bus word
+ * @param count Number of words (1 or more)
+ */
+void ILI9488_TraceRun(uint32_t word, uint32_t count);
+
+/**
+ * @brief Start a burst of pixel words
+ * @param count Number of words that will follow through ILI9488_TracePixel()
+ */
+void ILI9488_TraceBurst(uint32_t count);
+
+/**
+ * @brief Finish a burst of pixel words
+ */
+void ILI9488_TraceBurstEnd(void);
+
+/**
+ * @brief Record a hardware reset pulse
+ */
+void ILI9488_TraceReset(void);
+
+/**
+ * @brief Record a TE rising edge, the start of the vertical blanking
+ * @details Gives the replay tool the phase of the panel's refresh scan.
+ */
+void ILI9488_TraceVsync(void);
+
+/**
+ * @brief Record one pixel word of a burst
+ * @param word 18-bit bus word
+ */
+static inline void ILI9488_TracePixel(uint32_t word){
+#if ILI9488_TRACE_PIXELS
+    ILI9488_TraceData(word);
+#else
+    ili9488_trace_checksum = (ili9488_trace_checksum ^ word) * 16777619u;
+#endif
+}
+
+/**
+ * @brief Record an application marker, for example a frame number
+ * @param value Marker value
+ * @details The replay tool saves an image at every marker.
+ */
+void ILI9488_TraceMark(uint32_t value);
+
+/**
+ * @brief Pause or resume recording
+ * @param enable 1 to record (the default), 0 to pause
+ */
+void ILI9488_TraceEnable(uint8_t enable);
+
+/**
+ * @brief Drop all recorded bytes
+ */
+void ILI9488_TraceClear(void);
+
+/**
+ * @brief Send the header and the recorded bytes, oldest first
+ * @param write Byte channel
+ * @param context Passed to the channel
+ * @return Number of record bytes sent
+ * @details Recording is paused during the dump. Call it from the same context
+ *          as the drawing code; the recorder is not reentrant.
+ */
+uint32_t ILI9488_TraceDump(ILI9488_TraceWriteFn_t write, void *context);
+
+#else
+
+#define ILI9488_TraceCommand(cmd)     ((void)0)
+#define ILI9488_TraceData(word)       ((void)0)
+#define ILI9488_TraceRun(word, count) ((void)0)
+#define ILI9488_TraceBurst(count)     ((void)0)
+#define ILI9488_TraceBurstEnd()       ((void)0)
+#define ILI9488_TraceReset()          ((void)0)
+#define ILI9488_TraceVsync()          ((void)0)
+#define ILI9488_TracePixel(word)      ((void)0)
+#define ILI9488_TraceMark(value)      ((void)0)
+
+#endif /* ILI9488_TRACE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ILI9488_TRACE_H */
@@ -0,0 +1,214 @@
+/**
+ * @file ili9488_transition.c
+ * @brief ILI9488 screen transition effects
+ * @details This file contains the implementation of page transition effects.
+ *          Instead of repainting the new page from top to bottom in one go,
+ *          the repaint is split into strips or blocks and spread over several
+ *          frames with a fixed bus budget per frame. Each frame starts on the
+ *          TE signal, and the slide effect uses the panel's hardware vertical
+ *          scrolling so the old page moves without any pixel transfers.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include "ili9488_transition.h"
+
+/* Frame memory lines along the panel's scan axis */
+#define TRANSITION_SCAN_LINES  ILI9488_PORTRAIT_HEIGHT
+
+/**
+ * @brief State of the running transition
+ */
+typedef struct {
+    ILI9488_Transition_t effect; ///< Transition effect
+    ILI9488_DrawRegion_t draw;   ///< Callback drawing the new page
+    uint32_t budget;             ///< Pixels repainted per frame
+    uint16_t width;              ///< Display width for the current rotation
+    uint16_t height;             ///< Display height for the current rotation
+    uint16_t progress;           ///< Lines or blocks already repainted
+    uint16_t total;              ///< Lines or blocks to repaint
+    uint16_t stride;             ///< Dissolve block order step (coprime with total)
+    uint8_t rows;                ///< Strips are display rows rather than columns
+    uint8_t reverse;             ///< Repaint from the far edge (wipe) or scroll backwards (slide)
+    uint8_t running;             ///< A transition is in progress
+} ILI9488_TransitionState_t;
+
+static ILI9488_TransitionState_t ili9488_transition;
+
+/**
+ * @brief Greatest common divisor of two values
+ */
+static uint16_t ILI9488_Transition_Gcd(uint16_t a, uint16_t b){
+    while(b){
+        uint16_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/**
+ * @brief Number of strips that fit in the per-frame budget
+ * @param length Pixels per strip
+ * @return Strips per frame (at least 1)
+ */
+static inline uint16_t ILI9488_Transition_Strips(uint32_t length){
+    uint32_t n = ili9488_transition.budget / length;
+    return n ? (uint16_t)(n > 0xFFFF ? 0xFFFF : n) : 1;
+}
+
+/**
+ * @brief Draw a set of strips of the new page
+ * @param start First row or column
+ * @param count Number of rows or columns
+ */
+static void ILI9488_Transition_Strip(uint16_t start, uint16_t count){
+    if(count == 0) return;
+    if(ili9488_transition.rows) ili9488_transition.draw(0, start, ili9488_transition.width, count);
+    else                        ili9488_transition.draw(start, 0, count, ili9488_transition.height);
+}
+
+/**
+ * @brief Start a transition to a new page
+ * @param effect Transition effect
+ * @param direction Direction the effect moves towards
+ * @param draw Callback drawing regions of the new page
+ * @param budget Pixels to repaint per frame (0 for the default budget)
+ * @details Nothing is drawn until the first call to ILI9488_StepTransition().
+ *          For the slide effect the whole panel is configured as a scrolling
+ *          area; the scan axis runs along Y in portrait and X in landscape.
+ */
+void ILI9488_StartTransition(ILI9488_Transition_t effect, ILI9488_Direction_t direction,
+                             ILI9488_DrawRegion_t draw, uint32_t budget){
+    ILI9488_Rotation_t rotation = ILI9488_GetRotation();
+    uint8_t landscape = rotation == ILI9488_ROTATION_LANDSCAPE || rotation == ILI9488_ROTATION_LANDSCAPE_INV;
+    uint8_t inverted = rotation == ILI9488_ROTATION_PORTRAIT_INV || rotation == ILI9488_ROTATION_LANDSCAPE_INV;
+    uint8_t vertical = direction == ILI9488_DIRECTION_UP || direction == ILI9488_DIRECTION_DOWN;
+
+    ili9488_transition.effect = effect;
+    ili9488_transition.draw = draw;
+    ili9488_transition.budget = budget ? budget : ILI9488_TRANSITION_DEFAULT_BUDGET;
+    ili9488_transition.width = landscape ? ILI9488_LANDSCAPE_WIDTH : ILI9488_PORTRAIT_WIDTH;
+    ili9488_transition.height = landscape ? ILI9488_LANDSCAPE_HEIGHT : ILI9488_PORTRAIT_HEIGHT;
+    ili9488_transition.progress = 0;
+    ili9488_transition.running = draw != 0;
+
+    switch(effect){
+        case ILI9488_TRANSITION_WIPE:
+            ili9488_transition.rows = vertical;
+            ili9488_transition.reverse = direction == ILI9488_DIRECTION_UP || direction == ILI9488_DIRECTION_LEFT;
+            ili9488_transition.total = vertical ? ili9488_transition.height : ili9488_transition.width;
+            break;
+        case ILI9488_TRANSITION_CURTAIN:
+            ili9488_transition.rows = vertical;
+            ili9488_transition.reverse = 0;
+            ili9488_transition.total = (uint16_t)((vertical ? ili9488_transition.height : ili9488_transition.width) + 1) / 2;
+            break;
+        case ILI9488_TRANSITION_SLIDE:
+            /* Scrolling the start address forwards moves the image towards
+               line 0 of the scan axis; inverted rotations mirror that axis. */
+            ili9488_transition.rows = !landscape;
+            ili9488_transition.reverse = (direction == ILI9488_DIRECTION_UP || direction == ILI9488_DIRECTION_LEFT) == inverted;
+            ili9488_transition.total = TRANSITION_SCAN_LINES;
+            ILI9488_SetScrollArea(0, TRANSITION_SCAN_LINES, 0);
+            break;
+        default: {
+            uint16_t cols = (ili9488_transition.width + ILI9488_TRANSITION_BLOCK_SIZE - 1) / ILI9488_TRANSITION_BLOCK_SIZE;
+            uint16_t lines = (ili9488_transition.height + ILI9488_TRANSITION_BLOCK_SIZE - 1) / ILI9488_TRANSITION_BLOCK_SIZE;
+            ili9488_transition.effect = ILI9488_TRANSITION_DISSOLVE;
+            ili9488_transition.total = cols * lines;
+            /* Visiting block (i * stride) % total covers every block once when
+               stride and total are coprime, without a shuffle table. */
+            ili9488_transition.stride = (uint16_t)(ili9488_transition.total * 5 / 8 + 1);
+            while(ILI9488_Transition_Gcd(ili9488_transition.stride, ili9488_transition.total) != 1){
+                ili9488_transition.stride++;
+            }
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Advance the running transition by one frame
+ * @return 1 while the transition is running, 0 once the new page is complete
+ * @details Waits for the TE signal, then repaints at most the per-frame
+ *          budget. Strip sizes are derived from the budget, so each frame
+ *          moves the same number of pixels over the bus.
+ */
+uint8_t ILI9488_StepTransition(void){
+    ILI9488_TransitionState_t *t = &ili9488_transition;
+    if(!t->running) return 0;
+
+    ILI9488_WaitForTE();
+
+    switch(t->effect){
+        case ILI9488_TRANSITION_WIPE: {
+            uint16_t n = ILI9488_Transition_Strips(t->rows ? t->width : t->height);
+            if(n > t->total - t->progress) n = t->total - t->progress;
+            ILI9488_Transition_Strip(t->reverse ? t->total - t->progress - n : t->progress, n);
+            t->progress += n;
+            break;
+        }
+        case ILI9488_TRANSITION_CURTAIN: {
+            uint16_t span = t->rows ? t->height : t->width;
+            uint16_t center = span / 2;
+            uint16_t n = ILI9488_Transition_Strips(2 * (uint32_t)(t->rows ? t->width : t->height));
+            if(n > t->total - t->progress) n = t->total - t->progress;
+            /* Lower half grows from the center; the upper half may be one line shorter */
+            uint16_t upper = t->progress < center ? (uint16_t)(center - t->progress) : 0;
+            uint16_t upper_n = n < upper ? n : upper;
+            ILI9488_Transition_Strip(upper - upper_n, upper_n);
+            ILI9488_Transition_Strip(center + t->progress, n);
+            t->progress += n;
+            break;
+        }
+        case ILI9488_TRANSITION_SLIDE: {
+            uint16_t n = ILI9488_Transition_Strips(t->rows ? t->width : t->height);
+            if(n > t->total - t->progress) n = t->total - t->progress;
+            /* Frame memory lines that wrap around the scrolling area this frame */
+            uint16_t line = t->reverse ? (uint16_t)(t->total - t->progress - n) : t->progress;
+            uint16_t start = t->reverse ? line : (uint16_t)((line + n) % t->total);
+            uint8_t inverted = ILI9488_GetRotation() == ILI9488_ROTATION_PORTRAIT_INV ||
+                               ILI9488_GetRotation() == ILI9488_ROTATION_LANDSCAPE_INV;
+            /* Scroll first: the wrapped lines then sit at the far end of the
+               scan, which the panel refreshes last in this frame. */
+            ILI9488_SetScrollStart(start);
+            ILI9488_Transition_Strip(inverted ? (uint16_t)(t->total - line - n) : line, n);
+            t->progress += n;
+            if(t->progress >= t->total) ILI9488_ResetScroll();
+            break;
+        }
+        default: {
+            uint16_t cols = (t->width + ILI9488_TRANSITION_BLOCK_SIZE - 1) / ILI9488_TRANSITION_BLOCK_SIZE;
+            uint16_t n = ILI9488_Transition_Strips((uint32_t)ILI9488_TRANSITION_BLOCK_SIZE * ILI9488_TRANSITION_BLOCK_SIZE);
+            if(n > t->total - t->progress) n = t->total - t->progress;
+            for(uint16_t i = 0; i < n; i++, t->progress++){
+                uint16_t block = (uint16_t)(((uint32_t)t->progress * t->stride) % t->total);
+                uint16_t x = (uint16_t)(block % cols) * ILI9488_TRANSITION_BLOCK_SIZE;
+                uint16_t y = (uint16_t)(block / cols) * ILI9488_TRANSITION_BLOCK_SIZE;
+                uint16_t w = t->width - x < ILI9488_TRANSITION_BLOCK_SIZE ? t->width - x : ILI9488_TRANSITION_BLOCK_SIZE;
+                uint16_t h = t->height - y < ILI9488_TRANSITION_BLOCK_SIZE ? t->height - y : ILI9488_TRANSITION_BLOCK_SIZE;
+                t->draw(x, y, w, h);
+            }
+            break;
+        }
+    }
+
+    if(t->progress >= t->total) t->running = 0;
+    return t->running;
+}
+
+/**
+ * @brief Run a transition to completion
+ * @param effect Transition effect
+ * @param direction Direction the effect moves towards
+ * @param draw Callback drawing regions of the new page
+ * @param budget Pixels to repaint per frame (0 for the default budget)
+ * @details Blocking helper for applications without a frame loop.
+ */
+void ILI9488_RunTransition(ILI9488_Transition_t effect, ILI9488_Direction_t direction,
+                           ILI9488_DrawRegion_t draw, uint32_t budget){
+    ILI9488_StartTransition(effect, direction, draw, budget);
+    while(ILI9488_StepTransition());
+}
@@ -0,0 +1,90 @@
+/**
+ * @file ili9488_transition.h
+ * @brief ILI9488 screen transition effects
+ * @details This header file contains the declarations for page transition
+ *          effects (wipe, slide, curtain and dissolve-by-blocks). A
+ *          transition repaints the new page progressively, a bounded amount
+ *          per frame, so the repaint latency is hidden behind the effect.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_TRANSITION_H
+#define __ILI9488_TRANSITION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* For uint8_t, uint16_t, uint32_t */
+#include <stdint.h>
+#include "ili9488.h"
+
+/* Default per-frame bus budget, in pixels (24 full portrait rows) */
+#define ILI9488_TRANSITION_DEFAULT_BUDGET  (ILI9488_PORTRAIT_WIDTH * 24)
+/* Block size used by the dissolve transition, in pixels */
+#define ILI9488_TRANSITION_BLOCK_SIZE      32
+
+/* Transition effects */
+typedef enum {
+    ILI9488_TRANSITION_WIPE = 0,     ///< New page sweeps in from one edge
+    ILI9488_TRANSITION_SLIDE = 1,    ///< Old page slides out using hardware scrolling
+    ILI9488_TRANSITION_CURTAIN = 2,  ///< New page opens from the center outwards
+    ILI9488_TRANSITION_DISSOLVE = 3  ///< New page appears in scattered blocks
+} ILI9488_Transition_t;
+
+/* Direction the effect moves towards */
+typedef enum {
+    ILI9488_DIRECTION_UP = 0,
+    ILI9488_DIRECTION_DOWN = 1,
+    ILI9488_DIRECTION_LEFT = 2,
+    ILI9488_DIRECTION_RIGHT = 3
+} ILI9488_Direction_t;
+
+/**
+ * @brief Callback drawing part of the new page
+ * @param x Left edge of the region
+ * @param y Top edge of the region
+ * @param w Width of the region
+ * @param h Height of the region
+ * @details The callback must draw every pixel of the region with the new
+ *          page content, using the regular drawing functions.
+ */
+typedef void (*ILI9488_DrawRegion_t)(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+/**
+ * @brief Start a transition to a new page
+ * @param effect Transition effect
+ * @param direction Direction the effect moves towards. Slide transitions
+ *        move along the panel's scan axis only (up/down in portrait,
+ *        left/right in landscape).
+ * @param draw Callback drawing regions of the new page
+ * @param budget Pixels to repaint per frame (0 for the default budget)
+ */
+void ILI9488_StartTransition(ILI9488_Transition_t effect, ILI9488_Direction_t direction,
+                             ILI9488_DrawRegion_t draw, uint32_t budget);
+
+/**
+ * @brief Advance the running transition by one frame
+ * @return 1 while the transition is running, 0 once the new page is complete
+ * @details Call once per frame from the main loop. Each call waits for the
+ *          TE signal and then repaints at most the configured budget.
+ */
+uint8_t ILI9488_StepTransition(void);
+
+/**
+ * @brief Run a transition to completion
+ * @param effect Transition effect
+ * @param direction Direction the effect moves towards
+ * @param draw Callback drawing regions of the new page
+ * @param budget Pixels to repaint per frame (0 for the default budget)
+ */
+void ILI9488_RunTransition(ILI9488_Transition_t effect, ILI9488_Direction_t direction,
+                           ILI9488_DrawRegion_t draw, uint32_t budget);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ILI9488_TRANSITION_H */
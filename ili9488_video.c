@@ -0,0 +1,226 @@
+/**
+ * @file ili9488_video.c
+ * @brief ILI9488 video playback
+ * @details This file contains the implementation of video playback. Frame
+ *          N+1 is read (and for MJPEG decoded) into one frame buffer while
+ *          frame N is sent from the other, so a DMA reader or a hardware JPEG
+ *          codec works in parallel with the bus. Frames are due at fixed
+ *          times from the start of playback; a frame that is still unsent
+ *          when its successor is due is dropped, so a slow stretch does not
+ *          delay the rest of the video; the last frame is always shown.
+ *          With row skipping, a 32-bit hash of every row is compared with
+ *          the row last sent by the same player, and only runs of changed
+ *          rows get an address window.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <stddef.h>
+#include "ili9488_video.h"
+
+/**
+ * @brief Read a block and wait for it
+ * @return 1 if all bytes were read, 0 otherwise
+ */
+static uint8_t ILI9488_Video_Read(const ILI9488_Reader_t *reader, uint32_t offset, void *buffer, uint32_t size){
+    uint32_t got = reader->read(reader->context, offset, buffer, size);
+    if(reader->wait) got = reader->wait(reader->context);
+    return got == size;
+}
+
+/**
+ * @brief Get the size of a raw frame in the source
+ */
+static inline uint32_t ILI9488_Video_RawSize(const ILI9488_Video_t *video){
+    uint32_t pixels = (uint32_t)video->width * video->height;
+    return video->format == ILI9488_VIDEO_RAW565 ? pixels * 2 : pixels * 4;
+}
+
+/**
+ * @brief Start preparing the next frame of the source in a frame buffer
+ * @param video Player
+ * @param index Frame buffer to fill
+ * @return 1 if the frame is being prepared, 0 on an error
+ */
+static uint8_t ILI9488_Video_Start(ILI9488_Video_t *video, uint8_t index){
+    const ILI9488_Reader_t *reader = video->reader;
+
+    if(video->format != ILI9488_VIDEO_MJPEG){
+        uint32_t size = ILI9488_Video_RawSize(video);
+        video->pending = reader->read(reader->context, video->next_offset, video->frames[index], size);
+        video->next_offset += size;
+        return 1;
+    }
+
+    /* MJPEG: fetch the compressed frame, then hand it to the decoder */
+    uint32_t size;
+    if(!ILI9488_Video_Read(reader, video->next_offset, &size, sizeof(size))) return 0;
+    if(size > video->jpeg_capacity) return 0;
+    if(!ILI9488_Video_Read(reader, video->next_offset + sizeof(size), video->jpeg, size)) return 0;
+    video->next_offset += sizeof(size) + size;
+    return video->decode(video->decode_context, video->jpeg, size, video->frames[index], video->width, video->height);
+}
+
+/**
+ * @brief Wait until a frame buffer holds a complete frame of bus words
+ * @param video Player
+ * @param index Frame buffer being filled
+ * @return 1 if the frame is ready, 0 on an error
+ * @details RGB565 frames are expanded in place, from the last pixel down,
+ *          so every 16-bit value is read before its bytes are overwritten.
+ */
+static uint8_t ILI9488_Video_Finish(ILI9488_Video_t *video, uint8_t index){
+    const ILI9488_Reader_t *reader = video->reader;
+
+    if(video->format == ILI9488_VIDEO_MJPEG){
+        return video->decode_wait ? video->decode_wait(video->decode_context) : 1;
+    }
+
+    uint32_t got = reader->wait ? reader->wait(reader->context) : video->pending;
+    if(got != ILI9488_Video_RawSize(video)) return 0;
+
+    if(video->format == ILI9488_VIDEO_RAW565){
+        uint32_t *frame = video->frames[index];
+        const uint16_t *src = (const uint16_t *)frame;
+        for(uint32_t i = (uint32_t)video->width * video->height; i-- > 0;){
+            uint32_t c = src[i];
+            uint32_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+            frame[i] = ((r << 1 | r >> 4) << 12) | (g << 6) | (b << 1 | b >> 4);
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Hash one frame row
+ */
+static inline uint32_t ILI9488_Video_HashRow(const uint32_t *row, uint16_t width){
+    uint32_t hash = 2166136261u;
+    for(uint16_t i = 0; i < width; i++){
+        hash = (hash ^ row[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Send a frame, or only its changed rows
+ * @param video Player
+ * @param frame Frame of bus words
+ */
+static void ILI9488_Video_Send(ILI9488_Video_t *video, const uint32_t *frame){
+    uint16_t w = video->width;
+    uint16_t run_start = 0, run_length = 0;
+
+    for(uint16_t row = 0; row <= video->height; row++){
+        uint8_t changed = 0;
+        if(row < video->height){
+            changed = 1;
+            if(video->skip_unchanged){
+                uint32_t hash = ILI9488_Video_HashRow(frame + (uint32_t)row * w, w);
+                changed = !video->hashes_valid || hash != video->hashes[row];
+                video->hashes[row] = hash;
+            }
+        }
+        if(changed){
+            if(run_length == 0) run_start = row;
+            run_length++;
+            continue;
+        }
+        if(run_length){
+            ILI9488_SetWindow(video->x, video->y + run_start, w, run_length);
+            ILI9488_WriteBus(frame + (uint32_t)run_start * w, (uint32_t)run_length * w);
+            video->stats.rows_sent += run_length;
+            run_length = 0;
+        }
+        if(row < video->height) video->stats.rows_skipped++;
+    }
+    if(video->skip_unchanged) video->hashes_valid = 1;
+}
+
+/**
+ * @brief Start playback
+ * @param video Player with its configuration filled in
+ * @return 1 if playback can start, 0 if the configuration is invalid
+ */
+uint8_t ILI9488_VideoOpen(ILI9488_Video_t *video){
+    if(video->reader == NULL || video->frames[0] == NULL || video->frames[1] == NULL) return 0;
+    if(video->width == 0 || video->height == 0 || video->height > ILI9488_PORTRAIT_HEIGHT) return 0;
+    if(video->format > ILI9488_VIDEO_MJPEG) return 0;
+    if(video->format == ILI9488_VIDEO_MJPEG && (video->decode == NULL || video->jpeg == NULL)) return 0;
+
+    video->stats = (ILI9488_VideoStats_t){0};
+    video->frame = 0;
+    video->next_offset = video->offset;
+    video->current = 0;
+    video->hashes_valid = 0;
+    video->error = 0;
+    video->start_time = ILI9488_VIDEO_CLOCK();
+
+    if(video->frame_count && !ILI9488_Video_Start(video, 0)) video->error = 1;
+    return !video->error;
+}
+
+/**
+ * @brief Show the next frame
+ * @param video Player started with ILI9488_VideoOpen()
+ * @return 1 while frames remain, 0 when playback ended or failed
+ */
+uint8_t ILI9488_VideoStep(ILI9488_Video_t *video){
+    uint8_t drop = 0;
+
+    if(video->error || video->frame >= video->frame_count) return 0;
+    if(!ILI9488_Video_Finish(video, video->current)){
+        video->error = 1;
+        return 0;
+    }
+
+    /* Prepare the following frame in the other buffer while this one is sent */
+    if(video->frame + 1 < video->frame_count && !ILI9488_Video_Start(video, video->current ^ 1)){
+        video->error = 1;
+    }
+
+    if(video->fps){
+        uint32_t due = video->start_time + (uint32_t)((uint64_t)video->frame * ILI9488_VIDEO_CLOCK_HZ / video->fps);
+        uint32_t next_due = video->start_time + (uint32_t)((uint64_t)(video->frame + 1) * ILI9488_VIDEO_CLOCK_HZ / video->fps);
+        /* The last frame has no successor to show instead, so it is never dropped */
+        if(video->frame + 1 < video->frame_count && (int32_t)(ILI9488_VIDEO_CLOCK() - next_due) >= 0) drop = 1;
+        else while((int32_t)(ILI9488_VIDEO_CLOCK() - due) < 0);
+    }
+
+    if(drop){
+        video->stats.frames_dropped++;
+    }
+    else{
+        if(video->sync_te) ILI9488_WaitForTE();
+        uint32_t start = ILI9488_VIDEO_CLOCK();
+        ILI9488_Video_Send(video, video->frames[video->current]);
+        video->stats.bus_time += ILI9488_VIDEO_CLOCK() - start;
+        video->stats.frames_shown++;
+    }
+
+    video->current ^= 1;
+    video->frame++;
+    video->stats.total_time = ILI9488_VIDEO_CLOCK() - video->start_time;
+    return !video->error && video->frame < video->frame_count;
+}
+
+/**
+ * @brief Play a video to the end
+ * @param video Player started with ILI9488_VideoOpen()
+ * @return 1 if every frame was read and decoded, 0 on an error
+ */
+uint8_t ILI9488_VideoPlay(ILI9488_Video_t *video){
+    while(ILI9488_VideoStep(video));
+    return !video->error;
+}
+
+/**
+ * @brief Get the share of playback time spent on the bus
+ * @param video Player
+ * @return Bus utilization in percent (0 to 100)
+ */
+uint8_t ILI9488_VideoBusUtilization(const ILI9488_Video_t *video){
+    if(video->stats.total_time == 0) return 0;
+    return (uint8_t)((uint64_t)video->stats.bus_time * 100 / video->stats.total_time);
+}
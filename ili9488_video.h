@@ -0,0 +1,150 @@
+/**
+ * @file ili9488_video.h
+ * @brief ILI9488 video playback
+ * @details This header file contains the declarations for playing raw
+ *          RGB666/RGB565 frame sequences and MJPEG streams. Frames come
+ *          through an ILI9488_Reader_t and are prepared in one of two
+ *          application-owned frame buffers while the other one is sent, paced
+ *          against a target frame rate and optionally the TE line. Rows that
+ *          did not change since the last shown frame can be skipped.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_VIDEO_H
+#define __ILI9488_VIDEO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* For uint8_t, uint16_t, uint32_t */
+#include <stdint.h>
+#include "ili9488.h"
+#include "ili9488_stream.h"
+
+/* Clock used for pacing and statistics, and its rate in ticks per second */
+#ifndef ILI9488_VIDEO_CLOCK
+#define ILI9488_VIDEO_CLOCK()     HAL_GetTick()
+#define ILI9488_VIDEO_CLOCK_HZ    1000
+#endif
+
+/* Video source formats */
+typedef enum {
+    ILI9488_VIDEO_RAW666 = 0,  ///< Frames of 18-bit bus words (uint32_t per pixel)
+    ILI9488_VIDEO_RAW565 = 1,  ///< Frames of RGB565 values (uint16_t per pixel)
+    ILI9488_VIDEO_MJPEG = 2    ///< JPEG frames, each preceded by its uint32_t byte length
+} ILI9488_VideoFormat_t;
+
+/**
+ * @brief JPEG decode callback
+ * @param context Decoder context
+ * @param jpeg Compressed frame
+ * @param size Size of the compressed frame in bytes
+ * @param frame Output frame, width * height bus words (see ILI9488_COLOR_TO_BUS)
+ * @param width Frame width
+ * @param height Frame height
+ * @return 1 on success (or if the decode was started), 0 on error
+ * @details With a wait callback, the decode may run in the background (for
+ *          example on a hardware JPEG codec) and only has to be finished when
+ *          the wait callback returns.
+ */
+typedef uint8_t (*ILI9488_DecodeFn_t)(void *context, const uint8_t *jpeg, uint32_t size,
+                                      uint32_t *frame, uint16_t width, uint16_t height);
+
+/**
+ * @brief Wait callback of background JPEG decoders
+ * @param context Decoder context
+ * @return 1 if the frame was decoded, 0 on error
+ */
+typedef uint8_t (*ILI9488_DecodeWaitFn_t)(void *context);
+
+/**
+ * @brief Playback statistics
+ * @details Times are in ILI9488_VIDEO_CLOCK ticks.
+ */
+typedef struct {
+    uint32_t frames_shown;    ///< Frames sent to the panel
+    uint32_t frames_dropped;  ///< Frames skipped because playback fell behind
+    uint32_t rows_sent;       ///< Frame rows sent to the panel
+    uint32_t rows_skipped;    ///< Frame rows skipped because they were unchanged
+    uint32_t bus_time;        ///< Time spent sending frames
+    uint32_t total_time;      ///< Time since ILI9488_VideoOpen()
+} ILI9488_VideoStats_t;
+
+/**
+ * @brief Video player
+ * @details The application fills in the configuration fields and calls
+ *          ILI9488_VideoOpen(). The other fields are internal.
+ */
+typedef struct {
+    /* Configuration */
+    const ILI9488_Reader_t *reader;  ///< Video source
+    uint32_t offset;                 ///< Byte offset of the first frame in the source
+    ILI9488_VideoFormat_t format;    ///< Source format
+    uint16_t x;                      ///< Left edge on screen
+    uint16_t y;                      ///< Top edge on screen
+    uint16_t width;                  ///< Frame width
+    uint16_t height;                 ///< Frame height (up to ILI9488_PORTRAIT_HEIGHT)
+    uint32_t frame_count;            ///< Number of frames to play
+    uint16_t fps;                    ///< Target frame rate, 0 to play as fast as possible
+    uint8_t sync_te;                 ///< 1 to start every frame on the TE line
+    uint8_t skip_unchanged;          ///< 1 to send only rows that changed
+    uint32_t *frames[2];             ///< Two frame buffers of width * height words
+    uint8_t *jpeg;                   ///< MJPEG: buffer for one compressed frame
+    uint32_t jpeg_capacity;          ///< MJPEG: size of the jpeg buffer
+    ILI9488_DecodeFn_t decode;       ///< MJPEG: decode callback
+    ILI9488_DecodeWaitFn_t decode_wait; ///< MJPEG: NULL for a synchronous decoder
+    void *decode_context;            ///< MJPEG: passed to the decode callbacks
+
+    /* State */
+    ILI9488_VideoStats_t stats;      ///< Playback statistics
+    uint32_t frame;                  ///< Index of the frame prepared in frames[current]
+    uint32_t next_offset;            ///< Source offset of the next frame to prepare
+    uint32_t pending;                ///< Result of the read or decode in progress
+    uint32_t start_time;             ///< Clock at ILI9488_VideoOpen()
+    uint8_t current;                 ///< Frame buffer holding the frame to show next
+    uint8_t hashes_valid;            ///< Row hashes describe the panel; clear after drawing over the video
+    uint32_t hashes[ILI9488_PORTRAIT_HEIGHT]; ///< Hash of every row last sent by this player
+    uint8_t error;                   ///< Set when a read or decode failed
+} ILI9488_Video_t;
+
+/**
+ * @brief Start playback
+ * @param video Player with its configuration filled in
+ * @return 1 if playback can start, 0 if the configuration is invalid
+ * @details Starts preparing the first frame.
+ */
+uint8_t ILI9488_VideoOpen(ILI9488_Video_t *video);
+
+/**
+ * @brief Show the next frame
+ * @param video Player started with ILI9488_VideoOpen()
+ * @return 1 while frames remain, 0 when playback ended or failed
+ * @details Waits for the frame's due time, starts preparing the following
+ *          frame in the other buffer and sends this one. A frame that is due
+ *          after the next one already is, is dropped instead of sent; the
+ *          last frame of the video is always sent.
+ */
+uint8_t ILI9488_VideoStep(ILI9488_Video_t *video);
+
+/**
+ * @brief Play a video to the end
+ * @param video Player started with ILI9488_VideoOpen()
+ * @return 1 if every frame was read and decoded, 0 on an error
+ */
+uint8_t ILI9488_VideoPlay(ILI9488_Video_t *video);
+
+/**
+ * @brief Get the share of playback time spent on the bus
+ * @param video Player
+ * @return Bus utilization in percent (0 to 100)
+ */
+uint8_t ILI9488_VideoBusUtilization(const ILI9488_Video_t *video);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ILI9488_VIDEO_H */
@@ -0,0 +1,89 @@
+/**
+ * @file ili9488_costtrace.c
+ * @brief Trace hooks feeding the cost model
+ * @details This file contains the trace hooks of ili9488_trace.h for host
+ *          builds, counting the bus traffic with Cost_Word() and Cost_Burst().
+ *          Build the driver with ILI9488_TRACE and ILI9488_TRACE_PIXELS 1, so
+ *          every pixel word of a burst arrives through ILI9488_TraceData().
+ *
+ *          Host_Clock() is the predicted time of the traffic so far, in
+ *          microseconds, plus one microsecond per read of the clock: the
+ *          stand-in for the application's work between polls, so a loop
+ *          waiting for a due time ends.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include "ili9488_trace.h"
+#include "ili9488_costtrace.h"
+
+#if !defined(ILI9488_TRACE) || !ILI9488_TRACE_PIXELS
+#error "Build with ILI9488_TRACE and ILI9488_TRACE_PIXELS 1"
+#endif
+
+uint32_t ili9488_trace_checksum;
+
+static Cost_t host_cost;                       ///< Traffic since the last Host_CostTake()
+static const Cost_Profile_t *host_profile = &cost_profiles[0];
+static Cost_Transport_t host_transport = COST_GPIO;
+static double host_time;                       ///< Microseconds of the traffic taken so far
+static uint32_t host_polls;                    ///< Reads of Host_Clock()
+static uint8_t host_burst;                     ///< 1 between ILI9488_TraceBurst() and its end
+static uint64_t host_latched, host_ones;       ///< Words and 1 bits of the burst in progress
+
+void Host_CostInit(const Cost_Profile_t *profile, Cost_Transport_t transport){
+    Cost_Init(&host_cost);
+    host_profile = profile;
+    host_transport = transport;
+    host_time = 0;
+    host_polls = 0;
+}
+
+void Host_CostTake(Cost_t *cost){
+    *cost = host_cost;
+    host_time += Cost_Microseconds(&host_cost, host_profile, host_transport);
+    Cost_Init(&host_cost);
+}
+
+uint32_t Host_Clock(void){
+    return (uint32_t)(host_time + Cost_Microseconds(&host_cost, host_profile, host_transport)) + host_polls++;
+}
+
+void ILI9488_TraceCommand(uint8_t cmd){
+    Cost_Word(&host_cost, cmd);
+}
+
+void ILI9488_TraceData(uint32_t word){
+    if(!host_burst){
+        Cost_Word(&host_cost, word);
+        return;
+    }
+    host_latched++;
+    host_ones += Cost_Ones(word);
+}
+
+void ILI9488_TraceRun(uint32_t word, uint32_t count){
+    Cost_Burst(&host_cost, 1, Cost_Ones(word), count - 1);
+}
+
+void ILI9488_TraceBurst(uint32_t count){
+    (void)count;
+    host_burst = 1;
+    host_latched = host_ones = 0;
+}
+
+void ILI9488_TraceBurstEnd(void){
+    Cost_Burst(&host_cost, host_latched, host_ones, 0);
+    host_burst = 0;
+}
+
+void ILI9488_TraceReset(void){
+}
+
+void ILI9488_TraceVsync(void){
+}
+
+void ILI9488_TraceMark(uint32_t value){
+    (void)value;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file ili9488_costtrace.h
+ * @brief Trace hooks feeding the cost model
+ * @details This header file contains the declarations for host builds of the
+ *          driver with ILI9488_TRACE and ILI9488_TRACE_PIXELS 1 that price the
+ *          bus traffic while it is sent, with the live tap described in
+ *          ili9488_cost.h, instead of recording it. The predicted time of the
+ *          traffic on one part and transport drives Host_Clock(), so code
+ *          paced by a clock (the video player) sees the bus time it would
+ *          see on the target.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_COSTTRACE_H
+#define __ILI9488_COSTTRACE_H
+
+#include "ili9488_cost.h"
+
+/**
+ * @brief Start counting and pick the part and transport of Host_Clock()
+ * @param profile Part
+ * @param transport Bus transport
+ */
+void Host_CostInit(const Cost_Profile_t *profile, Cost_Transport_t transport);
+
+/**
+ * @brief Take the traffic counted since the last call
+ * @param cost Output: the traffic
+ * @details The counters restart; Host_Clock() keeps the time of the traffic.
+ */
+void Host_CostTake(Cost_t *cost);
+
+#endif /* __ILI9488_COSTTRACE_H */
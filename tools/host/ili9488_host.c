@@ -0,0 +1,34 @@
+/**
+ * @file ili9488_host.c
+ * @brief HAL stand-ins of the host build
+ * @details This file contains the GPIO ports and the clock declared in the
+ *          host main.h, for the test programs in tools/test.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include "main.h"
+
+GPIO_TypeDef host_data, host_control;
+
+/* Milliseconds of delay since the start */
+static uint32_t host_tick;
+
+/**
+ * @brief Advance the host clock
+ * @param ms Milliseconds
+ * @details One more millisecond is added, as the HAL does to guarantee the
+ *          minimum wait.
+ */
+void HAL_Delay(uint32_t ms){
+    host_tick += ms + 1;
+}
+
+/**
+ * @brief Read the host clock
+ * @return Milliseconds of HAL_Delay() since the start
+ */
+uint32_t HAL_GetTick(void){
+    return host_tick;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file ili9488_simtrace.c
+ * @brief Trace hooks feeding the panel simulator
+ * @details This file contains the trace hooks of ili9488_trace.h for host
+ *          builds, forwarding the bus traffic to host_sim. Build the driver
+ *          with ILI9488_TRACE and ILI9488_TRACE_PIXELS 1, so every pixel word
+ *          arrives through ILI9488_TraceData().
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include "ili9488_trace.h"
+#include "ili9488_simtrace.h"
+
+#if !defined(ILI9488_TRACE) || !ILI9488_TRACE_PIXELS
+#error "Build with ILI9488_TRACE and ILI9488_TRACE_PIXELS 1"
+#endif
+
+Sim_t host_sim;
+uint32_t ili9488_trace_checksum;
+
+void ILI9488_TraceCommand(uint8_t cmd){
+    Sim_Command(&host_sim, cmd);
+}
+
+void ILI9488_TraceData(uint32_t word){
+    Sim_Data(&host_sim, word);
+}
+
+void ILI9488_TraceRun(uint32_t word, uint32_t count){
+    Sim_Repeat(&host_sim, word, count);
+}
+
+void ILI9488_TraceBurst(uint32_t count){
+    (void)count;
+}
+
+void ILI9488_TraceBurstEnd(void){
+}
+
+void ILI9488_TraceReset(void){
+    Sim_Reset(&host_sim);
+}
+
+void ILI9488_TraceVsync(void){
+    Sim_Vsync(&host_sim);
+}
+
+void ILI9488_TraceMark(uint32_t value){
+    (void)value;
+}
+
+uint64_t Host_Issues(const Sim_t *sim){
+    uint64_t issues = 0;
+    for(uint32_t i = 0; i < SIM_ISSUES; i++) issues += sim->issues[i];
+    return issues;
+}
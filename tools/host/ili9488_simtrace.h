@@ -0,0 +1,30 @@
+/**
+ * @file ili9488_simtrace.h
+ * @brief Trace hooks feeding the panel simulator
+ * @details This header file contains the declarations for host builds of the
+ *          driver with ILI9488_TRACE and ILI9488_TRACE_PIXELS 1 that implement
+ *          the trace hooks themselves instead of linking ili9488_trace.c:
+ *          every command and data word goes straight into host_sim, so the
+ *          simulated panel memory can be read right after a driver call.
+ *          Marks, the enable switch and the dump are not supported.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_SIMTRACE_H
+#define __ILI9488_SIMTRACE_H
+
+#include "ili9488_sim.h"
+
+/* Panel the driver draws on */
+extern Sim_t host_sim;
+
+/**
+ * @brief Sum the protocol issues found since Sim_Init()
+ * @param sim Panel
+ * @return Number of issues
+ */
+uint64_t Host_Issues(const Sim_t *sim);
+
+#endif /* __ILI9488_SIMTRACE_H */
@@ -0,0 +1,112 @@
+/**
+ * @file main.h
+ * @brief Host stand-in for the STM32CubeMX main.h
+ * @details This header file lets the driver and its modules be built for a
+ *          PC, for the test programs in tools/test. The pins are on two
+ *          dummy GPIO ports whose registers are written and never read, so the
+ *          bit-banged 8080 bus runs without effect; what reaches the panel is
+ *          seen through the trace hooks (ILI9488_TRACE) instead. HAL_Delay()
+ *          and HAL_GetTick() keep a millisecond clock that only the delays
+ *          advance, so recorded traces pass the simulator's timing checks.
+ *          No TE pin is defined, so ILI9488_WaitForTE() returns at once.
+ *          With ILI9488_DMA2D defined, DMA2D is the register model of
+ *          tools/ili9488_dma2d.h, as the CMSIS device header provides it on
+ *          the target.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __MAIN_H
+#define __MAIN_H
+
+/* For uint8_t, uint16_t, uint32_t */
+#include <stdint.h>
+
+/**
+ * @brief GPIO registers used by the driver
+ */
+typedef struct {
+    volatile uint32_t IDR;   ///< Input data
+    volatile uint32_t ODR;   ///< Output data
+    volatile uint32_t BSRR;  ///< Bit set/reset
+} GPIO_TypeDef;
+
+/* DB0-DB15 on one port, DB16, DB17 and the control lines on the other */
+extern GPIO_TypeDef host_data, host_control;
+
+/* Data lines */
+#define DB0_GPIO_Port  (&host_data)
+#define DB0_Pin        0x0001u
+#define DB1_GPIO_Port  (&host_data)
+#define DB1_Pin        0x0002u
+#define DB2_GPIO_Port  (&host_data)
+#define DB2_Pin        0x0004u
+#define DB3_GPIO_Port  (&host_data)
+#define DB3_Pin        0x0008u
+#define DB4_GPIO_Port  (&host_data)
+#define DB4_Pin        0x0010u
+#define DB5_GPIO_Port  (&host_data)
+#define DB5_Pin        0x0020u
+#define DB6_GPIO_Port  (&host_data)
+#define DB6_Pin        0x0040u
+#define DB7_GPIO_Port  (&host_data)
+#define DB7_Pin        0x0080u
+#define DB8_GPIO_Port  (&host_data)
+#define DB8_Pin        0x0100u
+#define DB9_GPIO_Port  (&host_data)
+#define DB9_Pin        0x0200u
+#define DB10_GPIO_Port  (&host_data)
+#define DB10_Pin        0x0400u
+#define DB11_GPIO_Port  (&host_data)
+#define DB11_Pin        0x0800u
+#define DB12_GPIO_Port  (&host_data)
+#define DB12_Pin        0x1000u
+#define DB13_GPIO_Port  (&host_data)
+#define DB13_Pin        0x2000u
+#define DB14_GPIO_Port  (&host_data)
+#define DB14_Pin        0x4000u
+#define DB15_GPIO_Port  (&host_data)
+#define DB15_Pin        0x8000u
+#define DB16_GPIO_Port  (&host_control)
+#define DB16_Pin        0x0001u
+#define DB17_GPIO_Port  (&host_control)
+#define DB17_Pin        0x0002u
+
+/* Control lines */
+#define ILI9488_WR_GPIO_Port     (&host_control)
+#define ILI9488_WR_Pin           0x0004u
+#define ILI9488_CS_GPIO_Port     (&host_control)
+#define ILI9488_CS_Pin           0x0008u
+#define ILI9488_DCX_GPIO_Port    (&host_control)
+#define ILI9488_DCX_Pin          0x0010u
+#define ILI9488_RESET_GPIO_Port  (&host_control)
+#define ILI9488_RESET_Pin        0x0020u
+
+#define __NOP()  ((void)0)
+
+/**
+ * @brief Advance the host clock
+ * @param ms Milliseconds
+ */
+void HAL_Delay(uint32_t ms);
+
+/**
+ * @brief Read the host clock
+ * @return Milliseconds of HAL_Delay() since the start
+ */
+uint32_t HAL_GetTick(void);
+
+/**
+ * @brief Read the clock of the host benches
+ * @return Predicted microseconds of the bus traffic so far (ili9488_costtrace.c)
+ * @details Benches pace the video player with it, built with
+ *          ILI9488_VIDEO_CLOCK() as Host_Clock() at 1000000 Hz.
+ */
+uint32_t Host_Clock(void);
+
+#ifdef ILI9488_DMA2D
+#include "ili9488_dma2d.h"
+#endif
+
+#endif /* __MAIN_H */
@@ -0,0 +1,170 @@
+/**
+ * @file ili9488_cost.c
+ * @brief Host-side Cortex-M cycle cost model of ILI9488 bus traffic
+ * @details This file contains the implementation of the cost model and the
+ *          profiles. A GPIO store costs gpio_store + bus_wait cycles; a word
+ *          on the bit-banged bus is 18 clears, a set per 1 bit, the two stores
+ *          of the strobe, 18 bit tests, the strobe delay and the loop.
+ *
+ *          Build together with the host tool that counts the traffic.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <string.h>
+#include "ili9488_cost.h"
+
+/* Flash: the unrolled ILI9488_Write18() spans about 20 flash lines, its branches defeat the
+   prefetch, and the run loop fits in the prefetch buffer but for its loop branch */
+const Cost_Profile_t cost_profiles[COST_PROFILES] = {
+    /* name   MHz  store wait test strobe loop  fmc beat setup word strobe */
+    { "F4",  168,  1,    1,   1,   2,     4,    6,   6,   120,  10,  1 },  /* GPIO on AHB1, FMC at HCLK; 5 WS, 1 KB ART */
+    { "F7",  216,  1,    2,   1,   2,     3,    8,   8,   160,   6,  1 },  /* Dual issue, DMA setup includes cache cleaning; 7 WS, ART */
+    { "H7",  480,  1,    6,   1,   2,     2,   12,  12,   240,  24,  4 },  /* GPIO behind AXI and AHB4 at a quarter of the core clock; 4 WS at the 240 MHz AXI clock, I-cache off */
+    { "G4",  170,  1,    0,   1,   2,     4,    6,   6,   100,  16,  2 },  /* Single-cycle GPIO on AHB2; 4 WS, 1 KB ART, no I-cache */
+};
+
+static const char *const transport_names[COST_TRANSPORTS] = { "gpio", "fmc", "dma", "flash" };
+
+/**
+ * @brief Clear the traffic counters
+ * @param cost Counters
+ */
+void Cost_Init(Cost_t *cost){
+    memset(cost, 0, sizeof(*cost));
+}
+
+/**
+ * @brief Number of 1 bits of an 18-bit bus word
+ * @param word Bus word
+ * @return 0 to 18
+ */
+uint32_t Cost_Ones(uint32_t word){
+    uint32_t ones = 0;
+    for(word &= 0x3FFFF; word; word &= word - 1) ones++;
+    return ones;
+}
+
+/**
+ * @brief Count a command or parameter word sent on its own
+ * @param cost Counters
+ * @param word 18-bit bus word
+ */
+void Cost_Word(Cost_t *cost, uint32_t word){
+    cost->framed++;
+    cost->framed_ones += Cost_Ones(word);
+}
+
+/**
+ * @brief Count a burst of pixel words sent under one CS framing
+ * @param cost Counters
+ * @param latched Words driven onto the data pins
+ * @param ones 1 bits in those words
+ * @param strobed Words repeating the previous one with a WR strobe only
+ */
+void Cost_Burst(Cost_t *cost, uint64_t latched, uint64_t ones, uint64_t strobed){
+    if(latched + strobed == 0) return;
+    cost->bursts++;
+    cost->latched += latched;
+    cost->latched_ones += ones;
+    cost->strobed += strobed;
+    if(latched + strobed >= COST_DMA_MIN_WORDS){
+        cost->dma_bursts++;
+        cost->dma_words += latched + strobed;
+    }
+}
+
+/**
+ * @brief Add the counters of one traffic to another
+ * @param total Sum, updated
+ * @param cost Counters to add
+ */
+void Cost_Add(Cost_t *total, const Cost_t *cost){
+    total->framed += cost->framed;
+    total->framed_ones += cost->framed_ones;
+    total->bursts += cost->bursts;
+    total->latched += cost->latched;
+    total->latched_ones += cost->latched_ones;
+    total->strobed += cost->strobed;
+    total->dma_bursts += cost->dma_bursts;
+    total->dma_words += cost->dma_words;
+}
+
+/**
+ * @brief Price the traffic in core cycles
+ * @param cost Counters
+ * @param profile Part
+ * @param transport Bus transport
+ * @param cpu Output: cycles the CPU is busy, without DMA beats (may be NULL)
+ * @return Cycles from the first word to the last
+ */
+uint64_t Cost_Cycles(const Cost_t *cost, const Cost_Profile_t *profile, Cost_Transport_t transport, uint64_t *cpu){
+    uint64_t store = profile->gpio_store + profile->bus_wait;
+    uint64_t write = profile->fmc_write + profile->bus_wait + profile->loop;
+    uint64_t words = cost->framed + cost->latched + cost->strobed;
+    uint64_t busy = 0, total = 0;
+
+    switch(transport){
+        case COST_GPIO:
+        case COST_FLASH: {
+            /* 18 clears and the two strobe stores, the sets are counted by the 1 bits */
+            uint64_t latch = 20 * store + 18 * (uint64_t)profile->bit_test + profile->strobe + profile->loop;
+            uint64_t repeat = 2 * store + profile->strobe + profile->loop;
+            if(transport == COST_FLASH){
+                latch += profile->fetch_word;
+                repeat += profile->fetch_strobe;
+            }
+            busy = cost->framed * (3 * store + latch) + cost->framed_ones * store
+                 + cost->bursts * 3 * store
+                 + cost->latched * latch + cost->latched_ones * store
+                 + cost->strobed * repeat;
+            total = busy;
+            break;
+        }
+        case COST_FMC:
+            busy = words * write;
+            total = busy;
+            break;
+        case COST_DMA:
+            busy = (words - cost->dma_words) * write + cost->dma_bursts * profile->dma_setup;
+            total = busy + cost->dma_words * (profile->dma_beat + profile->bus_wait);
+            break;
+        default:
+            break;
+    }
+    if(cpu) *cpu = busy;
+    return total;
+}
+
+/**
+ * @brief Price the traffic in microseconds
+ * @param cost Counters
+ * @param profile Part
+ * @param transport Bus transport
+ * @return Time from the first word to the last, at least COST_WRITE_CYCLE_NS per word
+ */
+double Cost_Microseconds(const Cost_t *cost, const Cost_Profile_t *profile, Cost_Transport_t transport){
+    double us = (double)Cost_Cycles(cost, profile, transport, NULL) / profile->cpu_mhz;
+    double panel = (double)(cost->framed + cost->latched + cost->strobed) * COST_WRITE_CYCLE_NS / 1000.0;
+    return us > panel ? us : panel;
+}
+
+/**
+ * @brief Print the predicted time of the traffic for every profile and transport
+ * @param cost Counters
+ * @param label Name of the traffic (a case or "total")
+ * @param out Destination
+ */
+void Cost_Print(const Cost_t *cost, const char *label, FILE *out){
+    for(uint32_t i = 0; i < COST_PROFILES; i++){
+        const Cost_Profile_t *profile = &cost_profiles[i];
+        uint64_t cpu;
+        Cost_Cycles(cost, profile, COST_DMA, &cpu);
+        fprintf(out, "%-10s %-3s %3u MHz", label, profile->name, (unsigned)profile->cpu_mhz);
+        for(uint32_t t = 0; t < COST_TRANSPORTS; t++){
+            fprintf(out, "  %s %11.1f us", transport_names[t], Cost_Microseconds(cost, profile, (Cost_Transport_t)t));
+        }
+        fprintf(out, "  (dma cpu %.1f us)\n", (double)cpu / profile->cpu_mhz);
+    }
+}
@@ -0,0 +1,172 @@
+/**
+ * @file ili9488_cost.h
+ * @brief Host-side Cortex-M cycle cost model of ILI9488 bus traffic
+ * @details This header file contains the declarations for predicting how long
+ *          the bus traffic of the driver takes on a microcontroller. Host run
+ *          times say little about the target, but the bus words do: every
+ *          word costs a known number of GPIO stores, WR strobes, FMC writes or
+ *          DMA beats, and each of those a number of core cycles that depends
+ *          on the part and its bus matrix. The traffic is counted once with
+ *          Cost_Word() and Cost_Burst() and then priced for every profile and
+ *          transport.
+ *
+ *          Transports:
+ *          COST_GPIO   the bit-banged 18-bit bus of ili9488.c: per word 18
+ *                      BSRR clears, one BSRR set per 1 bit and a WR strobe;
+ *                      CS and DCX stores per word outside bursts, per burst
+ *                      inside; run repeats are a WR strobe only
+ *          COST_FMC    the panel on an FMC bank, one CPU write per word
+ *          COST_DMA    FMC, with bursts of COST_DMA_MIN_WORDS words or more
+ *                      sent by DMA and the CPU waiting for them
+ *          COST_FLASH  the bit-banged bus with its code fetched from flash
+ *                      instead of ITCM/CCM RAM (ILI9488_FAST_SECTION unset)
+ *
+ *          The profile cycle counts are estimates from the reference manuals
+ *          at the listed clocks with zero-wait-state code, and for COST_FLASH
+ *          the wait states the flash accelerator and caches do not hide.
+ *          Calibrate them for a board by timing ILI9488_WriteBus() and
+ *          ILI9488_WriteBusRun() with DWT->CYCCNT, built with and without
+ *          ILI9488_FAST_SECTION.
+ *
+ *          A live tap from the trace hooks of ili9488_trace.h feeds
+ *          ILI9488_TraceCommand() and ILI9488_TraceData() outside a burst to
+ *          Cost_Word(), the words between ILI9488_TraceBurst() and
+ *          ILI9488_TraceBurstEnd() (with ILI9488_TRACE_PIXELS 1) to one
+ *          Cost_Burst(), and ILI9488_TraceRun(word, count) to
+ *          Cost_Burst(cost, 1, ones of word, count - 1).
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_COST_H
+#define __ILI9488_COST_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/* Shortest burst worth programming a DMA transfer for, shorter ones are written by the CPU */
+#ifndef COST_DMA_MIN_WORDS
+#define COST_DMA_MIN_WORDS  16
+#endif
+
+/* Write cycle of the panel in nanoseconds, the fastest any transport can send words */
+#ifndef COST_WRITE_CYCLE_NS
+#define COST_WRITE_CYCLE_NS  30
+#endif
+
+/**
+ * @brief Bus transports
+ */
+typedef enum {
+    COST_GPIO = 0,             ///< Bit-banged 18-bit bus (ili9488.c)
+    COST_FMC,                  ///< FMC bank, CPU writes
+    COST_DMA,                  ///< FMC bank, DMA for bursts
+    COST_FLASH,                ///< Bit-banged bus, code in flash
+    COST_TRANSPORTS
+} Cost_Transport_t;
+
+/**
+ * @brief Cycle costs of one part, in core cycles
+ */
+typedef struct {
+    const char *name;          ///< Part family
+    uint32_t cpu_mhz;          ///< Core clock
+    uint8_t gpio_store;        ///< BSRR store, issued back to back
+    uint8_t bus_wait;          ///< Wait cycles added to every GPIO store, FMC write and DMA beat
+    uint8_t bit_test;          ///< Test of one data bit before its BSRR set
+    uint8_t strobe;            ///< WR strobe besides its two stores (the NOPs)
+    uint8_t loop;              ///< Loop, load and call overhead per word
+    uint8_t fmc_write;         ///< FMC write with the address, data and WR phases of a typical panel timing
+    uint8_t dma_beat;          ///< DMA beat from SRAM to the FMC
+    uint16_t dma_setup;        ///< Programming a DMA transfer and taking its interrupt
+    uint8_t fetch_word;        ///< Flash wait cycles per word driven by ILI9488_Write18() running from flash
+    uint8_t fetch_strobe;      ///< Flash wait cycles per WR strobe of a run running from flash
+} Cost_Profile_t;
+
+/**
+ * @brief Bus traffic, counted once and priced per profile
+ */
+typedef struct {
+    uint64_t framed;           ///< Commands and parameters, each with its own CS and DCX stores
+    uint64_t framed_ones;      ///< 1 bits in them
+    uint64_t bursts;           ///< Bursts, each with one CS and DCX framing
+    uint64_t latched;          ///< Burst words driven onto the data pins
+    uint64_t latched_ones;     ///< 1 bits in them
+    uint64_t strobed;          ///< Burst words repeating the pins with a WR strobe only
+    uint64_t dma_bursts;       ///< Bursts of COST_DMA_MIN_WORDS words or more
+    uint64_t dma_words;        ///< Words in them
+} Cost_t;
+
+/* Number of profiles in cost_profiles */
+#define COST_PROFILES  4
+
+/**
+ * @brief Profiles of common parts at typical clocks: F4, F7, H7 and G4
+ */
+extern const Cost_Profile_t cost_profiles[COST_PROFILES];
+
+/**
+ * @brief Clear the traffic counters
+ * @param cost Counters
+ */
+void Cost_Init(Cost_t *cost);
+
+/**
+ * @brief Count a command or parameter word sent on its own
+ * @param cost Counters
+ * @param word 18-bit bus word
+ */
+void Cost_Word(Cost_t *cost, uint32_t word);
+
+/**
+ * @brief Count a burst of pixel words sent under one CS framing
+ * @param cost Counters
+ * @param latched Words driven onto the data pins
+ * @param ones 1 bits in those words
+ * @param strobed Words repeating the previous one with a WR strobe only
+ */
+void Cost_Burst(Cost_t *cost, uint64_t latched, uint64_t ones, uint64_t strobed);
+
+/**
+ * @brief Add the counters of one traffic to another
+ * @param total Sum, updated
+ * @param cost Counters to add
+ */
+void Cost_Add(Cost_t *total, const Cost_t *cost);
+
+/**
+ * @brief Number of 1 bits of an 18-bit bus word
+ * @param word Bus word
+ * @return 0 to 18
+ */
+uint32_t Cost_Ones(uint32_t word);
+
+/**
+ * @brief Price the traffic in core cycles
+ * @param cost Counters
+ * @param profile Part
+ * @param transport Bus transport
+ * @param cpu Output: cycles the CPU is busy, without DMA beats (may be NULL)
+ * @return Cycles from the first word to the last
+ */
+uint64_t Cost_Cycles(const Cost_t *cost, const Cost_Profile_t *profile, Cost_Transport_t transport, uint64_t *cpu);
+
+/**
+ * @brief Price the traffic in microseconds
+ * @param cost Counters
+ * @param profile Part
+ * @param transport Bus transport
+ * @return Time from the first word to the last, at least COST_WRITE_CYCLE_NS per word
+ */
+double Cost_Microseconds(const Cost_t *cost, const Cost_Profile_t *profile, Cost_Transport_t transport);
+
+/**
+ * @brief Print the predicted time of the traffic for every profile and transport
+ * @param cost Counters
+ * @param label Name of the traffic (a case or "total")
+ * @param out Destination
+ */
+void Cost_Print(const Cost_t *cost, const char *label, FILE *out);
+
+#endif /* __ILI9488_COST_H */
@@ -0,0 +1,64 @@
+/**
+ * @file ili9488_dma2d.h
+ * @brief Host-side model of the DMA2D (Chrom-ART) registers
+ * @details This header file contains a stand-in for the CMSIS DMA2D
+ *          definitions, so ili9488_canvas.c can be built for a PC with
+ *          ILI9488_DMA2D and its register programming checked against the
+ *          software path. Include it from the main.h of the host build. The
+ *          canvas code calls ILI9488_DMA2D_HOOK() after setting START, which
+ *          runs the transfer in Dma2d_Run() as the hardware would and clears
+ *          START.
+ *
+ *          The model covers what the canvas code uses: the four transfer
+ *          modes, the ARGB8888, RGB888 and RGB565 color modes, line offsets,
+ *          and the alpha modes of the foreground. Address registers hold host
+ *          pointers, so they are as wide as a pointer.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_DMA2D_H
+#define __ILI9488_DMA2D_H
+
+#include <stdint.h>
+
+#define DMA2D_CR_START    0x00000001u
+#define DMA2D_ISR_TCIF    0x00000002u
+
+/**
+ * @brief DMA2D registers, in the order of the reference manual
+ */
+typedef struct {
+    volatile uint32_t CR;         ///< Control: MODE and START
+    volatile uint32_t ISR;        ///< Interrupt status
+    volatile uint32_t IFCR;       ///< Interrupt flag clear
+    volatile uintptr_t FGMAR;     ///< Foreground memory address
+    volatile uint32_t FGOR;       ///< Foreground line offset in pixels
+    volatile uintptr_t BGMAR;     ///< Background memory address
+    volatile uint32_t BGOR;       ///< Background line offset in pixels
+    volatile uint32_t FGPFCCR;    ///< Foreground color mode, alpha mode and alpha
+    volatile uint32_t FGCOLR;     ///< Foreground color (A4/A8/L modes only, not modelled)
+    volatile uint32_t BGPFCCR;    ///< Background color mode, alpha mode and alpha
+    volatile uint32_t BGCOLR;     ///< Background color (not modelled)
+    volatile uint32_t OPFCCR;     ///< Output color mode
+    volatile uint32_t OCOLR;      ///< Output color of register-to-memory transfers, in the output format
+    volatile uintptr_t OMAR;      ///< Output memory address
+    volatile uint32_t OOR;        ///< Output line offset in pixels
+    volatile uint32_t NLR;        ///< Pixels per line (bits 29-16) and lines (bits 15-0)
+} DMA2D_TypeDef;
+
+extern DMA2D_TypeDef dma2d_model;
+extern uint32_t dma2d_transfers[4];  ///< Transfers run, per mode
+
+#define DMA2D  (&dma2d_model)
+
+/**
+ * @brief Run the transfer programmed in the registers, if START is set
+ * @param regs Registers
+ */
+void Dma2d_Run(DMA2D_TypeDef *regs);
+
+#define ILI9488_DMA2D_HOOK()  Dma2d_Run(DMA2D)
+
+#endif /* __ILI9488_DMA2D_H */
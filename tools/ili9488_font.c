@@ -0,0 +1,533 @@
+/**
+ * @file ili9488_font.c
+ * @brief Host-side font converter for the ILI9488 driver
+ * @details This command line tool converts BDF bitmap fonts into the
+ *          compressed font format drawn by ILI9488_DrawText() (see
+ *          ili9488_font.h). Glyphs are trimmed to their ink box and stored as
+ *          background, foreground and alpha runs. A large BDF font can be
+ *          downsampled by an integer factor into 4-bit anti-aliased glyphs.
+ *
+ *          Build:  cc -O2 -o ili9488_font tools/ili9488_font.c
+ *          Usage:  ili9488_font [options] (-c out.c -n name | -o out.bin) font.bdf
+ *
+ *          -b 1|4          Alpha depth (default 1, or 4 when downsampling)
+ *          -d N            Downsample by N (coverage becomes alpha)
+ *          -r FIRST-LAST   Keep only these code points (repeatable)
+ *          -k FILE         Kerning pairs, one "left right adjust" per line:
+ *                          two code points and the advance adjustment in
+ *                          output pixels (# starts a comment)
+ *
+ *          Glyphs with a negative left bearing are shifted right to start at
+ *          the cell's left edge, and ink outside the line height is cropped.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FONT_MAGIC     0x4E464C49u /* "ILFN" */
+#define MAX_SELECT     64
+#define MAX_RUN        64
+
+/**
+ * @brief Glyph loaded from the BDF file, in source pixels
+ */
+typedef struct {
+    uint32_t codepoint;
+    int32_t advance;
+    int32_t width, height, x_offset, y_offset;
+    uint8_t *bits;       ///< width * height, 1 for ink
+} Source_t;
+
+/**
+ * @brief Converted glyph
+ */
+typedef struct {
+    uint32_t codepoint;
+    uint32_t offset;
+    uint8_t width, height, advance, x_offset, y_offset;
+} Glyph_t;
+
+/**
+ * @brief Kerning pair
+ */
+typedef struct {
+    uint32_t left, right;  ///< Code points while loading, glyph indices once resolved
+    int32_t adjust;
+} Kern_t;
+
+/**
+ * @brief Run of consecutive code points
+ */
+typedef struct {
+    uint32_t first;   ///< First code point
+    uint32_t glyph;   ///< Index of its glyph
+    uint16_t length;  ///< Code points in the run
+} Range_t;
+
+/**
+ * @brief Growable byte buffer
+ */
+typedef struct {
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+} Buffer_t;
+
+static void Fail(const char *message, const char *detail){
+    fprintf(stderr, "ili9488_font: %s%s%s\n", message, detail ? ": " : "", detail ? detail : "");
+    exit(1);
+}
+
+static void Buffer_Append(Buffer_t *b, const void *data, size_t size){
+    if(b->size + size > b->capacity){
+        size_t capacity = b->capacity ? b->capacity : 1024;
+        while(capacity < b->size + size) capacity *= 2;
+        b->data = realloc(b->data, capacity);
+        if(!b->data) Fail("out of memory", NULL);
+        b->capacity = capacity;
+    }
+    if(data) memcpy(b->data + b->size, data, size);
+    else     memset(b->data + b->size, 0, size);
+    b->size += size;
+}
+
+static void Buffer_Byte(Buffer_t *b, uint8_t byte){
+    Buffer_Append(b, &byte, 1);
+}
+
+static void Buffer_Half(Buffer_t *b, uint16_t half){
+    uint8_t bytes[2] = {(uint8_t)half, (uint8_t)(half >> 8)};
+    Buffer_Append(b, bytes, 2);
+}
+
+static void Buffer_Word(Buffer_t *b, uint32_t word){
+    uint8_t bytes[4] = {(uint8_t)word, (uint8_t)(word >> 8), (uint8_t)(word >> 16), (uint8_t)(word >> 24)};
+    Buffer_Append(b, bytes, 4);
+}
+
+static int Compare_Sources(const void *a, const void *b){
+    uint32_t ca = ((const Source_t *)a)->codepoint, cb = ((const Source_t *)b)->codepoint;
+    return ca < cb ? -1 : ca > cb;
+}
+
+/**
+ * @brief Load the glyphs of a BDF font
+ * @param path BDF file
+ * @param ascent Receives the font ascent
+ * @param descent Receives the font descent
+ * @param count Receives the number of glyphs
+ * @return Glyphs in file order
+ */
+static Source_t *Load_BDF(const char *path, int32_t *ascent, int32_t *descent, uint32_t *count){
+    FILE *f = fopen(path, "r");
+    char line[1024];
+    Source_t *glyphs = NULL, glyph;
+    uint32_t capacity = 0;
+    int32_t encoding = -1, row = -1, box_h = 0, box_y = 0;
+    uint8_t have_ascent = 0, have_descent = 0;
+
+    if(!f) Fail("cannot open", path);
+    *count = 0;
+    memset(&glyph, 0, sizeof(glyph));
+    while(fgets(line, sizeof(line), f)){
+        if(row >= 0){
+            if(!strncmp(line, "ENDCHAR", 7)){
+                if(encoding >= 0){
+                    if(*count == capacity){
+                        capacity = capacity ? capacity * 2 : 256;
+                        glyphs = realloc(glyphs, capacity * sizeof(Source_t));
+                        if(!glyphs) Fail("out of memory", NULL);
+                    }
+                    glyph.codepoint = (uint32_t)encoding;
+                    glyphs[(*count)++] = glyph;
+                }
+                else free(glyph.bits);
+                memset(&glyph, 0, sizeof(glyph));
+                row = -1;
+            }
+            else if(row < glyph.height){
+                /* Hex row, most significant bit first */
+                for(int32_t x = 0; x < glyph.width; x++){
+                    char hex = line[x / 4];
+                    int32_t nibble = hex >= 'a' ? hex - 'a' + 10 : hex >= 'A' ? hex - 'A' + 10 : hex - '0';
+                    if(nibble < 0 || nibble > 15) Fail("invalid BITMAP row", path);
+                    glyph.bits[row * glyph.width + x] = (uint8_t)((nibble >> (3 - x % 4)) & 1);
+                }
+                row++;
+            }
+            continue;
+        }
+        if(sscanf(line, "FONT_ASCENT %d", ascent) == 1) have_ascent = 1;
+        else if(sscanf(line, "FONT_DESCENT %d", descent) == 1) have_descent = 1;
+        else if(!strncmp(line, "FONTBOUNDINGBOX", 15)){
+            int32_t w, x;
+            if(sscanf(line + 15, "%d %d %d %d", &w, &box_h, &x, &box_y) != 4) Fail("invalid FONTBOUNDINGBOX", path);
+        }
+        else if(!strncmp(line, "STARTCHAR", 9)){
+            memset(&glyph, 0, sizeof(glyph));
+            encoding = -1;
+        }
+        else if(sscanf(line, "ENCODING %d", &encoding) == 1){}
+        else if(sscanf(line, "DWIDTH %d", &glyph.advance) == 1){}
+        else if(!strncmp(line, "BBX", 3)){
+            if(sscanf(line + 3, "%d %d %d %d", &glyph.width, &glyph.height, &glyph.x_offset, &glyph.y_offset) != 4){
+                Fail("invalid BBX", path);
+            }
+            if(glyph.width < 0 || glyph.height < 0 || glyph.width > 1024 || glyph.height > 1024) Fail("invalid BBX", path);
+        }
+        else if(!strncmp(line, "BITMAP", 6)){
+            glyph.bits = calloc((size_t)glyph.width * glyph.height + 1, 1);
+            if(!glyph.bits) Fail("out of memory", NULL);
+            row = 0;
+        }
+    }
+    fclose(f);
+    if(!have_ascent) *ascent = box_h + box_y;
+    if(!have_descent) *descent = -box_y;
+    if(*ascent + *descent <= 0) Fail("font has no height", path);
+    return glyphs;
+}
+
+/**
+ * @brief Append the run codes of one glyph box
+ * @param data Glyph data
+ * @param levels width * height alpha levels (0 to 15), row by row
+ * @param count Number of levels
+ */
+static void Encode_Runs(Buffer_t *data, const uint8_t *levels, uint32_t count){
+    for(uint32_t i = 0; i < count;){
+        uint8_t level = levels[i];
+        uint32_t n = 1;
+        if(level == 0 || level == 15){
+            while(i + n < count && n < MAX_RUN && levels[i + n] == level) n++;
+            if(level == 0 && n <= 8 && i + n < count && levels[i + n] == 15){
+                /* Short background run followed by a short foreground run */
+                uint32_t m = 1;
+                while(i + n + m < count && m < 8 && levels[i + n + m] == 15) m++;
+                Buffer_Byte(data, (uint8_t)(0xC0 | (n - 1) << 3 | (m - 1)));
+                i += n + m;
+                continue;
+            }
+            Buffer_Byte(data, (uint8_t)((level ? 0x40 : 0x00) | (n - 1)));
+        }
+        else{
+            while(i + n < count && n < MAX_RUN && levels[i + n] != 0 && levels[i + n] != 15) n++;
+            Buffer_Byte(data, (uint8_t)(0x80 | (n - 1)));
+            for(uint32_t k = 0; k < n; k += 2){
+                uint8_t low = k + 1 < n ? levels[i + k + 1] : 0;
+                Buffer_Byte(data, (uint8_t)(levels[i + k] << 4 | low));
+            }
+        }
+        i += n;
+    }
+}
+
+/**
+ * @brief Convert one source glyph
+ * @param source BDF glyph
+ * @param ascent Font ascent in source pixels
+ * @param line_height Cell height in output pixels
+ * @param scale Downsampling factor
+ * @param bpp Alpha depth (1 or 4)
+ * @param data Glyph data to append to
+ * @return Converted glyph metrics
+ */
+static Glyph_t Convert_Glyph(const Source_t *source, int32_t ascent, int32_t line_height,
+                             int32_t scale, uint8_t bpp, Buffer_t *data){
+    Glyph_t glyph = {source->codepoint, (uint32_t)data->size, 0, 0, 0, 0, 0};
+    int32_t sx = source->x_offset < 0 ? 0 : source->x_offset;       /* Box left in the cell */
+    int32_t sy = ascent - (source->y_offset + source->height);       /* Box top in the cell */
+    int32_t cell_w = (sx + source->width + scale - 1) / scale;
+    int32_t area = scale * scale;
+    int32_t advance = (source->advance + scale / 2) / scale;
+    int32_t x0 = cell_w, y0 = line_height, x1 = 0, y1 = 0;
+
+    if(advance > 255 || cell_w > 255) Fail("glyph wider than 255 pixels", NULL);
+    glyph.advance = (uint8_t)(advance < 0 ? 0 : advance);
+
+    /* Coverage of every output pixel of the cell */
+    uint8_t *levels = calloc((size_t)(cell_w ? cell_w : 1) * line_height, 1);
+    if(!levels) Fail("out of memory", NULL);
+    for(int32_t y = 0; y < line_height; y++){
+        for(int32_t x = 0; x < cell_w; x++){
+            int32_t ink = 0;
+            for(int32_t v = 0; v < scale; v++){
+                for(int32_t u = 0; u < scale; u++){
+                    int32_t gx = x * scale + u - sx, gy = y * scale + v - sy;
+                    if(gx >= 0 && gy >= 0 && gx < source->width && gy < source->height){
+                        ink += source->bits[gy * source->width + gx];
+                    }
+                }
+            }
+            uint8_t level = bpp == 4 ? (uint8_t)((ink * 15 + area / 2) / area) : (ink * 2 >= area ? 15 : 0);
+            levels[y * cell_w + x] = level;
+            if(level){
+                if(x < x0) x0 = x;
+                if(y < y0) y0 = y;
+                if(x + 1 > x1) x1 = x + 1;
+                if(y + 1 > y1) y1 = y + 1;
+            }
+        }
+    }
+
+    /* Trim to the ink box and encode it */
+    if(x1 > x0 && y1 > y0){
+        uint32_t w = (uint32_t)(x1 - x0), h = (uint32_t)(y1 - y0);
+        uint8_t *box = malloc(w * h);
+        if(!box) Fail("out of memory", NULL);
+        for(uint32_t y = 0; y < h; y++){
+            memcpy(box + y * w, levels + (y0 + y) * cell_w + x0, w);
+        }
+        Encode_Runs(data, box, w * h);
+        free(box);
+        glyph.width = (uint8_t)w;
+        glyph.height = (uint8_t)h;
+        glyph.x_offset = (uint8_t)x0;
+        glyph.y_offset = (uint8_t)y0;
+    }
+    free(levels);
+    return glyph;
+}
+
+/**
+ * @brief Load a kerning pair list
+ */
+static Kern_t *Load_Kerning(const char *path, uint32_t *count){
+    FILE *f = fopen(path, "r");
+    char line[256];
+    Kern_t *kerns = NULL;
+    uint32_t capacity = 0;
+
+    if(!f) Fail("cannot open", path);
+    *count = 0;
+    while(fgets(line, sizeof(line), f)){
+        char *p = line, *end;
+        Kern_t kern;
+        while(*p == ' ' || *p == '\t') p++;
+        if(*p == '#' || *p == '\n' || *p == '\r' || *p == 0) continue;
+        kern.left = (uint32_t)strtoul(p, &end, 0);
+        if(end == p) Fail("bad kerning line", line);
+        kern.right = (uint32_t)strtoul(p = end, &end, 0);
+        if(end == p) Fail("bad kerning line", line);
+        kern.adjust = (int32_t)strtol(p = end, &end, 0);
+        if(end == p) Fail("bad kerning line", line);
+        if(kern.adjust < -32768 || kern.adjust > 32767) Fail("kerning adjustment out of range", line);
+        if(*count == capacity){
+            capacity = capacity ? capacity * 2 : 256;
+            kerns = realloc(kerns, capacity * sizeof(Kern_t));
+            if(!kerns) Fail("out of memory", NULL);
+        }
+        kerns[(*count)++] = kern;
+    }
+    fclose(f);
+    return kerns;
+}
+
+static int Compare_Kerns(const void *a, const void *b){
+    const Kern_t *ka = a, *kb = b;
+    if(ka->left != kb->left) return ka->left < kb->left ? -1 : 1;
+    if(ka->right != kb->right) return ka->right < kb->right ? -1 : 1;
+    return 0;
+}
+
+/**
+ * @brief Find the glyph index of a code point
+ * @return Glyph index, or -1 if the font has no such glyph
+ */
+static int32_t Find_Glyph(const Glyph_t *glyphs, uint32_t count, uint32_t codepoint){
+    uint32_t lo = 0, hi = count;
+    while(lo < hi){
+        uint32_t mid = (lo + hi) / 2;
+        if(glyphs[mid].codepoint < codepoint) lo = mid + 1;
+        else hi = mid;
+    }
+    return (lo < count && glyphs[lo].codepoint == codepoint) ? (int32_t)lo : -1;
+}
+
+/**
+ * @brief Turn kerning code points into glyph indices and sort the pairs
+ * @return Number of pairs kept; pairs of glyphs not in the font are dropped
+ */
+static uint32_t Resolve_Kerning(Kern_t *kerns, uint32_t count, const Glyph_t *glyphs, uint32_t glyph_count){
+    uint32_t kept = 0;
+    for(uint32_t i = 0; i < count; i++){
+        int32_t left = Find_Glyph(glyphs, glyph_count, kerns[i].left);
+        int32_t right = Find_Glyph(glyphs, glyph_count, kerns[i].right);
+        if(left < 0 || right < 0 || kerns[i].adjust == 0) continue;
+        kerns[kept].left = (uint32_t)left;
+        kerns[kept].right = (uint32_t)right;
+        kerns[kept++].adjust = kerns[i].adjust;
+    }
+    qsort(kerns, kept, sizeof(Kern_t), Compare_Kerns);
+    for(uint32_t i = 1; i < kept; i++){
+        if(kerns[i].left == kerns[i - 1].left && kerns[i].right == kerns[i - 1].right){
+            Fail("duplicate kerning pair", NULL);
+        }
+    }
+    if(kept > 0xFFFF) Fail("more than 65535 kerning pairs", NULL);
+    return kept;
+}
+
+/**
+ * @brief Build the font blob
+ */
+static Buffer_t Build_Font(const Glyph_t *glyphs, uint32_t count, const Kern_t *kerns, uint32_t kern_count,
+                           uint8_t bpp, uint16_t line_height, uint16_t baseline, const Buffer_t *data){
+    Buffer_t font = {0};
+    Range_t *ranges = NULL;
+    uint32_t range_count = 0, capacity = 0;
+
+    for(uint32_t i = 0; i < count; i++){
+        if(range_count && glyphs[i].codepoint == ranges[range_count - 1].first + ranges[range_count - 1].length){
+            ranges[range_count - 1].length++;
+            continue;
+        }
+        if(range_count == capacity){
+            capacity = capacity ? capacity * 2 : 64;
+            ranges = realloc(ranges, capacity * sizeof(Range_t));
+            if(!ranges) Fail("out of memory", NULL);
+        }
+        ranges[range_count].first = glyphs[i].codepoint;
+        ranges[range_count].glyph = i;
+        ranges[range_count++].length = 1;
+    }
+
+    Buffer_Word(&font, FONT_MAGIC);
+    Buffer_Byte(&font, bpp);
+    Buffer_Byte(&font, 0);
+    Buffer_Half(&font, line_height);
+    Buffer_Half(&font, baseline);
+    Buffer_Half(&font, (uint16_t)range_count);
+    Buffer_Half(&font, (uint16_t)count);
+    Buffer_Half(&font, (uint16_t)kern_count);
+    Buffer_Word(&font, (uint32_t)((data->size + 3) & ~(size_t)3));
+    for(uint32_t i = 0; i < range_count; i++){
+        Buffer_Word(&font, ranges[i].first);
+        Buffer_Half(&font, ranges[i].length);
+        Buffer_Half(&font, (uint16_t)ranges[i].glyph);
+    }
+    free(ranges);
+    for(uint32_t i = 0; i < count; i++){
+        Buffer_Word(&font, glyphs[i].offset);
+        Buffer_Byte(&font, glyphs[i].width);
+        Buffer_Byte(&font, glyphs[i].height);
+        Buffer_Byte(&font, glyphs[i].advance);
+        Buffer_Byte(&font, glyphs[i].x_offset);
+        Buffer_Byte(&font, glyphs[i].y_offset);
+        Buffer_Append(&font, NULL, 3);
+    }
+    for(uint32_t i = 0; i < kern_count; i++){
+        Buffer_Word(&font, kerns[i].left << 16 | kerns[i].right);
+        Buffer_Half(&font, (uint16_t)(int16_t)kerns[i].adjust);
+        Buffer_Half(&font, 0);
+    }
+    Buffer_Append(&font, data->data, data->size);
+    while(font.size % 4) Buffer_Byte(&font, 0);
+    return font;
+}
+
+static void Usage(void){
+    fprintf(stderr,
+            "usage: ili9488_font [options] (-c out.c -n name | -o out.bin) font.bdf\n"
+            "  -b 1|4         alpha depth (default 1, or 4 when downsampling)\n"
+            "  -d N           downsample by N, coverage becomes alpha\n"
+            "  -r FIRST-LAST  keep only these code points (repeatable)\n"
+            "  -k FILE        kerning pairs, \"left right adjust\" per line\n");
+    exit(2);
+}
+
+int main(int argc, char **argv){
+    const char *c_path = NULL, *bin_path = NULL, *name = "font", *bdf_path = NULL, *kern_path = NULL;
+    uint32_t select_first[MAX_SELECT], select_last[MAX_SELECT], select_count = 0;
+    int32_t scale = 1, bpp = 0;
+
+    for(int i = 1; i < argc; i++){
+        const char *arg = argv[i];
+        if(arg[0] == '-' && arg[1] && !arg[2] && i + 1 < argc){
+            const char *value = argv[++i];
+            char *end;
+            switch(arg[1]){
+                case 'c': c_path = value; break;
+                case 'o': bin_path = value; break;
+                case 'n': name = value; break;
+                case 'b': bpp = atoi(value); break;
+                case 'd': scale = atoi(value); break;
+                case 'k': kern_path = value; break;
+                case 'r':
+                    if(select_count == MAX_SELECT) Fail("too many -r options", NULL);
+                    select_first[select_count] = (uint32_t)strtoul(value, &end, 0);
+                    select_last[select_count] = *end == '-' ? (uint32_t)strtoul(end + 1, NULL, 0) : select_first[select_count];
+                    select_count++;
+                    break;
+                default: Usage();
+            }
+            continue;
+        }
+        if(bdf_path) Usage();
+        bdf_path = arg;
+    }
+    if(!bdf_path || (!c_path && !bin_path)) Usage();
+    if(scale < 1 || scale > 16) Fail("downsampling factor must be 1 to 16", NULL);
+    if(bpp == 0) bpp = scale > 1 ? 4 : 1;
+    if(bpp != 1 && bpp != 4) Fail("alpha depth must be 1 or 4", NULL);
+
+    int32_t ascent, descent;
+    uint32_t source_count, count = 0;
+    Source_t *sources = Load_BDF(bdf_path, &ascent, &descent, &source_count);
+    qsort(sources, source_count, sizeof(Source_t), Compare_Sources);
+
+    int32_t line_height = (ascent + descent + scale - 1) / scale;
+    if(line_height > 255) Fail("line height above 255 pixels", NULL);
+    Glyph_t *glyphs = calloc(source_count ? source_count : 1, sizeof(Glyph_t));
+    Buffer_t data = {0};
+    size_t raw_bytes = 0;
+    for(uint32_t i = 0; i < source_count; i++){
+        uint8_t keep = select_count == 0;
+        for(uint32_t r = 0; r < select_count && !keep; r++){
+            keep = sources[i].codepoint >= select_first[r] && sources[i].codepoint <= select_last[r];
+        }
+        if(!keep || (count && glyphs[count - 1].codepoint == sources[i].codepoint)) continue;
+        glyphs[count] = Convert_Glyph(&sources[i], ascent, line_height, scale, (uint8_t)bpp, &data);
+        raw_bytes += ((size_t)glyphs[count].width * bpp + 7) / 8 * glyphs[count].height;
+        count++;
+    }
+    if(count == 0) Fail("no glyphs selected", bdf_path);
+    if(count > 0xFFFF) Fail("more than 65535 glyphs", bdf_path);
+
+    Kern_t *kerns = NULL;
+    uint32_t kern_count = 0;
+    if(kern_path){
+        kerns = Load_Kerning(kern_path, &kern_count);
+        kern_count = Resolve_Kerning(kerns, kern_count, glyphs, count);
+    }
+
+    Buffer_t font = Build_Font(glyphs, count, kerns, kern_count, (uint8_t)bpp, (uint16_t)line_height,
+                               (uint16_t)((ascent + scale / 2) / scale), &data);
+    fprintf(stderr, "%u glyphs, %u kerning pairs, line height %d, glyph data %zu bytes (packed bitmaps: %zu), font %zu bytes\n",
+            count, kern_count, line_height, data.size, raw_bytes, font.size);
+
+    if(bin_path){
+        FILE *f = fopen(bin_path, "wb");
+        if(!f || fwrite(font.data, 1, font.size, f) != font.size) Fail("cannot write", bin_path);
+        fclose(f);
+    }
+    if(c_path){
+        FILE *f = fopen(c_path, "w");
+        if(!f) Fail("cannot create", c_path);
+        fprintf(f, "/* Generated by ili9488_font from %s, draw with ILI9488_DrawText() */\n\n#include <stdint.h>\n\n", bdf_path);
+        fprintf(f, "const uint32_t %s[%zu] = {", name, font.size / 4);
+        for(size_t w = 0; w < font.size / 4; w++){
+            const uint8_t *p = font.data + w * 4;
+            fprintf(f, "%s0x%08X,", w % 8 ? " " : "\n    ",
+                    (unsigned)(p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24));
+        }
+        fprintf(f, "\n};\n");
+        fclose(f);
+    }
+    return 0;
+}
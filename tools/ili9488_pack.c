@@ -0,0 +1,822 @@
+/**
+ * @file ili9488_pack.c
+ * @brief Host-side asset packer for the ILI9488 driver
+ * @details This command line tool converts PNG, BMP and PPM images into the
+ *          bus-ready image blobs drawn by ILI9488_DrawImage() (see
+ *          ili9488_image.h), so no pixel format conversion is left for the
+ *          MCU. Blobs are written either as C arrays or as a binary asset
+ *          pack with a hash-sorted index.
+ *
+ *          Build:  cc -O2 -o ili9488_pack tools/ili9488_pack.c
+ *          Usage:  ili9488_pack [options] (-c out.c | -o out.pack) name=file ...
+ *
+ *          Options apply to the inputs that follow them:
+ *          -f bus666|rgb565|indexed|rle|sprite  Output pixel format (default bus666)
+ *          -f raw                               Copy files as they are, for example
+ *                                               fonts from tools/ili9488_font.c
+ *          -k RRGGBB                            Transparent color key for sprites
+ *          -a N                                 Blob alignment in a pack (default 32,
+ *                                               one Cortex-M7 cache line)
+ *
+ *          Pack layout (little-endian):
+ *          0   uint32 magic "ILPK"
+ *          4   uint16 version (1), uint16 entry count
+ *          8   uint32 blob alignment, uint32 total size
+ *          16  entries: uint32 FNV-1a hash of the name, uint32 blob offset,
+ *              uint32 blob size, uint32 name offset; sorted by hash
+ *          ... NUL-terminated names, then the blobs, each aligned
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Image formats, matching ILI9488_ImageFormat_t */
+#define FORMAT_BUS666    0
+#define FORMAT_RGB565    1
+#define FORMAT_INDEXED8  2
+#define FORMAT_RLE       3
+#define FORMAT_SPRITE    4
+#define FORMAT_RAW       5 /* Not an image: the file is copied as it is */
+
+/* Largest run length of an RLE token */
+#define RLE_MAX_RUN      0x3FFF
+
+/* Pack header constants */
+#define PACK_MAGIC       0x4B504C49u /* "ILPK" */
+#define PACK_VERSION     1
+#define PACK_HEADER_SIZE 16
+#define PACK_ENTRY_SIZE  16
+
+/**
+ * @brief Decoded source image, 8-bit RGBA
+ */
+typedef struct {
+    uint32_t width;
+    uint32_t height;
+    uint8_t *rgba;
+} Image_t;
+
+/**
+ * @brief Growable byte buffer
+ */
+typedef struct {
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+} Buffer_t;
+
+/**
+ * @brief Converted asset waiting to be written
+ */
+typedef struct {
+    char *name;
+    uint32_t hash;
+    Buffer_t blob;
+    uint32_t offset;
+    uint32_t name_offset;
+    uint8_t raw;
+} Asset_t;
+
+/**
+ * @brief Print an error and exit
+ */
+static void Fail(const char *message, const char *detail){
+    fprintf(stderr, "ili9488_pack: %s%s%s\n", message, detail ? ": " : "", detail ? detail : "");
+    exit(1);
+}
+
+/**
+ * @brief Append bytes to a buffer
+ */
+static void Buffer_Append(Buffer_t *b, const void *data, size_t size){
+    if(b->size + size > b->capacity){
+        size_t capacity = b->capacity ? b->capacity : 256;
+        while(capacity < b->size + size) capacity *= 2;
+        b->data = realloc(b->data, capacity);
+        if(!b->data) Fail("out of memory", NULL);
+        b->capacity = capacity;
+    }
+    if(data) memcpy(b->data + b->size, data, size);
+    else     memset(b->data + b->size, 0, size);
+    b->size += size;
+}
+
+/**
+ * @brief Append a little-endian 32-bit word to a buffer
+ */
+static void Buffer_Word(Buffer_t *b, uint32_t word){
+    uint8_t bytes[4] = {(uint8_t)word, (uint8_t)(word >> 8), (uint8_t)(word >> 16), (uint8_t)(word >> 24)};
+    Buffer_Append(b, bytes, 4);
+}
+
+/**
+ * @brief Append a little-endian 16-bit value to a buffer
+ */
+static void Buffer_Half(Buffer_t *b, uint16_t half){
+    uint8_t bytes[2] = {(uint8_t)half, (uint8_t)(half >> 8)};
+    Buffer_Append(b, bytes, 2);
+}
+
+/**
+ * @brief Pad a buffer with zeros to a multiple of an alignment
+ */
+static void Buffer_Align(Buffer_t *b, size_t align){
+    while(b->size % align) Buffer_Append(b, NULL, 1);
+}
+
+/**
+ * @brief Read a whole file into memory
+ */
+static uint8_t *Load_File(const char *path, size_t *size){
+    FILE *f = fopen(path, "rb");
+    if(!f) Fail("cannot open", path);
+    fseek(f, 0, SEEK_END);
+    long length = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *data = malloc(length > 0 ? (size_t)length : 1);
+    if(!data || fread(data, 1, (size_t)length, f) != (size_t)length) Fail("cannot read", path);
+    fclose(f);
+    *size = (size_t)length;
+    return data;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Inflate (RFC 1951), enough for PNG image data                           */
+/* ------------------------------------------------------------------------ */
+
+/**
+ * @brief Inflate decoder state
+ */
+typedef struct {
+    const uint8_t *in;
+    size_t in_size;
+    size_t in_pos;
+    uint32_t bit_buffer;
+    uint32_t bit_count;
+    uint8_t *out;
+    size_t out_size;
+    size_t out_pos;
+} Inflate_t;
+
+/**
+ * @brief Canonical Huffman table: code counts per length and sorted symbols
+ */
+typedef struct {
+    uint16_t count[16];
+    uint16_t symbol[288];
+} Huffman_t;
+
+static uint32_t Inflate_Bits(Inflate_t *s, uint32_t need){
+    uint32_t value = s->bit_buffer;
+    while(s->bit_count < need){
+        if(s->in_pos >= s->in_size) Fail("truncated deflate stream", NULL);
+        value |= (uint32_t)s->in[s->in_pos++] << s->bit_count;
+        s->bit_count += 8;
+    }
+    s->bit_buffer = value >> need;
+    s->bit_count -= need;
+    return value & ((1u << need) - 1);
+}
+
+static void Inflate_Put(Inflate_t *s, uint8_t byte){
+    if(s->out_pos >= s->out_size) Fail("image data larger than expected", NULL);
+    s->out[s->out_pos++] = byte;
+}
+
+static void Huffman_Build(Huffman_t *h, const uint16_t *lengths, uint32_t n){
+    uint16_t offsets[16];
+    memset(h->count, 0, sizeof(h->count));
+    for(uint32_t i = 0; i < n; i++) h->count[lengths[i]]++;
+    h->count[0] = 0;
+    offsets[1] = 0;
+    for(uint32_t len = 1; len < 15; len++) offsets[len + 1] = offsets[len] + h->count[len];
+    for(uint32_t i = 0; i < n; i++){
+        if(lengths[i]) h->symbol[offsets[lengths[i]]++] = (uint16_t)i;
+    }
+}
+
+static uint32_t Huffman_Decode(Inflate_t *s, const Huffman_t *h){
+    int32_t code = 0, first = 0, index = 0;
+    for(uint32_t len = 1; len < 16; len++){
+        code |= (int32_t)Inflate_Bits(s, 1);
+        int32_t count = h->count[len];
+        if(code - count < first) return h->symbol[index + (code - first)];
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+    Fail("invalid Huffman code", NULL);
+    return 0;
+}
+
+static void Inflate_Codes(Inflate_t *s, const Huffman_t *lencode, const Huffman_t *distcode){
+    static const uint16_t len_base[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                          35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    static const uint8_t len_extra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                          3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    static const uint16_t dist_base[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                           257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                           8193, 12289, 16385, 24577};
+    static const uint8_t dist_extra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                           7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+    for(;;){
+        uint32_t symbol = Huffman_Decode(s, lencode);
+        if(symbol < 256){
+            Inflate_Put(s, (uint8_t)symbol);
+            continue;
+        }
+        if(symbol == 256) return;
+        symbol -= 257;
+        if(symbol >= 29) Fail("invalid length code", NULL);
+        uint32_t len = len_base[symbol] + Inflate_Bits(s, len_extra[symbol]);
+        uint32_t dsym = Huffman_Decode(s, distcode);
+        if(dsym >= 30) Fail("invalid distance code", NULL);
+        uint32_t dist = dist_base[dsym] + Inflate_Bits(s, dist_extra[dsym]);
+        if(dist > s->out_pos) Fail("distance too far back", NULL);
+        while(len--) Inflate_Put(s, s->out[s->out_pos - dist]);
+    }
+}
+
+static void Inflate_Dynamic(Inflate_t *s){
+    static const uint8_t order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+    uint16_t lengths[320];
+    Huffman_t lencode, distcode;
+    uint32_t nlen = Inflate_Bits(s, 5) + 257;
+    uint32_t ndist = Inflate_Bits(s, 5) + 1;
+    uint32_t ncode = Inflate_Bits(s, 4) + 4;
+    if(nlen > 286 || ndist > 30) Fail("invalid dynamic block", NULL);
+
+    memset(lengths, 0, sizeof(lengths));
+    for(uint32_t i = 0; i < ncode; i++) lengths[order[i]] = (uint16_t)Inflate_Bits(s, 3);
+    Huffman_Build(&lencode, lengths, 19);
+
+    for(uint32_t i = 0; i < nlen + ndist;){
+        uint32_t symbol = Huffman_Decode(s, &lencode);
+        uint32_t repeat, value = 0;
+        if(symbol < 16){
+            lengths[i++] = (uint16_t)symbol;
+            continue;
+        }
+        if(symbol == 16){
+            if(i == 0) Fail("invalid repeat", NULL);
+            value = lengths[i - 1];
+            repeat = 3 + Inflate_Bits(s, 2);
+        }
+        else if(symbol == 17) repeat = 3 + Inflate_Bits(s, 3);
+        else                  repeat = 11 + Inflate_Bits(s, 7);
+        if(i + repeat > nlen + ndist) Fail("invalid repeat", NULL);
+        while(repeat--) lengths[i++] = (uint16_t)value;
+    }
+    Huffman_Build(&lencode, lengths, nlen);
+    Huffman_Build(&distcode, lengths + nlen, ndist);
+    Inflate_Codes(s, &lencode, &distcode);
+}
+
+static void Inflate_Fixed(Inflate_t *s){
+    uint16_t lengths[320];
+    Huffman_t lencode, distcode;
+    uint32_t i = 0;
+    for(; i < 144; i++) lengths[i] = 8;
+    for(; i < 256; i++) lengths[i] = 9;
+    for(; i < 280; i++) lengths[i] = 7;
+    for(; i < 288; i++) lengths[i] = 8;
+    Huffman_Build(&lencode, lengths, 288);
+    for(i = 0; i < 30; i++) lengths[i] = 5;
+    Huffman_Build(&distcode, lengths, 30);
+    Inflate_Codes(s, &lencode, &distcode);
+}
+
+/**
+ * @brief Inflate a zlib stream into a buffer of known size
+ */
+static void Inflate(const uint8_t *in, size_t in_size, uint8_t *out, size_t out_size){
+    Inflate_t s = {in, in_size, 2, 0, 0, out, out_size, 0}; /* Skip the zlib header */
+    uint32_t last;
+    if(in_size < 2 || (in[0] & 0x0F) != 8) Fail("unsupported zlib stream", NULL);
+    do{
+        last = Inflate_Bits(&s, 1);
+        uint32_t type = Inflate_Bits(&s, 2);
+        if(type == 0){
+            s.bit_buffer = 0;
+            s.bit_count = 0;
+            if(s.in_pos + 4 > s.in_size) Fail("truncated stored block", NULL);
+            uint32_t len = s.in[s.in_pos] | (uint32_t)s.in[s.in_pos + 1] << 8;
+            s.in_pos += 4;
+            if(s.in_pos + len > s.in_size) Fail("truncated stored block", NULL);
+            while(len--) Inflate_Put(&s, s.in[s.in_pos++]);
+        }
+        else if(type == 1) Inflate_Fixed(&s);
+        else if(type == 2) Inflate_Dynamic(&s);
+        else Fail("invalid deflate block", NULL);
+    } while(!last);
+    if(s.out_pos != out_size) Fail("image data smaller than expected", NULL);
+}
+
+/* ------------------------------------------------------------------------ */
+/* Image loaders                                                            */
+/* ------------------------------------------------------------------------ */
+
+static uint32_t Read_BE32(const uint8_t *p){
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+static uint32_t Read_LE32(const uint8_t *p){
+    return (uint32_t)p[3] << 24 | (uint32_t)p[2] << 16 | (uint32_t)p[1] << 8 | p[0];
+}
+
+static void Store_LE32(uint8_t *p, uint32_t value){
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+static uint8_t Paeth(uint8_t a, uint8_t b, uint8_t c){
+    int32_t p = (int32_t)a + b - c;
+    int32_t pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+    if(pa <= pb && pa <= pc) return a;
+    return pb <= pc ? b : c;
+}
+
+/**
+ * @brief Decode a non-interlaced PNG (8-bit channels, or 1/2/4/8-bit palette)
+ */
+static Image_t Load_PNG(const uint8_t *file, size_t size, const char *path){
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    Image_t image = {0, 0, NULL};
+    uint8_t palette[256][4];
+    uint8_t depth = 0, type = 0;
+    Buffer_t idat = {0};
+
+    if(size < 8 || memcmp(file, signature, 8)) Fail("not a PNG file", path);
+    for(uint32_t i = 0; i < 256; i++){
+        palette[i][0] = palette[i][1] = palette[i][2] = 0;
+        palette[i][3] = 255;
+    }
+    for(size_t pos = 8; pos + 12 <= size;){
+        uint32_t len = Read_BE32(file + pos);
+        const uint8_t *tag = file + pos + 4, *chunk = file + pos + 8;
+        if(pos + 12 + len > size) Fail("truncated PNG chunk", path);
+        if(!memcmp(tag, "IHDR", 4)){
+            image.width = Read_BE32(chunk);
+            image.height = Read_BE32(chunk + 4);
+            depth = chunk[8];
+            type = chunk[9];
+            if(chunk[12]) Fail("interlaced PNG is not supported", path);
+        }
+        else if(!memcmp(tag, "PLTE", 4)){
+            for(uint32_t i = 0; i < len / 3 && i < 256; i++) memcpy(palette[i], chunk + i * 3, 3);
+        }
+        else if(!memcmp(tag, "tRNS", 4) && type == 3){
+            for(uint32_t i = 0; i < len && i < 256; i++) palette[i][3] = chunk[i];
+        }
+        else if(!memcmp(tag, "IDAT", 4)){
+            Buffer_Append(&idat, chunk, len);
+        }
+        else if(!memcmp(tag, "IEND", 4)){
+            break;
+        }
+        pos += 12 + len;
+    }
+
+    static const uint8_t channels_of[7] = {1, 0, 3, 1, 2, 0, 4};
+    if(type > 6 || channels_of[type] == 0) Fail("unsupported PNG color type", path);
+    if(depth != 8 && !(type == 3 && (depth == 1 || depth == 2 || depth == 4))){
+        Fail("unsupported PNG bit depth", path);
+    }
+    uint32_t channels = channels_of[type];
+    size_t stride = ((size_t)image.width * channels * depth + 7) / 8;
+    size_t bpp = (channels * depth + 7) / 8;
+    uint8_t *raw = malloc((stride + 1) * image.height);
+    if(!raw) Fail("out of memory", NULL);
+    Inflate(idat.data, idat.size, raw, (stride + 1) * image.height);
+    free(idat.data);
+
+    /* Undo the per-row filters in place */
+    for(uint32_t y = 0; y < image.height; y++){
+        uint8_t *line = raw + y * (stride + 1) + 1;
+        const uint8_t *prev = y ? line - (stride + 1) : NULL;
+        uint8_t filter = line[-1];
+        for(size_t i = 0; i < stride; i++){
+            uint8_t a = i >= bpp ? line[i - bpp] : 0;
+            uint8_t b = prev ? prev[i] : 0;
+            uint8_t c = (prev && i >= bpp) ? prev[i - bpp] : 0;
+            switch(filter){
+                case 0: break;
+                case 1: line[i] += a; break;
+                case 2: line[i] += b; break;
+                case 3: line[i] += (uint8_t)(((uint32_t)a + b) / 2); break;
+                case 4: line[i] += Paeth(a, b, c); break;
+                default: Fail("invalid PNG filter", path);
+            }
+        }
+    }
+
+    /* Expand to RGBA */
+    image.rgba = malloc((size_t)image.width * image.height * 4);
+    if(!image.rgba) Fail("out of memory", NULL);
+    for(uint32_t y = 0; y < image.height; y++){
+        const uint8_t *line = raw + y * (stride + 1) + 1;
+        for(uint32_t x = 0; x < image.width; x++){
+            uint8_t *out = image.rgba + ((size_t)y * image.width + x) * 4;
+            const uint8_t *px = line + (size_t)x * channels;
+            switch(type){
+                case 0: out[0] = out[1] = out[2] = px[0]; out[3] = 255; break;
+                case 2: memcpy(out, px, 3); out[3] = 255; break;
+                case 4: out[0] = out[1] = out[2] = px[0]; out[3] = px[1]; break;
+                case 6: memcpy(out, px, 4); break;
+                default: {
+                    uint32_t bit = x * depth;
+                    uint8_t index = (uint8_t)((line[bit / 8] >> (8 - depth - bit % 8)) & ((1u << depth) - 1));
+                    memcpy(out, palette[index], 4);
+                    break;
+                }
+            }
+        }
+    }
+    free(raw);
+    return image;
+}
+
+/**
+ * @brief Decode an uncompressed 24-bit or 32-bit BMP
+ */
+static Image_t Load_BMP(const uint8_t *file, size_t size, const char *path){
+    Image_t image = {0, 0, NULL};
+    if(size < 54 || file[0] != 'B' || file[1] != 'M') Fail("not a BMP file", path);
+    uint32_t offset = Read_LE32(file + 10);
+    int32_t width = (int32_t)Read_LE32(file + 18);
+    int32_t height = (int32_t)Read_LE32(file + 22);
+    uint16_t bits = (uint16_t)(file[28] | file[29] << 8);
+    uint32_t compression = Read_LE32(file + 30);
+    uint8_t top_down = height < 0;
+    if(top_down) height = -height;
+    if(width <= 0 || height <= 0) Fail("invalid BMP size", path);
+    if((bits != 24 && bits != 32) || (compression != 0 && compression != 3)){
+        Fail("only uncompressed 24/32-bit BMP is supported", path);
+    }
+    size_t stride = ((size_t)width * (bits / 8) + 3) & ~(size_t)3;
+    if(offset + stride * (size_t)height > size) Fail("truncated BMP file", path);
+
+    image.width = (uint32_t)width;
+    image.height = (uint32_t)height;
+    image.rgba = malloc((size_t)width * height * 4);
+    if(!image.rgba) Fail("out of memory", NULL);
+    for(int32_t y = 0; y < height; y++){
+        const uint8_t *line = file + offset + stride * (size_t)(top_down ? y : height - 1 - y);
+        for(int32_t x = 0; x < width; x++){
+            const uint8_t *px = line + (size_t)x * (bits / 8);
+            uint8_t *out = image.rgba + ((size_t)y * width + x) * 4;
+            out[0] = px[2];
+            out[1] = px[1];
+            out[2] = px[0];
+            out[3] = bits == 32 && compression == 3 ? px[3] : 255;
+        }
+    }
+    return image;
+}
+
+/**
+ * @brief Skip whitespace and comments in a PPM header
+ */
+static size_t PPM_Skip(const uint8_t *file, size_t size, size_t pos){
+    while(pos < size){
+        if(file[pos] == '#') while(pos < size && file[pos] != '\n') pos++;
+        else if(file[pos] == ' ' || file[pos] == '\t' || file[pos] == '\r' || file[pos] == '\n') pos++;
+        else break;
+    }
+    return pos;
+}
+
+/**
+ * @brief Decode a binary PPM (P6, 8-bit)
+ */
+static Image_t Load_PPM(const uint8_t *file, size_t size, const char *path){
+    Image_t image = {0, 0, NULL};
+    uint32_t values[3];
+    size_t pos = 2;
+    if(size < 3 || file[0] != 'P' || file[1] != '6') Fail("only binary PPM (P6) is supported", path);
+    for(uint32_t i = 0; i < 3; i++){
+        pos = PPM_Skip(file, size, pos);
+        values[i] = 0;
+        while(pos < size && file[pos] >= '0' && file[pos] <= '9') values[i] = values[i] * 10 + (file[pos++] - '0');
+    }
+    pos++; /* Single whitespace before the pixels */
+    if(values[2] != 255) Fail("only 8-bit PPM is supported", path);
+    image.width = values[0];
+    image.height = values[1];
+    if(pos + (size_t)image.width * image.height * 3 > size) Fail("truncated PPM file", path);
+    image.rgba = malloc((size_t)image.width * image.height * 4);
+    if(!image.rgba) Fail("out of memory", NULL);
+    for(size_t i = 0; i < (size_t)image.width * image.height; i++){
+        memcpy(image.rgba + i * 4, file + pos + i * 3, 3);
+        image.rgba[i * 4 + 3] = 255;
+    }
+    return image;
+}
+
+/**
+ * @brief Load an image, picking the decoder from the file signature
+ */
+static Image_t Load_Image(const char *path){
+    size_t size;
+    uint8_t *file = Load_File(path, &size);
+    Image_t image;
+    if(size >= 4 && file[0] == 0x89 && file[1] == 'P') image = Load_PNG(file, size, path);
+    else if(size >= 2 && file[0] == 'B' && file[1] == 'M') image = Load_BMP(file, size, path);
+    else if(size >= 2 && file[0] == 'P' && file[1] == '6') image = Load_PPM(file, size, path);
+    else Fail("unknown image format", path);
+    free(file);
+    if(image.width == 0 || image.height == 0 || image.width > 0xFFFF || image.height > 0xFFFF){
+        Fail("invalid image size", path);
+    }
+    return image;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Converters                                                               */
+/* ------------------------------------------------------------------------ */
+
+/**
+ * @brief Convert an 8-bit RGB pixel to an 18-bit bus word (R:17-12, G:11-6, B:5-0)
+ */
+static uint32_t To_Bus(const uint8_t *px){
+    uint32_t r = (px[0] * 63u + 127) / 255, g = (px[1] * 63u + 127) / 255, b = (px[2] * 63u + 127) / 255;
+    return r << 12 | g << 6 | b;
+}
+
+/**
+ * @brief Convert an 8-bit RGB pixel to RGB565
+ */
+static uint16_t To_565(const uint8_t *px){
+    uint32_t r = (px[0] * 31u + 127) / 255, g = (px[1] * 63u + 127) / 255, b = (px[2] * 31u + 127) / 255;
+    return (uint16_t)(r << 11 | g << 5 | b);
+}
+
+/**
+ * @brief Convert a decoded image into an image blob
+ * @param image Decoded image
+ * @param format Output format
+ * @param key Transparent color (0xRRGGBB), or -1 to use the alpha channel only
+ * @param path Source path for error messages
+ * @return Blob (header, palette, data), padded to 4 bytes
+ */
+static Buffer_t Convert(const Image_t *image, uint8_t format, int32_t key, const char *path){
+    Buffer_t blob = {0}, palette = {0}, data = {0};
+    size_t count = (size_t)image->width * image->height;
+    uint32_t colors[256];
+    uint32_t color_count = 0;
+
+    switch(format){
+        case FORMAT_BUS666:
+            for(size_t i = 0; i < count; i++) Buffer_Word(&data, To_Bus(image->rgba + i * 4));
+            break;
+
+        case FORMAT_RGB565:
+            for(size_t i = 0; i < count; i++) Buffer_Half(&data, To_565(image->rgba + i * 4));
+            break;
+
+        case FORMAT_INDEXED8:
+            for(size_t i = 0; i < count; i++){
+                uint32_t word = To_Bus(image->rgba + i * 4), index = 0;
+                while(index < color_count && colors[index] != word) index++;
+                if(index == color_count){
+                    if(color_count == 256) Fail("more than 256 colors for indexed format", path);
+                    colors[color_count++] = word;
+                    Buffer_Word(&palette, word);
+                }
+                uint8_t byte = (uint8_t)index;
+                Buffer_Append(&data, &byte, 1);
+            }
+            break;
+
+        case FORMAT_RLE:
+            for(size_t i = 0; i < count;){
+                uint32_t word = To_Bus(image->rgba + i * 4), run = 1;
+                while(i + run < count && run < RLE_MAX_RUN && To_Bus(image->rgba + (i + run) * 4) == word) run++;
+                Buffer_Word(&data, run << 18 | word);
+                i += run;
+            }
+            break;
+
+        default: /* FORMAT_SPRITE */
+            for(uint32_t y = 0; y < image->height; y++){
+                const uint8_t *line = image->rgba + (size_t)y * image->width * 4;
+                uint32_t runs = 0;
+                size_t count_pos = data.size;
+                Buffer_Word(&data, 0);
+                for(uint32_t x = 0; x < image->width;){
+                    const uint8_t *px = line + (size_t)x * 4;
+                    uint32_t rgb = (uint32_t)px[0] << 16 | px[1] << 8 | px[2];
+                    if(px[3] < 128 || (int32_t)rgb == key){
+                        x++;
+                        continue;
+                    }
+                    uint32_t start = x;
+                    size_t run_pos = data.size;
+                    Buffer_Word(&data, 0);
+                    for(; x < image->width; x++){
+                        px = line + (size_t)x * 4;
+                        rgb = (uint32_t)px[0] << 16 | px[1] << 8 | px[2];
+                        if(px[3] < 128 || (int32_t)rgb == key) break;
+                        Buffer_Word(&data, To_Bus(px));
+                    }
+                    Store_LE32(data.data + run_pos, start << 16 | (x - start));
+                    runs++;
+                }
+                Store_LE32(data.data + count_pos, runs);
+            }
+            break;
+    }
+    Buffer_Align(&data, 4);
+
+    /* Header: width, height, format, reserved, palette count, data size */
+    Buffer_Half(&blob, (uint16_t)image->width);
+    Buffer_Half(&blob, (uint16_t)image->height);
+    Buffer_Append(&blob, &format, 1);
+    Buffer_Append(&blob, NULL, 1);
+    Buffer_Half(&blob, (uint16_t)color_count);
+    Buffer_Word(&blob, (uint32_t)data.size);
+    Buffer_Append(&blob, palette.data, palette.size);
+    Buffer_Append(&blob, data.data, data.size);
+    free(palette.data);
+    free(data.data);
+    return blob;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Output                                                                   */
+/* ------------------------------------------------------------------------ */
+
+/**
+ * @brief 32-bit FNV-1a hash of a name, as used by the pack index
+ */
+static uint32_t Hash_Name(const char *name){
+    uint32_t hash = 2166136261u;
+    while(*name){
+        hash ^= (uint8_t)*name++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static int Compare_Assets(const void *a, const void *b){
+    uint32_t ha = ((const Asset_t *)a)->hash, hb = ((const Asset_t *)b)->hash;
+    return ha < hb ? -1 : ha > hb;
+}
+
+/**
+ * @brief Write the assets as C arrays
+ */
+static void Write_C(const char *path, const Asset_t *assets, uint32_t count){
+    FILE *f = fopen(path, "w");
+    if(!f) Fail("cannot create", path);
+    fprintf(f, "/* Generated by ili9488_pack, draw with ILI9488_DrawImage() */\n\n#include <stdint.h>\n");
+    for(uint32_t i = 0; i < count; i++){
+        const Asset_t *a = &assets[i];
+        char identifier[256];
+        size_t n = 0;
+        for(const char *p = a->name; *p && n < sizeof(identifier) - 1; p++){
+            char c = *p;
+            uint8_t valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9' && n);
+            identifier[n++] = valid ? c : '_';
+        }
+        identifier[n] = '\0';
+        if(a->raw){
+            fprintf(f, "\n/* %s */\nconst uint32_t %s[%u] = {", a->name, identifier, (unsigned)(a->blob.size / 4));
+        }
+        else{
+            fprintf(f, "\n/* %s: %u x %u, format %u */\nconst uint32_t %s[%u] = {",
+                    a->name, a->blob.data[0] | a->blob.data[1] << 8, a->blob.data[2] | a->blob.data[3] << 8,
+                    a->blob.data[4], identifier, (unsigned)(a->blob.size / 4));
+        }
+        for(size_t w = 0; w < a->blob.size / 4; w++){
+            fprintf(f, "%s0x%08X,", w % 8 ? " " : "\n    ", Read_LE32(a->blob.data + w * 4));
+        }
+        fprintf(f, "\n};\n");
+    }
+    fclose(f);
+}
+
+/**
+ * @brief Write the assets as a binary pack with a hash-sorted index
+ */
+static void Write_Pack(const char *path, Asset_t *assets, uint32_t count, uint32_t align){
+    Buffer_t pack = {0}, names = {0};
+
+    qsort(assets, count, sizeof(Asset_t), Compare_Assets);
+    for(uint32_t i = 1; i < count; i++){
+        if(assets[i].hash == assets[i - 1].hash) Fail("duplicate or colliding asset name", assets[i].name);
+    }
+
+    /* Lay out names, then aligned blobs */
+    uint32_t names_start = PACK_HEADER_SIZE + count * PACK_ENTRY_SIZE;
+    for(uint32_t i = 0; i < count; i++){
+        assets[i].name_offset = names_start + (uint32_t)names.size;
+        Buffer_Append(&names, assets[i].name, strlen(assets[i].name) + 1);
+    }
+    uint32_t offset = names_start + (uint32_t)names.size;
+    for(uint32_t i = 0; i < count; i++){
+        offset = (offset + align - 1) / align * align;
+        assets[i].offset = offset;
+        offset += (uint32_t)assets[i].blob.size;
+    }
+
+    Buffer_Word(&pack, PACK_MAGIC);
+    Buffer_Half(&pack, PACK_VERSION);
+    Buffer_Half(&pack, (uint16_t)count);
+    Buffer_Word(&pack, align);
+    Buffer_Word(&pack, offset);
+    for(uint32_t i = 0; i < count; i++){
+        Buffer_Word(&pack, assets[i].hash);
+        Buffer_Word(&pack, assets[i].offset);
+        Buffer_Word(&pack, (uint32_t)assets[i].blob.size);
+        Buffer_Word(&pack, assets[i].name_offset);
+    }
+    Buffer_Append(&pack, names.data, names.size);
+    for(uint32_t i = 0; i < count; i++){
+        Buffer_Append(&pack, NULL, assets[i].offset - pack.size);
+        Buffer_Append(&pack, assets[i].blob.data, assets[i].blob.size);
+    }
+
+    FILE *f = fopen(path, "wb");
+    if(!f || fwrite(pack.data, 1, pack.size, f) != pack.size) Fail("cannot write", path);
+    fclose(f);
+    free(pack.data);
+    free(names.data);
+}
+
+static void Usage(void){
+    fprintf(stderr,
+            "usage: ili9488_pack [options] (-c out.c | -o out.pack) name=image ...\n"
+            "  -f bus666|rgb565|indexed|rle|sprite  pixel format for the following inputs\n"
+            "  -f raw                               copy the following files as they are\n"
+            "  -k RRGGBB                            transparent color key for sprites\n"
+            "  -a N                                 blob alignment in packs (power of two)\n"
+            "images: PNG (8-bit, or 1/2/4/8-bit palette), BMP (24/32-bit), PPM (P6)\n");
+    exit(2);
+}
+
+int main(int argc, char **argv){
+    static const char *format_names[6] = {"bus666", "rgb565", "indexed", "rle", "sprite", "raw"};
+    const char *c_path = NULL, *pack_path = NULL;
+    uint8_t format = FORMAT_BUS666;
+    int32_t key = -1;
+    uint32_t align = 32;
+    Asset_t *assets = calloc((size_t)argc, sizeof(Asset_t));
+    uint32_t count = 0;
+
+    for(int i = 1; i < argc; i++){
+        const char *arg = argv[i];
+        if(arg[0] == '-' && arg[1] && !arg[2] && i + 1 < argc){
+            const char *value = argv[++i];
+            switch(arg[1]){
+                case 'c': c_path = value; break;
+                case 'o': pack_path = value; break;
+                case 'k': key = (int32_t)strtol(value, NULL, 16); break;
+                case 'a':
+                    align = (uint32_t)strtoul(value, NULL, 0);
+                    if(align < 4 || (align & (align - 1))) Fail("alignment must be a power of two >= 4", value);
+                    break;
+                case 'f':
+                    for(format = 0; format < 6 && strcmp(value, format_names[format]); format++);
+                    if(format == 6) Fail("unknown format", value);
+                    break;
+                default: Usage();
+            }
+            continue;
+        }
+        const char *eq = strchr(arg, '=');
+        if(!eq || eq == arg) Usage();
+        Asset_t *a = &assets[count++];
+        a->name = malloc((size_t)(eq - arg) + 1);
+        memcpy(a->name, arg, (size_t)(eq - arg));
+        a->name[eq - arg] = '\0';
+        a->hash = Hash_Name(a->name);
+        if(format == FORMAT_RAW){
+            size_t size;
+            uint8_t *file = Load_File(eq + 1, &size);
+            a->raw = 1;
+            Buffer_Append(&a->blob, file, size);
+            Buffer_Align(&a->blob, 4);
+            free(file);
+            fprintf(stderr, "%s: raw, %zu bytes\n", a->name, a->blob.size);
+            continue;
+        }
+        Image_t image = Load_Image(eq + 1);
+        a->blob = Convert(&image, format, key, eq + 1);
+        free(image.rgba);
+        fprintf(stderr, "%s: %ux%u %s, %zu bytes\n", a->name, image.width, image.height,
+                format_names[format], a->blob.size);
+    }
+    if(count == 0 || (!c_path && !pack_path)) Usage();
+    if(c_path) Write_C(c_path, assets, count);
+    if(pack_path) Write_Pack(pack_path, assets, count, align);
+    return 0;
+}
@@ -0,0 +1,293 @@
+/**
+ * @file ili9488_ref.c
+ * @brief Host-side reference rasterizer for differential checks of the ILI9488 driver
+ * @details This file contains the implementation of the reference rasterizer.
+ *          Each primitive is reduced to a set of single pixels, each clipped
+ *          on its own: lines are Bresenham points, circles the eight mirrored
+ *          points of the midpoint walk, and a filled circle joins every
+ *          outline point with its mirror on the same row. Correctness comes
+ *          from the definition, not from speed.
+ *
+ *          Build together with ili9488_sim.c and the host build of the driver.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <string.h>
+#include "ili9488_ref.h"
+
+/**
+ * @brief Plot one pixel, dropping it off the screen
+ */
+static void Ref_Put(Ref_t *ref, int32_t x, int32_t y, uint32_t color){
+    if(x < 0 || y < 0 || x >= ref->width || y >= ref->height) return;
+    ref->pixels[(uint32_t)y * ref->width + (uint32_t)x] = color;
+}
+
+/**
+ * @brief Plot a horizontal row of pixels
+ */
+static void Ref_Row(Ref_t *ref, int32_t x0, int32_t x1, int32_t y, uint32_t color){
+    for(int32_t x = x0; x <= x1; x++) Ref_Put(ref, x, y, color);
+}
+
+/**
+ * @brief Walk the outline of a circle and plot each of its points, or the row to its mirror
+ */
+static void Ref_Circle(Ref_t *ref, int32_t cx, int32_t cy, int32_t radius, uint8_t fill, uint32_t color){
+    int32_t x = radius, y = 0, d = 1 - radius;
+    while(y <= x){
+        /* The eight points (+-x, +-y) and (+-y, +-x) */
+        for(int i = 0; i < 2; i++){
+            int32_t u = i ? y : x, v = i ? x : y;
+            if(fill){
+                Ref_Row(ref, cx - u, cx + u, cy + v, color);
+                Ref_Row(ref, cx - u, cx + u, cy - v, color);
+            }
+            else{
+                Ref_Put(ref, cx + u, cy + v, color);
+                Ref_Put(ref, cx - u, cy + v, color);
+                Ref_Put(ref, cx + u, cy - v, color);
+                Ref_Put(ref, cx - u, cy - v, color);
+            }
+        }
+        y++;
+        if(d < 0){
+            d += 2 * y + 1;
+        }
+        else{
+            x--;
+            d += 2 * (y - x) + 1;
+        }
+    }
+}
+
+/**
+ * @brief Clear a picture to black
+ * @param ref Picture
+ * @param width Screen width of the rotation under test
+ * @param height Screen height of the rotation under test
+ */
+void Ref_Init(Ref_t *ref, uint16_t width, uint16_t height){
+    ref->width = width;
+    ref->height = height;
+    memset(ref->pixels, 0, sizeof(ref->pixels));
+}
+
+/**
+ * @brief Draw an operation
+ * @param ref Picture
+ * @param op Operation
+ */
+void Ref_Apply(Ref_t *ref, const Ref_Op_t *op){
+    int32_t a = op->a, b = op->b, c = op->c, d = op->d;
+    uint32_t color = op->color;
+
+    switch(op->type){
+        case REF_FILL_BACKGROUND:
+            for(int32_t y = 0; y < ref->height; y++) Ref_Row(ref, 0, ref->width - 1, y, color);
+            break;
+        case REF_PIXEL:
+            Ref_Put(ref, a, b, color);
+            break;
+        case REF_LINE: {
+            int32_t dx = c > a ? c - a : a - c, sx = a < c ? 1 : -1;
+            int32_t dy = d > b ? b - d : d - b, sy = b < d ? 1 : -1;
+            int32_t err = dx + dy;
+            for(;;){
+                Ref_Put(ref, a, b, color);
+                if(a == c && b == d) break;
+                int32_t e2 = 2 * err;
+                if(e2 >= dy){ err += dy; a += sx; }
+                if(e2 <= dx){ err += dx; b += sy; }
+            }
+            break;
+        }
+        case REF_RECT:
+        case REF_FILL_RECT:
+            for(int32_t y = b; y < b + d; y++) Ref_Row(ref, a, a + c - 1, y, color);
+            break;
+        case REF_CIRCLE:
+        case REF_FILL_CIRCLE:
+            Ref_Circle(ref, a, b, c, op->type == REF_FILL_CIRCLE, color);
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Compare a picture with the panel memory
+ * @param ref Picture
+ * @param sim Panel, rotated like the picture
+ * @param x Output: column of the first difference (may be NULL)
+ * @param y Output: row of the first difference (may be NULL)
+ * @return Number of pixels that differ
+ */
+uint32_t Ref_Compare(const Ref_t *ref, const Sim_t *sim, uint16_t *x, uint16_t *y){
+    uint32_t differ = 0;
+    for(uint16_t row = 0; row < ref->height; row++){
+        for(uint16_t column = 0; column < ref->width; column++){
+            if(ref->pixels[(uint32_t)row * ref->width + column] == Sim_GetPixel(sim, column, row)) continue;
+            if(!differ){
+                if(x) *x = column;
+                if(y) *y = row;
+            }
+            differ++;
+        }
+    }
+    return differ;
+}
+
+/**
+ * @brief Next random number (xorshift32)
+ */
+static uint32_t Ref_Next(uint32_t *seed){
+    uint32_t s = *seed ? *seed : 1;
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    *seed = s;
+    return s;
+}
+
+/**
+ * @brief Random value below limit, often one at either end of the range
+ */
+static uint16_t Ref_Pick(uint32_t limit, uint32_t *seed){
+    uint32_t r = Ref_Next(seed);
+    if(limit <= 1) return 0;
+    switch(r & 7){
+        case 0: return 0;
+        case 1: return 1;
+        case 2: return (uint16_t)(limit - 1);
+        case 3: return (uint16_t)(limit - 2);
+        default: return (uint16_t)((r >> 3) % limit);
+    }
+}
+
+/**
+ * @brief Make a random operation within the documented argument ranges
+ * @param op Output operation
+ * @param width Screen width of the rotation under test
+ * @param height Screen height of the rotation under test
+ * @param seed Random state, updated
+ */
+void Ref_Random(Ref_Op_t *op, uint16_t width, uint16_t height, uint32_t *seed){
+    uint32_t r = Ref_Next(seed);
+
+    memset(op, 0, sizeof(*op));
+    op->color = Ref_Next(seed) & 0x3F3F3F;
+    op->type = (r % 32) == 0 ? REF_FILL_BACKGROUND : (Ref_OpType_t)(REF_PIXEL + (r >> 5) % (REF_OPS - 1));
+    switch(op->type){
+        case REF_PIXEL:
+            op->a = Ref_Pick(width, seed);
+            op->b = Ref_Pick(height, seed);
+            break;
+        case REF_LINE:
+            /* Up to 40 pixels past the screen, often straight or a single point */
+            op->a = Ref_Pick(width + 40, seed);
+            op->b = Ref_Pick(height + 40, seed);
+            op->c = Ref_Pick(width + 40, seed);
+            op->d = Ref_Pick(height + 40, seed);
+            switch(Ref_Next(seed) & 7){
+                case 0: op->c = op->a; break;
+                case 1: op->d = op->b; break;
+                case 2: op->c = op->a; op->d = op->b; break;
+                default: break;
+            }
+            break;
+        case REF_RECT:
+        case REF_FILL_RECT:
+            op->a = Ref_Pick(width, seed);
+            op->b = Ref_Pick(height, seed);
+            op->c = 1 + Ref_Pick(width - op->a, seed);
+            op->d = 1 + Ref_Pick(height - op->b, seed);
+            break;
+        case REF_CIRCLE:
+        case REF_FILL_CIRCLE:
+            op->a = Ref_Pick(width, seed);
+            op->b = Ref_Pick(height, seed);
+            op->c = (Ref_Next(seed) & 3) == 0 ? Ref_Pick(4, seed) : Ref_Pick(height / 2, seed);
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Reduce a failing sequence of operations
+ * @param ops Operations, reduced in place
+ * @param count Number of operations
+ * @param fails Test telling whether a sequence still fails
+ * @param context Passed to the test
+ * @return Number of operations left
+ */
+uint32_t Ref_Shrink(Ref_Op_t *ops, uint32_t count, Ref_FailsFn_t fails, void *context){
+    /* Drop operations, last first, as long as the failure remains */
+    for(uint32_t i = count; i-- > 0;){
+        Ref_Op_t removed = ops[i];
+        memmove(&ops[i], &ops[i + 1], (count - i - 1) * sizeof(Ref_Op_t));
+        if(fails(ops, count - 1, context)){
+            count--;
+            continue;
+        }
+        memmove(&ops[i + 1], &ops[i], (count - i - 1) * sizeof(Ref_Op_t));
+        ops[i] = removed;
+    }
+
+    /* Move the arguments towards 0; sizes stay at 1 or more */
+    for(uint32_t i = 0; i < count; i++){
+        uint16_t *args[4] = {&ops[i].a, &ops[i].b, &ops[i].c, &ops[i].d};
+        uint8_t sized = ops[i].type == REF_RECT || ops[i].type == REF_FILL_RECT;
+        for(int k = 0; k < 4; k++){
+            uint16_t floor = sized && k >= 2 ? 1 : 0;
+            uint8_t smaller = 1;
+            while(smaller){
+                uint16_t value = *args[k], tries[3] = {floor, (uint16_t)(value / 2), (uint16_t)(value - 1)};
+                smaller = 0;
+                for(int t = 0; t < 3 && !smaller; t++){
+                    if(tries[t] < floor || tries[t] >= value) continue;
+                    *args[k] = tries[t];
+                    smaller = fails(ops, count, context);
+                    if(!smaller) *args[k] = value;
+                }
+            }
+        }
+        uint32_t color = ops[i].color;
+        ops[i].color = 0x3F3F3F;
+        if(color != ops[i].color && !fails(ops, count, context)) ops[i].color = color;
+    }
+    return count;
+}
+
+/**
+ * @brief Print an operation as a driver call
+ * @param op Operation
+ * @param out Destination
+ */
+void Ref_Print(const Ref_Op_t *op, FILE *out){
+    switch(op->type){
+        case REF_FILL_BACKGROUND:
+            fprintf(out, "ILI9488_FillBackground(0x%06X);\n", (unsigned)op->color);
+            break;
+        case REF_PIXEL:
+            fprintf(out, "ILI9488_DrawPixel(%u, %u, 0x%06X);\n", op->a, op->b, (unsigned)op->color);
+            break;
+        case REF_LINE:
+        case REF_RECT:
+        case REF_FILL_RECT:
+            fprintf(out, "ILI9488_%s(%u, %u, %u, %u, 0x%06X);\n",
+                    op->type == REF_LINE ? "DrawLine" : op->type == REF_RECT ? "DrawRect" : "FillRect",
+                    op->a, op->b, op->c, op->d, (unsigned)op->color);
+            break;
+        case REF_CIRCLE:
+        case REF_FILL_CIRCLE:
+            fprintf(out, "ILI9488_%s(%u, %u, %u, 0x%06X);\n", op->type == REF_CIRCLE ? "DrawCircle" : "FillCircle",
+                    op->a, op->b, op->c, (unsigned)op->color);
+            break;
+        default:
+            break;
+    }
+}
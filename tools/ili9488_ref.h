@@ -0,0 +1,129 @@
+/**
+ * @file ili9488_ref.h
+ * @brief Host-side reference rasterizer for differential checks of the ILI9488 driver
+ * @details This header file contains the declarations for a slow, plain
+ *          rasterizer of the driver's drawing primitives. It plots every pixel
+ *          on its own into an array in the coordinates the driver draws with,
+ *          with none of the span merging, run coalescing or window clipping of
+ *          ili9488.c, so that the panel memory of the simulator in
+ *          ili9488_sim.h can be compared with it after the same operations.
+ *
+ *          A differential run builds the driver for the host with ILI9488_TRACE
+ *          and ILI9488_TRACE_PIXELS 1 and implements the trace hooks of
+ *          ili9488_trace.h by forwarding them to Sim_Command(), Sim_Data() and
+ *          (for ILI9488_TraceRun()) Sim_Repeat(), which taps the bus without a
+ *          recording step. Random operations from Ref_Random() are then
+ *          applied to both sides, and a failing sequence is reduced with
+ *          Ref_Shrink() and printed as driver calls with Ref_Print().
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_REF_H
+#define __ILI9488_REF_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "ili9488_sim.h"
+
+/**
+ * @brief Drawing operations, one per driver primitive
+ */
+typedef enum {
+    REF_FILL_BACKGROUND = 0,  ///< ILI9488_FillBackground(color)
+    REF_PIXEL,                ///< ILI9488_DrawPixel(a, b, color)
+    REF_LINE,                 ///< ILI9488_DrawLine(a, b, c, d, color)
+    REF_RECT,                 ///< ILI9488_DrawRect(a, b, c, d, color)
+    REF_FILL_RECT,            ///< ILI9488_FillRect(a, b, c, d, color)
+    REF_CIRCLE,               ///< ILI9488_DrawCircle(a, b, c, color)
+    REF_FILL_CIRCLE,          ///< ILI9488_FillCircle(a, b, c, color)
+    REF_OPS
+} Ref_OpType_t;
+
+/**
+ * @brief Drawing operation
+ */
+typedef struct {
+    Ref_OpType_t type;
+    uint16_t a, b, c, d;      ///< Arguments in the order of the driver call
+    uint32_t color;           ///< RGB666 color
+} Ref_Op_t;
+
+/**
+ * @brief Reference picture
+ */
+typedef struct {
+    uint16_t width;                              ///< 320 or 480
+    uint16_t height;                             ///< 480 or 320
+    uint32_t pixels[SIM_WIDTH * SIM_HEIGHT];     ///< RGB666 colors, rows of width pixels
+} Ref_t;
+
+/**
+ * @brief Test for Ref_Shrink()
+ * @param ops Operations
+ * @param count Number of operations
+ * @param context Context given to Ref_Shrink()
+ * @return 1 if the sequence still shows the failure
+ */
+typedef uint8_t (*Ref_FailsFn_t)(const Ref_Op_t *ops, uint32_t count, void *context);
+
+/**
+ * @brief Clear a picture to black
+ * @param ref Picture
+ * @param width Screen width of the rotation under test
+ * @param height Screen height of the rotation under test
+ */
+void Ref_Init(Ref_t *ref, uint16_t width, uint16_t height);
+
+/**
+ * @brief Draw an operation
+ * @param ref Picture
+ * @param op Operation
+ */
+void Ref_Apply(Ref_t *ref, const Ref_Op_t *op);
+
+/**
+ * @brief Compare a picture with the panel memory
+ * @param ref Picture
+ * @param sim Panel, rotated like the picture
+ * @param x Output: column of the first difference (may be NULL)
+ * @param y Output: row of the first difference (may be NULL)
+ * @return Number of pixels that differ
+ */
+uint32_t Ref_Compare(const Ref_t *ref, const Sim_t *sim, uint16_t *x, uint16_t *y);
+
+/**
+ * @brief Make a random operation within the documented argument ranges
+ * @param op Output operation
+ * @param width Screen width of the rotation under test
+ * @param height Screen height of the rotation under test
+ * @param seed Random state, updated
+ * @details Coordinates favour the screen edges and sizes favour 0, 1 and
+ *          full extents, where clipping and run splitting go wrong. Lines and
+ *          circles may reach past the screen; rectangles stay on it, as
+ *          ILI9488_FillRect() requires.
+ */
+void Ref_Random(Ref_Op_t *op, uint16_t width, uint16_t height, uint32_t *seed);
+
+/**
+ * @brief Reduce a failing sequence of operations
+ * @param ops Operations, reduced in place
+ * @param count Number of operations
+ * @param fails Test telling whether a sequence still fails
+ * @param context Passed to the test
+ * @return Number of operations left
+ * @details Operations are dropped one at a time while the failure remains,
+ *          then the arguments of the rest are moved towards 0 and the colors
+ *          towards white.
+ */
+uint32_t Ref_Shrink(Ref_Op_t *ops, uint32_t count, Ref_FailsFn_t fails, void *context);
+
+/**
+ * @brief Print an operation as a driver call
+ * @param op Operation
+ * @param out Destination
+ */
+void Ref_Print(const Ref_Op_t *op, FILE *out);
+
+#endif /* __ILI9488_REF_H */
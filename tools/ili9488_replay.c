@@ -0,0 +1,573 @@
+/**
+ * @file ili9488_replay.c
+ * @brief Host-side replay tool for ILI9488 bus traces
+ * @details This command line tool reads a dump written by ILI9488_TraceDump()
+ *          (see ili9488_trace.h), feeds the recorded commands and data through
+ *          the panel simulator of ili9488_sim.c and saves the panel memory as
+ *          PPM images: one at every ILI9488_TraceMark() and one at the end of
+ *          the trace, unless nothing was sent after the last mark. It also prints how often each command was sent, the
+ *          time until the next command (that is, the time the driver spent on
+ *          it and its data) and the number of data words that followed.
+ *
+ *          Pixel bursts recorded as a count and checksum (ILI9488_TRACE_PIXELS
+ *          0) have no contents; they are painted with a magenta and grey
+ *          checkerboard so the areas they covered stay visible. Record with
+ *          ILI9488_TRACE_PIXELS 1 to get exact images.
+ *
+ *          With -c the simulator also validates the protocol (see
+ *          ili9488_sim.h), prints the issues and wasted bus words, and the
+ *          tool exits with status 1 if there were issues, so a trace recorded
+ *          by a test build can gate a CI job.
+ *
+ *          Every image records in its header the bus words (commands and data)
+ *          sent since the previous mark, so a trace with a mark after each
+ *          drawing case yields one image and one word count per case. Saved
+ *          images serve as golden images for later runs: with -g each image is
+ *          compared with the golden one of the same mark, and the tool fails
+ *          if any pixel differs or a case needs more bus words than its golden
+ *          image recorded. Record golden traces with ILI9488_TRACE_PIXELS 1.
+ *
+ *          With -b the bus traffic of each case is priced with the cost model
+ *          of ili9488_cost.h, and the predicted on-target time is printed for
+ *          every profile and transport. The trace does not tell framed data
+ *          words from single-word bursts, so data words within a memory write
+ *          count as a burst, which a repeat record ends; pixel bursts recorded
+ *          as a count are assumed to have 9 of their 18 bits set.
+ *
+ *          With -s the simulator runs the panel's refresh scan against the
+ *          command times, spreading the words of each command evenly until
+ *          the next one, and aligning the scan with the TE edges recorded by
+ *          ILI9488_WaitForTE(). Every refresh that showed something new is
+ *          saved as what the viewer saw, and refreshes that showed part of a
+ *          memory write are listed as torn; with -c they also fail the run.
+ *          This needs command times finer than a line (about 34 us), so point
+ *          ILI9488_TRACE_CLOCK() at a cycle counter.
+ *
+ *          With -t the transitions on the bus lines are counted as the
+ *          bit-banged bus drives them, and printed per case, per command (the
+ *          words it and its data drove) and per line, next to the data line
+ *          transitions a write of only the changed lines would cause. Bursts
+ *          are inferred as for -b; pixels recorded as a count toggle like the
+ *          checkerboard they are painted with.
+ *
+ *          With -p the input is an SPI capture of the ILI9488_TRANSPORT_SPI
+ *          bus instead of a trace: two bytes per byte on MOSI, first a flags
+ *          byte (bit 0 the DCX level, bit 1 set if CS went high after the
+ *          byte), then the byte itself. Logic analyzer exports convert to it
+ *          with a few lines of script. The bytes are decoded by Sim_SpiByte()
+ *          into one image, validated with -c and compared with -g.
+ *
+ *          Build:  cc -O2 -o ili9488_replay tools/ili9488_replay.c tools/ili9488_sim.c tools/ili9488_cost.c
+ *          Usage:  ili9488_replay [-o prefix] [-g prefix] [-s prefix] [-c] [-b] [-t] [-v] [-p] trace.bin
+ *
+ *          -o PREFIX   Image names, PREFIX-N.ppm at mark N and PREFIX.ppm at
+ *                      the end (default "replay")
+ *          -g PREFIX   Golden images to compare with, named like -o
+ *          -s PREFIX   Simulate the refresh scan, PREFIX-N.ppm at refresh N
+ *          -c          Validate the protocol, fail on issues
+ *          -b          Predict the on-target time of each case
+ *          -t          Count the bus line transitions
+ *          -v          List every record
+ *          -p          Read an SPI capture instead of a trace
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ili9488_sim.h"
+#include "ili9488_cost.h"
+
+#define TRACE_MAGIC     0x52544C49u /* "ILTR" */
+#define TRACE_HEADER    16
+
+/* Record types, as in ili9488_trace.h */
+#define TRACE_COMMAND   0
+#define TRACE_DATA      1
+#define TRACE_REPEAT    2
+#define TRACE_BURST     3
+#define TRACE_CHECKSUM  4
+#define TRACE_MARK      5
+#define TRACE_RESET     6
+#define TRACE_VSYNC     7
+
+/* Checkerboard for pixel bursts without contents (magenta, dark grey) */
+#define BURST_ODD       0x3F03Fu
+#define BURST_EVEN      0x10410u
+
+/**
+ * @brief Per-command totals
+ */
+typedef struct {
+    uint32_t count;      ///< Times the command was sent
+    uint32_t timed;      ///< Times a following command gave its duration
+    uint64_t ticks;      ///< Duration in trace clock ticks
+    uint64_t words;      ///< Data words that followed, recorded or not
+    uint64_t unrecorded; ///< Of which pixel words only counted by a burst record
+    uint64_t toggles;    ///< Data line transitions of the command and its data
+} Totals_t;
+
+static const char *const command_names[256] = {
+    [0x01] = "software reset",
+    [0x10] = "sleep in",
+    [0x11] = "sleep out",
+    [0x13] = "normal mode",
+    [0x28] = "display off",
+    [0x29] = "display on",
+    [0x2A] = "column address",
+    [0x2B] = "page address",
+    [0x2C] = "memory write",
+    [0x33] = "scroll definition",
+    [0x34] = "tearing off",
+    [0x35] = "tearing on",
+    [0x36] = "memory access",
+    [0x37] = "scroll start",
+    [0x3A] = "pixel format",
+    [0x3C] = "memory write continue",
+};
+
+static const char *const record_names[8] = {
+    "command", "data", "repeat", "burst", "checksum", "mark", "reset", "vsync"
+};
+
+static Sim_t sim;
+static Totals_t totals[256];
+static uint64_t case_start;   ///< Bus words sent before the current case
+static uint32_t failures;     ///< Images that do not match their golden image
+static uint8_t costs;         ///< 1 to price the traffic of each case (-b)
+static Cost_t case_cost;      ///< Traffic of the current case
+static Cost_t total_cost;     ///< Traffic of the whole trace
+static uint64_t burst_latched, burst_ones, burst_strobed; ///< Burst in progress
+static uint32_t last_seen[SIM_HEIGHT][SIM_WIDTH]; ///< Last refresh saved by -s
+static uint8_t toggles;       ///< 1 to print the bus line transitions (-t)
+static uint64_t case_toggles[SIM_LINES + 1]; ///< Line and changed-only transitions before the current case
+
+static void Fail(const char *message, const char *detail){
+    fprintf(stderr, "ili9488_replay: %s%s%s\n", message, detail ? ": " : "", detail ? detail : "");
+    exit(1);
+}
+
+static uint32_t Read_Word(const uint8_t *p){
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint8_t *Load_File(const char *path, size_t *size){
+    FILE *f = fopen(path, "rb");
+    if(!f) Fail("cannot open", path);
+    uint8_t *data = NULL;
+    size_t capacity = 0, used = 0, n;
+    do{
+        if(used == capacity){
+            capacity = capacity ? capacity * 2 : 65536;
+            data = realloc(data, capacity);
+            if(!data) Fail("out of memory", NULL);
+        }
+        n = fread(data + used, 1, capacity - used, f);
+        used += n;
+    }while(n > 0);
+    fclose(f);
+    *size = used;
+    return data;
+}
+
+static void Image_Path(char *path, size_t size, const char *prefix, int32_t mark){
+    if(mark < 0) snprintf(path, size, "%s.ppm", prefix);
+    else snprintf(path, size, "%s-%d.ppm", prefix, mark);
+}
+
+/* Read the next complete record, skipping stray bytes and records cut by a wrap; 0 at the end */
+static uint8_t Next_Record(const uint8_t **cursor, const uint8_t *end, uint8_t *type, uint64_t *value){
+    const uint8_t *p = *cursor;
+    while(p < end){
+        if(!(*p & 0x80)){
+            p++;
+            continue;
+        }
+        uint8_t length_bytes = *p & 15, complete = 1;
+        *type = (*p >> 4) & 7;
+        *value = 0;
+        p++;
+        for(uint8_t i = 0; i < length_bytes; i++){
+            if(p == end || (*p & 0x80)){
+                complete = 0;
+                break;
+            }
+            *value |= (uint64_t)*p++ << (7 * i);
+        }
+        if(!complete || length_bytes > 5) continue;
+        *cursor = p;
+        return 1;
+    }
+    *cursor = p;
+    return 0;
+}
+
+/* Bus time per word of the command just read: its span to the next command or TE edge, over its words */
+static uint8_t Word_Time(const uint8_t *p, const uint8_t *end, uint32_t clock_hz, uint64_t *word_ns){
+    uint8_t type;
+    uint64_t value, words = 1, ticks;
+    while(Next_Record(&p, end, &type, &value)){
+        switch(type){
+            case TRACE_DATA: words++; continue;
+            case TRACE_REPEAT:
+            case TRACE_BURST: words += value; continue;
+            case TRACE_COMMAND: ticks = value >> 8; break;
+            case TRACE_VSYNC: ticks = value; break;
+            case TRACE_RESET: return 0;
+            default: continue;
+        }
+        *word_ns = ticks * 1000000000ull / clock_hz / words;
+        return 1;
+    }
+    return 0;
+}
+
+static void Refresh_Done(Sim_t *panel, uint32_t torn, uint16_t stale, void *context){
+    char path[1024], note[64];
+    unsigned long long refresh = (unsigned long long)panel->refreshes - 1;
+    if(torn){
+        printf("refresh %llu at %.3f ms: %u memory writes shown in part, %u rows changed after they were shown\n",
+               refresh, (double)panel->time_ns / 1e6, torn, stale);
+    }
+    if(!memcmp(last_seen, panel->seen, sizeof(last_seen))) return;
+    memcpy(last_seen, panel->seen, sizeof(last_seen));
+    snprintf(path, sizeof(path), "%s-%llu.ppm", (const char *)context, refresh);
+    snprintf(note, sizeof(note), "refresh %llu, torn writes %u", refresh, torn);
+    if(!Sim_SaveRefreshPPM(panel, path, note)) Fail("cannot write", path);
+}
+
+static uint64_t Data_Toggles(void){
+    uint64_t sum = 0;
+    for(int line = 0; line < 18; line++) sum += sim.toggles[line];
+    return sum;
+}
+
+static void Print_Toggles(int32_t mark){
+    uint64_t data = Data_Toggles(), before = 0;
+    if(!toggles) return;
+    for(int line = 0; line < 18; line++) before += case_toggles[line];
+    if(mark < 0 && sim.toggles[SIM_LINE_WR] == case_toggles[SIM_LINE_WR]) return;
+    if(mark < 0) printf("end       ");
+    else printf("case %-5d", mark);
+    printf(" data %10llu  changed only %10llu  WR %9llu  CS %7llu  DCX %7llu\n",
+           (unsigned long long)(data - before),
+           (unsigned long long)(sim.toggles_changed - case_toggles[SIM_LINES]),
+           (unsigned long long)(sim.toggles[SIM_LINE_WR] - case_toggles[SIM_LINE_WR]),
+           (unsigned long long)(sim.toggles[SIM_LINE_CS] - case_toggles[SIM_LINE_CS]),
+           (unsigned long long)(sim.toggles[SIM_LINE_DCX] - case_toggles[SIM_LINE_DCX]));
+    memcpy(case_toggles, sim.toggles, sizeof(sim.toggles));
+    case_toggles[SIM_LINES] = sim.toggles_changed;
+}
+
+static void Flush_Burst(void){
+    Sim_Deselect(&sim);
+    Cost_Burst(&case_cost, burst_latched, burst_ones, burst_strobed);
+    burst_latched = burst_ones = burst_strobed = 0;
+}
+
+static void Print_Cost(int32_t mark){
+    char label[32];
+    if(!costs) return;
+    Flush_Burst();
+    if(mark < 0 && !case_cost.framed && !case_cost.bursts) return;
+    if(mark < 0) snprintf(label, sizeof(label), "end");
+    else snprintf(label, sizeof(label), "case %d", mark);
+    Cost_Print(&case_cost, label, stdout);
+    Cost_Add(&total_cost, &case_cost);
+    Cost_Init(&case_cost);
+}
+
+static void Save_Image(const char *prefix, const char *golden, int32_t mark){
+    char path[1024], note[64], golden_note[256];
+    unsigned long long words = sim.commands + sim.data_words - case_start, budget;
+
+    case_start += words;
+    snprintf(note, sizeof(note), "bus words %llu", words);
+    Image_Path(path, sizeof(path), prefix, mark);
+    if(!Sim_SavePPM(&sim, path, note)) Fail("cannot write", path);
+    if(!golden) return;
+
+    Image_Path(path, sizeof(path), golden, mark);
+    int64_t differ = Sim_ComparePPM(&sim, path, golden_note, sizeof(golden_note));
+    if(differ < 0){
+        printf("%s: missing, unreadable or of another size\n", path);
+        failures++;
+        return;
+    }
+    if(differ > 0){
+        printf("%s: %lld pixels differ\n", path, (long long)differ);
+        failures++;
+    }
+    if(sscanf(golden_note, "bus words %llu", &budget) != 1) return;
+    if(words > budget){
+        printf("%s: %llu bus words, golden image has %llu\n", path, words, budget);
+        failures++;
+    }
+    else if(words < budget){
+        printf("%s: %llu bus words, down from %llu, update the golden image\n", path, words, budget);
+    }
+}
+
+static int Compare_Totals(const void *a, const void *b){
+    const Totals_t *ta = &totals[*(const uint8_t *)a], *tb = &totals[*(const uint8_t *)b];
+    if(ta->ticks != tb->ticks) return ta->ticks < tb->ticks ? 1 : -1;
+    return (int)*(const uint8_t *)a - (int)*(const uint8_t *)b;
+}
+
+static void Print_Totals(uint32_t clock_hz){
+    uint8_t order[256];
+    uint32_t used = 0;
+    for(uint32_t c = 0; c < 256; c++){
+        if(totals[c].count) order[used++] = (uint8_t)c;
+    }
+    qsort(order, used, 1, Compare_Totals);
+
+    printf("cmd  name                     count    time (ms)       words  unrecorded%s\n",
+           toggles ? "     toggles" : "");
+    for(uint32_t i = 0; i < used; i++){
+        const Totals_t *t = &totals[order[i]];
+        const char *name = command_names[order[i]] ? command_names[order[i]] : "";
+        printf("%02X   %-22s %7u %12.3f %11llu %11llu", order[i], name, t->count,
+               clock_hz ? (double)t->ticks * 1000.0 / clock_hz : 0.0,
+               (unsigned long long)t->words, (unsigned long long)t->unrecorded);
+        if(toggles) printf(" %11llu", (unsigned long long)t->toggles);
+        printf("\n");
+    }
+}
+
+/* Flags of an SPI capture byte pair */
+#define SPI_DCX         0x01
+#define SPI_CS_HIGH     0x02
+
+static int Replay_Spi(const uint8_t *data, size_t size, const char *prefix, const char *golden, uint8_t check){
+    Sim_Init(&sim);
+    if(check){
+        sim.validate = SIM_VALIDATE_PROTOCOL;
+        sim.log = stdout;
+    }
+    for(size_t i = 0; i + 1 < size; i += 2){
+        Sim_SpiByte(&sim, data[i] & SPI_DCX, data[i + 1]);
+        if(data[i] & SPI_CS_HIGH) Sim_Deselect(&sim);
+    }
+    Sim_Finish(&sim);
+    Save_Image(prefix, golden, -1);
+    printf("%zu bytes, %llu commands, %llu data words, %llu pixels\n", size / 2,
+           (unsigned long long)sim.commands, (unsigned long long)sim.data_words,
+           (unsigned long long)sim.pixels);
+    uint64_t issues = check ? Sim_Report(&sim, stdout) : 0;
+    if(golden) printf("%u images differ from the golden images\n", failures);
+    return issues || failures ? 1 : 0;
+}
+
+static void Usage(void){
+    fprintf(stderr,
+            "usage: ili9488_replay [-o prefix] [-g prefix] [-s prefix] [-c] [-b] [-t] [-v] [-p] trace.bin\n"
+            "  -o PREFIX  image names, PREFIX-N.ppm at mark N and PREFIX.ppm at the end\n"
+            "  -g PREFIX  golden images to compare with, exit with status 1 on differences\n"
+            "  -s PREFIX  simulate the refresh scan, PREFIX-N.ppm at refresh N\n"
+            "  -c         validate the protocol, exit with status 1 on issues\n"
+            "  -b         predict the on-target time of each case\n"
+            "  -t         count the bus line transitions\n"
+            "  -v         list every record\n"
+            "  -p         read an SPI capture (flags and MOSI byte pairs) instead of a trace\n");
+    exit(2);
+}
+
+int main(int argc, char **argv){
+    const char *prefix = "replay", *golden = NULL, *scan = NULL, *trace_path = NULL;
+    uint8_t verbose = 0, check = 0, spi = 0;
+
+    for(int i = 1; i < argc; i++){
+        const char *arg = argv[i];
+        if(!strcmp(arg, "-v")){
+            verbose = 1;
+            continue;
+        }
+        if(!strcmp(arg, "-c")){
+            check = 1;
+            continue;
+        }
+        if(!strcmp(arg, "-b")){
+            costs = 1;
+            continue;
+        }
+        if(!strcmp(arg, "-t")){
+            toggles = 1;
+            continue;
+        }
+        if(!strcmp(arg, "-p")){
+            spi = 1;
+            continue;
+        }
+        if(!strcmp(arg, "-o") && i + 1 < argc){
+            prefix = argv[++i];
+            continue;
+        }
+        if(!strcmp(arg, "-g") && i + 1 < argc){
+            golden = argv[++i];
+            continue;
+        }
+        if(!strcmp(arg, "-s") && i + 1 < argc){
+            scan = argv[++i];
+            continue;
+        }
+        if(arg[0] == '-' || trace_path) Usage();
+        trace_path = arg;
+    }
+    if(!trace_path) Usage();
+
+    size_t size;
+    uint8_t *data = Load_File(trace_path, &size);
+    if(spi){
+        int status = Replay_Spi(data, size, prefix, golden, check);
+        free(data);
+        return status;
+    }
+    if(size < TRACE_HEADER || Read_Word(data) != TRACE_MAGIC) Fail("not a trace dump", trace_path);
+    if((data[4] | data[5] << 8) != 1) Fail("unsupported trace version", trace_path);
+    uint8_t pixels = data[6], wrapped = data[7];
+    uint32_t clock_hz = Read_Word(data + 8), length = Read_Word(data + 12);
+    if(length > size - TRACE_HEADER) Fail("trace is truncated", trace_path);
+    const uint8_t *p = data + TRACE_HEADER, *end = p + length;
+
+    Sim_Init(&sim);
+    if(check){
+        /* Delays can only be checked with timestamps, and not across a lost start */
+        sim.validate = SIM_VALIDATE_PROTOCOL | (clock_hz && !wrapped ? SIM_VALIDATE_TIMING : 0);
+        sim.log = stdout;
+    }
+    if(scan){
+        if(!clock_hz) Fail("the refresh scan needs command times", trace_path);
+        Sim_StartScan(&sim, 0, Refresh_Done, (void *)scan);
+    }
+    /* After a wrap the stream starts mid-record and data has no reference until a command */
+    uint8_t synced = !wrapped, timed = !wrapped;
+    uint32_t previous = 0, records = 0, bursts = 0, marks = 0;
+    int32_t current = -1;
+    uint64_t value, command_ns = 0;
+    uint8_t type;
+
+    while(Next_Record(&p, end, &type, &value)){
+        if(!synced){
+            if(type != TRACE_COMMAND && type != TRACE_RESET) continue;
+            synced = 1;
+        }
+        records++;
+        if(verbose) printf("%8u  %-8s %llu\n", records, record_names[type], (unsigned long long)value);
+        uint64_t toggled = Data_Toggles();
+
+        switch(type){
+            case TRACE_COMMAND: {
+                uint8_t cmd = (uint8_t)value;
+                if(timed && clock_hz) command_ns += (value >> 8) * 1000000000ull / clock_hz;
+                if(sim.time_ns < command_ns) Sim_Advance(&sim, command_ns - sim.time_ns);
+                if(scan) Word_Time(p, end, clock_hz, &sim.word_ns);
+                if(current >= 0 && timed){
+                    totals[current].ticks += value >> 8;
+                    totals[current].timed++;
+                }
+                timed = 1;
+                totals[cmd].count++;
+                current = cmd;
+                previous = 0;
+                Flush_Burst();
+                Cost_Word(&case_cost, cmd);
+                Sim_Command(&sim, cmd);
+                break;
+            }
+            case TRACE_DATA: {
+                uint32_t zigzag = (uint32_t)value;
+                previous += (zigzag >> 1) ^ (0u - (zigzag & 1));
+                if(current >= 0) totals[current].words++;
+                if(!sim.writing){
+                    Flush_Burst();
+                    Cost_Word(&case_cost, previous);
+                }
+                else{
+                    /* A word after a run starts the next burst */
+                    if(burst_strobed) Flush_Burst();
+                    burst_latched++;
+                    burst_ones += Cost_Ones(previous);
+                }
+                sim.burst = sim.writing;
+                Sim_Data(&sim, previous);
+                break;
+            }
+            case TRACE_REPEAT:
+                if(current >= 0) totals[current].words += value;
+                if(sim.writing) burst_strobed += value;
+                else for(uint64_t i = 0; i < value; i++) Cost_Word(&case_cost, previous);
+                sim.burst = sim.writing;
+                Sim_Repeat(&sim, previous, (uint32_t)value);
+                break;
+            case TRACE_BURST:
+                if(current >= 0){
+                    totals[current].words += value;
+                    totals[current].unrecorded += value;
+                }
+                Flush_Burst();
+                Cost_Burst(&case_cost, value, value * 9, 0);
+                sim.burst = 1;
+                for(uint64_t i = 0; i < value; i++){
+                    Sim_Data(&sim, (i & 1) ? BURST_ODD : BURST_EVEN);
+                }
+                Sim_Deselect(&sim);
+                bursts++;
+                break;
+            case TRACE_MARK:
+                Flush_Burst();
+                Print_Cost((int32_t)value);
+                Print_Toggles((int32_t)value);
+                Save_Image(prefix, golden, (int32_t)value);
+                marks++;
+                break;
+            case TRACE_VSYNC: {
+                if(!scan) break;
+                uint64_t edge_ns = command_ns + value * 1000000000ull / clock_hz;
+                if(sim.time_ns < edge_ns) Sim_Advance(&sim, edge_ns - sim.time_ns);
+                Sim_Vsync(&sim);
+                break;
+            }
+            case TRACE_RESET:
+                Flush_Burst();
+                Sim_Reset(&sim);
+                current = -1;
+                previous = 0;
+                break;
+            default:
+                break;
+        }
+        if(current >= 0) totals[current].toggles += Data_Toggles() - toggled;
+    }
+    Sim_Finish(&sim);
+    if(scan){
+        /* One more refresh shows the last writes */
+        sim.word_ns = 0;
+        Sim_Advance(&sim, sim.frame_ns);
+    }
+    Print_Cost(-1);
+    Print_Toggles(-1);
+    /* The end image, unless the last mark already showed the final picture */
+    if(!marks || sim.commands + sim.data_words > case_start) Save_Image(prefix, golden, -1);
+
+    printf("%u records, %u marks, %u bursts without contents, %s\n",
+           records, marks, bursts, pixels ? "pixels recorded" : "pixels summarized");
+    if(wrapped) printf("ring wrapped, older records were lost\n");
+    if(!clock_hz) printf("no clock rate, times are not available\n");
+    Print_Totals(clock_hz);
+    if(costs) Cost_Print(&total_cost, "total", stdout);
+    if(toggles) Sim_ReportToggles(&sim, stdout);
+    uint64_t issues = check ? Sim_Report(&sim, stdout) : 0;
+    if(golden) printf("%u images differ from the golden images\n", failures);
+    if(scan){
+        printf("%llu refreshes, %llu torn, %llu memory writes shown in part\n",
+               (unsigned long long)sim.refreshes, (unsigned long long)sim.torn_refreshes,
+               (unsigned long long)sim.torn_writes);
+        if(check) issues += sim.torn_refreshes;
+    }
+    free(data);
+    return issues || failures ? 1 : 0;
+}
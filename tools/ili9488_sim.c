@@ -0,0 +1,742 @@
+/**
+ * @file ili9488_sim.c
+ * @brief Host-side ILI9488 panel simulator
+ * @details This file contains the implementation of the panel model. The
+ *          address counter walks the column window first and the page window
+ *          second, wrapping back to the window origin like the controller
+ *          does. Counters are mapped to the glass with the MV, MX and MY bits
+ *          of MADCTL; writes that land outside the 320x480 memory are dropped.
+ *
+ *          The validator checks each command against the parameter count it
+ *          takes and each memory write against the window it fills, and keeps
+ *          count of bus words that changed nothing on the panel. The first
+ *          few issues of each kind are printed with the index of the command
+ *          they belong to.
+ *
+ *          The refresh scan shows one glass row per line time, then idles for
+ *          the blanking lines. Every glass row remembers the memory write and
+ *          pixel count of its last change, so at the end of a refresh the
+ *          rows that changed after they were shown are known, and a memory
+ *          write that changed such a row while other rows showed its pixels
+ *          was seen in part.
+ *
+ *          Build together with the tool that uses it, for example:
+ *          cc -O2 -o ili9488_replay tools/ili9488_replay.c tools/ili9488_sim.c
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "ili9488_sim.h"
+
+/* MADCTL bits */
+#define MADCTL_MY   0x80
+#define MADCTL_MX   0x40
+#define MADCTL_MV   0x20
+#define MADCTL_BGR  0x08
+
+/* Messages printed per issue kind before the rest are only counted */
+#define SIM_LOG_LIMIT  10
+
+static const char *const sim_issue_names[SIM_ISSUES] = {
+    "data without a command taking it", "missing parameters", "window outside frame memory",
+    "pixel count differs from window", "command during reset/sleep delay"
+};
+
+static const char *const sim_waste_names[SIM_WASTES] = {
+    "stray data", "clipped pixels", "window overrun", "redundant register writes"
+};
+
+/**
+ * @brief Count an issue and print it while under the message limit
+ */
+static void Sim_Issue(Sim_t *sim, Sim_Issue_t kind, const char *format, ...){
+    uint64_t seen = sim->issues[kind]++;
+    if(!sim->log || seen > SIM_LOG_LIMIT) return;
+    if(seen == SIM_LOG_LIMIT){
+        fprintf(sim->log, "sim: further \"%s\" issues are only counted\n", sim_issue_names[kind]);
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    fprintf(sim->log, "sim: command #%llu (0x%02X): ", (unsigned long long)sim->commands, sim->command);
+    vfprintf(sim->log, format, args);
+    fputc('\n', sim->log);
+    va_end(args);
+}
+
+/**
+ * @brief Number of parameters a command takes
+ * @return Parameter count, or -1 for commands the driver does not use
+ */
+static int8_t Sim_ParameterCount(uint8_t cmd){
+    switch(cmd){
+        case 0x00: case 0x01: case 0x10: case 0x11: case 0x13: case 0x20: case 0x21:
+        case 0x28: case 0x29: case 0x34: case 0x38: case 0x39:
+            return 0;
+        case 0x35: case 0x36: case 0x3A: case 0xB0:
+            return 1;
+        case 0x37:
+            return 2;
+        case 0x2A: case 0x2B:
+            return 4;
+        case 0x33:
+            return 6;
+        default:
+            return -1;
+    }
+}
+
+/**
+ * @brief Check the pixel count of the memory write in progress and close it
+ */
+static void Sim_EndMemoryWrite(Sim_t *sim){
+    if(!sim->memory_write) return;
+    sim->memory_write = 0;
+    if((sim->validate & SIM_VALIDATE_PROTOCOL) && sim->window_written != sim->window_area){
+        Sim_Issue(sim, SIM_ISSUE_PIXEL_COUNT, "%llu pixels written into the window of %llu opened at command #%llu",
+                  (unsigned long long)sim->window_written, (unsigned long long)sim->window_area,
+                  (unsigned long long)sim->window_command);
+    }
+}
+
+/**
+ * @brief Open a memory write with 0x2C, checking the window against the frame memory
+ */
+static void Sim_BeginMemoryWrite(Sim_t *sim){
+    uint16_t columns = (sim->madctl & MADCTL_MV) ? SIM_HEIGHT : SIM_WIDTH;
+    uint16_t pages = (sim->madctl & MADCTL_MV) ? SIM_WIDTH : SIM_HEIGHT;
+    uint8_t reversed = sim->column_start > sim->column_end || sim->page_start > sim->page_end;
+
+    sim->memory_write = 1;
+    sim->window_written = 0;
+    sim->window_command = sim->commands;
+    sim->window_area = reversed ? 0 : (uint64_t)(sim->column_end - sim->column_start + 1) *
+                                      (sim->page_end - sim->page_start + 1);
+    if(!(sim->validate & SIM_VALIDATE_PROTOCOL)) return;
+    if(reversed || sim->column_end >= columns || sim->page_end >= pages){
+        Sim_Issue(sim, SIM_ISSUE_WINDOW, "window columns %u-%u, pages %u-%u with MADCTL 0x%02X (%ux%u)",
+                  sim->column_start, sim->column_end, sim->page_start, sim->page_end, sim->madctl,
+                  columns, pages);
+    }
+}
+
+/**
+ * @brief Map an address counter position to the glass
+ * @return 1 if the position is inside the frame memory
+ */
+static uint8_t Sim_Glass(const Sim_t *sim, uint16_t column, uint16_t page, uint16_t *x, uint16_t *y){
+    uint16_t gx = column, gy = page;
+    if(sim->madctl & MADCTL_MV){
+        gx = page;
+        gy = column;
+    }
+    if(gx >= SIM_WIDTH || gy >= SIM_HEIGHT) return 0;
+    /* The modules mirror the source lines, so MX set is the upright picture */
+    *x = (sim->madctl & MADCTL_MX) ? gx : SIM_WIDTH - 1 - gx;
+    *y = (sim->madctl & MADCTL_MY) ? SIM_HEIGHT - 1 - gy : gy;
+    return 1;
+}
+
+/**
+ * @brief Count the line transitions of one bus word
+ * @param dcx 0 for a command, 1 for data
+ * @param strobe_only 1 if the data lines keep the last word (a run in a burst)
+ */
+static void Sim_Drive(Sim_t *sim, uint32_t word, uint8_t dcx, uint8_t strobe_only){
+    uint8_t framed = !sim->burst || !dcx;
+
+    /* A framed word raises CS after a burst left it low */
+    if(framed) Sim_Deselect(sim);
+    if(!sim->cs_low){
+        sim->toggles[SIM_LINE_CS]++;
+        sim->cs_low = 1;
+        if(dcx != sim->dcx) sim->toggles[SIM_LINE_DCX]++;
+        sim->dcx = dcx;
+    }
+    if(!strobe_only){
+        uint32_t old = sim->bus;
+        word &= 0x3FFFF;
+        /* Cleared if 1 before, set if 1 now */
+        for(int line = 0; line < 18; line++) sim->toggles[line] += ((old >> line) & 1) + ((word >> line) & 1);
+        for(uint32_t changed = old ^ word; changed; changed &= changed - 1) sim->toggles_changed++;
+        sim->bus = word;
+    }
+    sim->toggles[SIM_LINE_WR] += 2;
+    if(framed) Sim_Deselect(sim);
+}
+
+/**
+ * @brief Evaluate a finished refresh for tearing and report it
+ */
+static void Sim_EndRefresh(Sim_t *sim){
+    uint64_t updates[SIM_HEIGHT];
+    uint32_t count = 0, torn = 0;
+    uint16_t stale = 0;
+
+    /* Memory writes that changed rows after the scan showed them */
+    for(uint16_t row = 0; row < SIM_HEIGHT; row++){
+        if(sim->row_pixel[row] == sim->shown_pixel[row]) continue;
+        stale++;
+        uint32_t i = 0;
+        while(i < count && updates[i] != sim->row_update[row]) i++;
+        if(i == count) updates[count++] = sim->row_update[row];
+    }
+    /* Torn if any row showed pixels of the same write */
+    for(uint32_t i = 0; i < count; i++){
+        for(uint16_t row = 0; row < SIM_HEIGHT; row++){
+            if(sim->shown_update[row] != updates[i]) continue;
+            torn++;
+            break;
+        }
+    }
+    sim->refreshes++;
+    if(torn){
+        sim->torn_refreshes++;
+        sim->torn_writes += torn;
+    }
+    if(sim->on_refresh) sim->on_refresh(sim, torn, stale, sim->refresh_context);
+}
+
+/**
+ * @brief Run one line of the refresh scan: show a glass row, or idle in the blanking
+ */
+static void Sim_ScanLine(Sim_t *sim){
+    uint16_t row = sim->scan_row;
+    if(row < SIM_HEIGHT){
+        memcpy(sim->seen[row], sim->gram[row], sizeof(sim->seen[row]));
+        sim->shown_update[row] = sim->row_update[row];
+        sim->shown_pixel[row] = sim->row_pixel[row];
+    }
+    if(++sim->scan_row < SIM_HEIGHT + SIM_BLANK_LINES) return;
+    sim->scan_row = 0;
+    Sim_EndRefresh(sim);
+}
+
+/**
+ * @brief Run the scan lines due by the current time
+ */
+static void Sim_Scan(Sim_t *sim){
+    if(!sim->scan) return;
+    uint64_t line_ns = sim->frame_ns / (SIM_HEIGHT + SIM_BLANK_LINES);
+    while(sim->time_ns >= sim->scan_next_ns){
+        Sim_ScanLine(sim);
+        sim->scan_next_ns += line_ns;
+    }
+}
+
+/**
+ * @brief Apply a command once all its parameters arrived
+ */
+static void Sim_Parameters(Sim_t *sim){
+    const uint8_t *p = sim->params;
+    uint8_t same = 0;
+    switch(sim->command){
+        case 0x2A:
+            if(sim->param_count == 4){
+                uint16_t start = (uint16_t)(p[0] << 8 | p[1]), end = (uint16_t)(p[2] << 8 | p[3]);
+                same = start == sim->column_start && end == sim->column_end;
+                sim->column_start = start;
+                sim->column_end = end;
+            }
+            break;
+        case 0x2B:
+            if(sim->param_count == 4){
+                uint16_t start = (uint16_t)(p[0] << 8 | p[1]), end = (uint16_t)(p[2] << 8 | p[3]);
+                same = start == sim->page_start && end == sim->page_end;
+                sim->page_start = start;
+                sim->page_end = end;
+            }
+            break;
+        case 0x33:
+            if(sim->param_count == 6){
+                sim->scroll_top = (uint16_t)(p[0] << 8 | p[1]);
+                sim->scroll_area = (uint16_t)(p[2] << 8 | p[3]);
+                sim->scroll_bottom = (uint16_t)(p[4] << 8 | p[5]);
+            }
+            break;
+        case 0x37:
+            if(sim->param_count == 2){
+                sim->scroll_start = (uint16_t)(p[0] << 8 | p[1]);
+                sim->scrolling = 1;
+            }
+            break;
+        case 0x36:
+            if(sim->param_count == 1){
+                same = p[0] == sim->madctl;
+                sim->madctl = p[0];
+            }
+            break;
+        case 0x3A:
+            if(sim->param_count == 1){
+                same = p[0] == sim->pixel_format;
+                sim->pixel_format = p[0];
+            }
+            break;
+        case 0x35:
+            if(sim->param_count == 1) sim->te_on = 1;
+            break;
+        default:
+            break;
+    }
+    /* Rewriting a register with its value changes nothing, even for the window: 0x2C restarts at its origin anyway */
+    if(same) sim->wasted[SIM_WASTE_REDUNDANT] += 1 + sim->param_count;
+}
+
+/**
+ * @brief Load the register values of a reset
+ */
+static void Sim_Registers(Sim_t *sim){
+    sim->madctl = 0;
+    sim->pixel_format = 0x66;
+    sim->sleeping = 1;
+    sim->display_on = 0;
+    sim->te_on = 0;
+    sim->scrolling = 0;
+    sim->column_start = 0;
+    sim->column_end = SIM_WIDTH - 1;
+    sim->page_start = 0;
+    sim->page_end = SIM_HEIGHT - 1;
+    sim->scroll_top = 0;
+    sim->scroll_area = SIM_HEIGHT;
+    sim->scroll_bottom = 0;
+    sim->scroll_start = 0;
+    sim->command = 0;
+    sim->param_count = 0;
+    sim->writing = 0;
+    sim->column = 0;
+    sim->page = 0;
+    sim->memory_write = 0;
+}
+
+/**
+ * @brief Initialize a panel: clear the frame memory, statistics and validation state, and load the reset register values
+ * @param sim Panel
+ */
+void Sim_Init(Sim_t *sim){
+    memset(sim, 0, sizeof(*sim));
+    Sim_Registers(sim);
+    sim->dcx = 1;
+}
+
+/**
+ * @brief Put the panel in its hardware reset state
+ * @param sim Panel
+ */
+void Sim_Reset(Sim_t *sim){
+    Sim_EndMemoryWrite(sim);
+    Sim_Registers(sim);
+    sim->busy_until_ns = sim->time_ns + SIM_COMMAND_DELAY_NS;
+}
+
+/**
+ * @brief Move the simulated time forward
+ * @param sim Panel
+ * @param ns Nanoseconds since the previous call
+ */
+void Sim_Advance(Sim_t *sim, uint64_t ns){
+    sim->time_ns += ns;
+    Sim_Scan(sim);
+}
+
+/**
+ * @brief Start the refresh scan at the current time, with the first glass row
+ * @param sim Panel
+ * @param frame_ns Refresh period, 0 for SIM_FRAME_NS
+ * @param on_refresh Called after each refresh, or NULL
+ * @param context Passed to on_refresh
+ */
+void Sim_StartScan(Sim_t *sim, uint64_t frame_ns, Sim_RefreshFn_t on_refresh, void *context){
+    sim->scan = 1;
+    sim->frame_ns = frame_ns ? frame_ns : SIM_FRAME_NS;
+    sim->scan_row = 0;
+    sim->scan_next_ns = sim->time_ns;
+    sim->on_refresh = on_refresh;
+    sim->refresh_context = context;
+    Sim_Scan(sim);
+}
+
+/**
+ * @brief Align the refresh scan with a TE rising edge at the current time
+ * @param sim Panel
+ */
+void Sim_Vsync(Sim_t *sim){
+    if(!sim->scan) return;
+    while(sim->scan_row < SIM_HEIGHT) Sim_ScanLine(sim);
+    /* The first blanking line starts now */
+    sim->scan_row = SIM_HEIGHT;
+    sim->scan_next_ns = sim->time_ns;
+    Sim_Scan(sim);
+}
+
+/**
+ * @brief End a pixel burst: CS goes high
+ * @param sim Panel
+ */
+void Sim_Deselect(Sim_t *sim){
+    sim->spi_bytes = 0;
+    if(!sim->cs_low) return;
+    sim->toggles[SIM_LINE_CS]++;
+    sim->cs_low = 0;
+}
+
+/**
+ * @brief Close the memory write in progress, so its pixel count is checked
+ * @param sim Panel
+ */
+void Sim_Finish(Sim_t *sim){
+    Sim_Deselect(sim);
+    int8_t expected = Sim_ParameterCount(sim->command);
+    if((sim->validate & SIM_VALIDATE_PROTOCOL) && expected > 0 && sim->param_count < expected){
+        Sim_Issue(sim, SIM_ISSUE_PARAMETERS, "%u of %d parameters", sim->param_count, expected);
+    }
+    Sim_EndMemoryWrite(sim);
+}
+
+/**
+ * @brief Feed a command
+ * @param sim Panel
+ * @param cmd Command byte
+ */
+void Sim_Command(Sim_t *sim, uint8_t cmd){
+    Sim_Drive(sim, cmd, 0, 0);
+    int8_t expected = Sim_ParameterCount(sim->command);
+    if((sim->validate & SIM_VALIDATE_PROTOCOL) && expected > 0 && sim->param_count < expected){
+        Sim_Issue(sim, SIM_ISSUE_PARAMETERS, "%u of %d parameters", sim->param_count, expected);
+    }
+    if(cmd == 0x01 || cmd == 0x2A || cmd == 0x2B || cmd == 0x2C || cmd == 0x36) Sim_EndMemoryWrite(sim);
+
+    sim->commands++;
+    sim->command = cmd;
+    sim->param_count = 0;
+    sim->writing = 0;
+    if((sim->validate & SIM_VALIDATE_TIMING) && sim->time_ns < sim->busy_until_ns){
+        Sim_Issue(sim, SIM_ISSUE_BUSY, "%.3f ms before the end of a reset or sleep delay",
+                  (double)(sim->busy_until_ns - sim->time_ns) / 1e6);
+    }
+    switch(cmd){
+        case 0x01:
+            Sim_Registers(sim);
+            sim->busy_until_ns = sim->time_ns + SIM_COMMAND_DELAY_NS;
+            break;
+        case 0x10:
+            if((sim->validate & SIM_VALIDATE_TIMING) && sim->sleep_out_ns &&
+               sim->time_ns - sim->sleep_out_ns < SIM_SLEEP_DELAY_NS){
+                Sim_Issue(sim, SIM_ISSUE_BUSY, "sleep in %.3f ms after sleep out",
+                          (double)(sim->time_ns - sim->sleep_out_ns) / 1e6);
+            }
+            sim->sleeping = 1;
+            sim->busy_until_ns = sim->time_ns + SIM_COMMAND_DELAY_NS;
+            break;
+        case 0x11:
+            sim->sleeping = 0;
+            sim->sleep_out_ns = sim->time_ns ? sim->time_ns : 1;
+            sim->busy_until_ns = sim->time_ns + SIM_COMMAND_DELAY_NS;
+            break;
+        case 0x13: sim->scrolling = 0; break;
+        case 0x28: sim->display_on = 0; break;
+        case 0x29: sim->display_on = 1; break;
+        case 0x34: sim->te_on = 0; break;
+        case 0x2C:
+            sim->column = sim->column_start;
+            sim->page = sim->page_start;
+            sim->writing = 1;
+            sim->update++;
+            Sim_BeginMemoryWrite(sim);
+            break;
+        case 0x3C:
+            sim->writing = 1;
+            break;
+        default:
+            break;
+    }
+    if(sim->word_ns) Sim_Advance(sim, sim->word_ns);
+}
+
+/**
+ * @brief Apply a data word as a parameter or a pixel
+ */
+static void Sim_Word(Sim_t *sim, uint32_t word){
+    sim->data_words++;
+    if(!sim->writing){
+        int8_t expected = Sim_ParameterCount(sim->command);
+        if(expected >= 0 && sim->param_count >= expected){
+            sim->wasted[SIM_WASTE_STRAY]++;
+            if(sim->validate & SIM_VALIDATE_PROTOCOL){
+                Sim_Issue(sim, SIM_ISSUE_NO_MEMORY_WRITE, "data word 0x%05X after %u parameters",
+                          (unsigned)word, sim->param_count);
+            }
+        }
+        if(sim->param_count < sizeof(sim->params)) sim->params[sim->param_count] = (uint8_t)word;
+        if(sim->param_count < 255) sim->param_count++;
+        Sim_Parameters(sim);
+        return;
+    }
+
+    uint16_t x, y;
+    if(++sim->window_written > sim->window_area && sim->memory_write) sim->wasted[SIM_WASTE_OVERRUN]++;
+    if(Sim_Glass(sim, sim->column, sim->page, &x, &y)){
+        sim->pixels++;
+        if(sim->gram[y][x] != (word & 0x3FFFF)){
+            sim->gram[y][x] = word & 0x3FFFF;
+            sim->row_update[y] = sim->update;
+            sim->row_pixel[y] = sim->pixels;
+        }
+    }
+    else{
+        sim->wasted[SIM_WASTE_CLIPPED]++;
+    }
+    if(sim->column < sim->column_end){
+        sim->column++;
+        return;
+    }
+    sim->column = sim->column_start;
+    sim->page = sim->page < sim->page_end ? sim->page + 1 : sim->page_start;
+}
+
+/**
+ * @brief Feed a data word
+ * @param sim Panel
+ * @param word 18-bit bus word
+ */
+void Sim_Data(Sim_t *sim, uint32_t word){
+    Sim_Drive(sim, word, 1, 0);
+    Sim_Word(sim, word);
+    if(sim->word_ns) Sim_Advance(sim, sim->word_ns);
+}
+
+/**
+ * @brief Feed the same data word several times
+ * @param sim Panel
+ * @param word 18-bit bus word
+ * @param count Number of words
+ */
+void Sim_Repeat(Sim_t *sim, uint32_t word, uint32_t count){
+    uint8_t run = sim->burst && sim->cs_low && (word & 0x3FFFF) == sim->bus;
+    while(count-- > 0){
+        Sim_Drive(sim, word, 1, run);
+        Sim_Word(sim, word);
+        if(sim->word_ns) Sim_Advance(sim, sim->word_ns);
+    }
+}
+
+/**
+ * @brief Feed a byte received on the SPI bus
+ * @param sim Panel
+ * @param dcx DCX level while the byte was sent: 0 for a command, 1 for data
+ * @param byte Byte on MOSI
+ */
+void Sim_SpiByte(Sim_t *sim, uint8_t dcx, uint8_t byte){
+    if(!dcx){
+        sim->spi_bytes = 0;
+        sim->burst = 0;
+        Sim_Command(sim, byte);
+        return;
+    }
+    if(!sim->writing){
+        sim->burst = 0;
+        Sim_Data(sim, byte);
+        return;
+    }
+    /* 18 bpp: one channel per byte, in bits 7-2 */
+    sim->spi_word = (sim->spi_word << 6) | (uint32_t)(byte >> 2);
+    if(++sim->spi_bytes < 3) return;
+    sim->spi_bytes = 0;
+    sim->burst = 1;
+    Sim_Data(sim, sim->spi_word & 0x3FFFF);
+}
+
+/**
+ * @brief Get the logical size of the picture for the current MADCTL
+ * @param sim Panel
+ * @param width Output: 320 or 480
+ * @param height Output: 480 or 320
+ */
+void Sim_Size(const Sim_t *sim, uint16_t *width, uint16_t *height){
+    *width = (sim->madctl & MADCTL_MV) ? SIM_HEIGHT : SIM_WIDTH;
+    *height = (sim->madctl & MADCTL_MV) ? SIM_WIDTH : SIM_HEIGHT;
+}
+
+/**
+ * @brief Convert a bus word to an RGB666 color for the current MADCTL
+ */
+static uint32_t Sim_Color(const Sim_t *sim, uint32_t word){
+    uint32_t first = (word >> 12) & 0x3F, green = (word >> 6) & 0x3F, last = word & 0x3F;
+    /* Without BGR these modules show DB17-DB12 as blue */
+    if(sim->madctl & MADCTL_BGR) return first << 16 | green << 8 | last;
+    return last << 16 | green << 8 | first;
+}
+
+/**
+ * @brief Read a pixel in the coordinates the driver draws with
+ * @param sim Panel
+ * @param x Column address
+ * @param y Page address
+ * @return RGB666 color (0x00RRGGBB with 6-bit channels, as ILI9488_RED etc.)
+ */
+uint32_t Sim_GetPixel(const Sim_t *sim, uint16_t x, uint16_t y){
+    uint16_t gx, gy;
+    if(!Sim_Glass(sim, x, y, &gx, &gy)) return 0;
+    return Sim_Color(sim, sim->gram[gy][gx]);
+}
+
+/**
+ * @brief Save a glass-ordered memory as a binary PPM image, in the coordinates the driver draws with
+ */
+static uint8_t Sim_WritePPM(const Sim_t *sim, const uint32_t (*memory)[SIM_WIDTH], const char *path, const char *note){
+    uint16_t width, height, gx, gy;
+    FILE *f = fopen(path, "wb");
+    if(!f) return 0;
+
+    Sim_Size(sim, &width, &height);
+    fprintf(f, "P6\n");
+    if(note) fprintf(f, "# %s\n", note);
+    fprintf(f, "%u %u\n255\n", width, height);
+    for(uint16_t y = 0; y < height; y++){
+        for(uint16_t x = 0; x < width; x++){
+            uint32_t color = Sim_Glass(sim, x, y, &gx, &gy) ? Sim_Color(sim, memory[gy][gx]) : 0;
+            uint8_t rgb[3];
+            for(int i = 0; i < 3; i++){
+                uint8_t c = (uint8_t)((color >> (16 - 8 * i)) & 0x3F);
+                rgb[i] = (uint8_t)(c << 2 | c >> 4);
+            }
+            fwrite(rgb, 1, 3, f);
+        }
+    }
+    return fclose(f) == 0;
+}
+
+/**
+ * @brief Save the frame memory as a binary PPM image, in the coordinates the driver draws with
+ * @param sim Panel
+ * @param path Output file
+ * @param note Text stored as a comment in the header, or NULL
+ * @return 1 on success, 0 if the file cannot be written
+ */
+uint8_t Sim_SavePPM(const Sim_t *sim, const char *path, const char *note){
+    return Sim_WritePPM(sim, (const uint32_t (*)[SIM_WIDTH])sim->gram, path, note);
+}
+
+/**
+ * @brief Save the rows of the refresh scan as a binary PPM image, in the coordinates the driver draws with
+ * @param sim Panel
+ * @param path Output file
+ * @param note Text stored as a comment in the header, or NULL
+ * @return 1 on success, 0 if the file cannot be written
+ */
+uint8_t Sim_SaveRefreshPPM(const Sim_t *sim, const char *path, const char *note){
+    return Sim_WritePPM(sim, (const uint32_t (*)[SIM_WIDTH])sim->seen, path, note);
+}
+
+/**
+ * @brief Read one number of a PPM header, keeping the first comment
+ * @return Value, or -1 on a malformed header
+ */
+static int32_t Sim_PPMNumber(FILE *f, char *note, uint32_t note_size){
+    int c = fgetc(f);
+    for(;;){
+        while(c == ' ' || c == '\t' || c == '\r' || c == '\n') c = fgetc(f);
+        if(c != '#') break;
+        c = fgetc(f);
+        if(c == ' ') c = fgetc(f);
+        uint32_t length = 0;
+        uint8_t keep = note && note_size && !note[0];
+        while(c != '\n' && c != EOF){
+            if(keep && length + 1 < note_size) note[length++] = (char)c;
+            c = fgetc(f);
+        }
+        if(keep) note[length] = 0;
+    }
+    if(c < '0' || c > '9') return -1;
+    int32_t value = 0;
+    while(c >= '0' && c <= '9' && value < 100000){
+        value = value * 10 + (c - '0');
+        c = fgetc(f);
+    }
+    return value;
+}
+
+/**
+ * @brief Compare the frame memory with a PPM image saved by Sim_SavePPM()
+ * @param sim Panel
+ * @param path Image file
+ * @param note Output: comment stored in the image header, empty if none (may be NULL)
+ * @param note_size Size of the note buffer
+ * @return Number of pixels that differ in their 6-bit channels, or -1 if the
+ *         image cannot be read or its size differs from the current picture
+ */
+int64_t Sim_ComparePPM(const Sim_t *sim, const char *path, char *note, uint32_t note_size){
+    uint16_t width, height;
+    int64_t differ = 0;
+    FILE *f = fopen(path, "rb");
+    if(note && note_size) note[0] = 0;
+    if(!f) return -1;
+
+    Sim_Size(sim, &width, &height);
+    if(fgetc(f) != 'P' || fgetc(f) != '6' || Sim_PPMNumber(f, note, note_size) != width ||
+       Sim_PPMNumber(f, note, note_size) != height || Sim_PPMNumber(f, note, note_size) != 255){
+        fclose(f);
+        return -1;
+    }
+    for(uint16_t y = 0; y < height; y++){
+        for(uint16_t x = 0; x < width; x++){
+            uint8_t rgb[3];
+            if(fread(rgb, 1, 3, f) != 3){
+                fclose(f);
+                return -1;
+            }
+            uint32_t color = (uint32_t)(rgb[0] >> 2) << 16 | (uint32_t)(rgb[1] >> 2) << 8 | (rgb[2] >> 2);
+            if(color != Sim_GetPixel(sim, x, y)) differ++;
+        }
+    }
+    fclose(f);
+    return differ;
+}
+
+/**
+ * @brief Print the issue and wasted word counters
+ * @param sim Panel
+ * @param out Destination
+ * @return Total number of issues
+ */
+uint64_t Sim_Report(const Sim_t *sim, FILE *out){
+    uint64_t issues = 0, wasted = 0, words = sim->commands + sim->data_words;
+
+    for(int i = 0; i < SIM_ISSUES; i++){
+        if(sim->issues[i]) fprintf(out, "%10llu  %s\n", (unsigned long long)sim->issues[i], sim_issue_names[i]);
+        issues += sim->issues[i];
+    }
+    for(int i = 0; i < SIM_WASTES; i++) wasted += sim->wasted[i];
+    fprintf(out, "%llu issues, %llu of %llu bus words wasted (%.1f%%)\n", (unsigned long long)issues,
+            (unsigned long long)wasted, (unsigned long long)words, words ? 100.0 * wasted / words : 0.0);
+    for(int i = 0; i < SIM_WASTES; i++){
+        if(sim->wasted[i]) fprintf(out, "%10llu  %s\n", (unsigned long long)sim->wasted[i], sim_waste_names[i]);
+    }
+    return issues;
+}
+
+/**
+ * @brief Print the transitions per bus line
+ * @param sim Panel
+ * @param out Destination
+ */
+void Sim_ReportToggles(const Sim_t *sim, FILE *out){
+    static const char *const controls[3] = {"WR", "CS", "DCX"};
+    uint64_t data = 0;
+
+    fprintf(out, "line      toggles\n");
+    for(int line = 0; line < SIM_LINES; line++){
+        if(line < 18){
+            fprintf(out, "DB%-4d %10llu\n", line, (unsigned long long)sim->toggles[line]);
+            data += sim->toggles[line];
+        }
+        else{
+            fprintf(out, "%-6s %10llu\n", controls[line - 18], (unsigned long long)sim->toggles[line]);
+        }
+    }
+    fprintf(out, "%llu data line toggles, %llu if only changed lines were driven\n",
+            (unsigned long long)data, (unsigned long long)sim->toggles_changed);
+}
@@ -0,0 +1,329 @@
+/**
+ * @file ili9488_sim.h
+ * @brief Host-side ILI9488 panel simulator
+ * @details This header file contains the declarations for a PC model of the
+ *          ILI9488 controller as the driver uses it: the command set of
+ *          ili9488.c, the column/page address window, MADCTL rotation and
+ *          mirroring, and the 320x480 frame memory. It is fed with the
+ *          commands and data words that went over the bus, for example from a
+ *          trace recorded with ili9488_trace.c, and the frame memory can be
+ *          read back as pixels or saved as an image.
+ *
+ *          The frame memory is kept as seen on the glass in portrait. The
+ *          model follows the common ILI9488 modules that need the MX and BGR
+ *          bits of MADCTL for an upright picture with red on DB17-DB12, which
+ *          is what ILI9488_Init() sets.
+ *
+ *          With Sim_StartScan() the model also runs the refresh scan: the
+ *          glass rows are read out top to bottom, one per line time, while
+ *          each bus word takes word_ns of simulated time. The rows shown in
+ *          one refresh form what the viewer saw, and a refresh that showed
+ *          part of a memory write (0x2C and the pixels after it) but not the
+ *          rest is counted as torn. Sim_Vsync() aligns the scan with a TE
+ *          edge seen by the driver. Vertical scrolling is not modelled.
+ *
+ *          The model also counts the transitions on each bus line the way
+ *          ILI9488_Write18() drives them (all data lines cleared, then the 1
+ *          bits set), with CS and DCX framing every command and data word,
+ *          or a whole pixel burst while the feeder sets Sim_t.burst. In a
+ *          burst, Sim_Repeat() of the last word only strobes WR, as
+ *          ILI9488_WriteBusRun() does.
+ *
+ *          Byte streams of the SPI transport (ILI9488_TRANSPORT_SPI) are
+ *          decoded by Sim_SpiByte(): bytes with DCX low are commands, bytes
+ *          with DCX high are parameters, or during a memory write thirds of
+ *          an 18 bpp pixel with a channel in the upper six bits of each. CS
+ *          going high (Sim_Deselect()) drops a pixel in progress, as the
+ *          panel does. The line transitions still follow the 8080 bus.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#ifndef __ILI9488_SIM_H
+#define __ILI9488_SIM_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define SIM_WIDTH   320
+#define SIM_HEIGHT  480
+
+/* Validation switches for Sim_t.validate */
+#define SIM_VALIDATE_PROTOCOL  0x01  ///< Command, parameter and window usage
+#define SIM_VALIDATE_TIMING    0x02  ///< Delays after reset, sleep in and sleep out (needs Sim_Advance())
+
+/* Command delays of the datasheet, in nanoseconds */
+#define SIM_COMMAND_DELAY_NS   5000000ull    ///< After reset, sleep in and sleep out, before any command
+#define SIM_SLEEP_DELAY_NS     120000000ull  ///< After sleep out, before sleep in
+
+/* Bus lines counted in Sim_t.toggles, after DB0-DB17 */
+#define SIM_LINE_WR            18
+#define SIM_LINE_CS            19
+#define SIM_LINE_DCX           20
+#define SIM_LINES              21
+
+/* Refresh scan */
+#define SIM_FRAME_NS           16666667ull   ///< Refresh period, close to the frame rate at reset
+#define SIM_BLANK_LINES        4             ///< Front and back porch lines, the vertical blanking
+
+/**
+ * @brief Protocol issues found by the validator
+ */
+typedef enum {
+    SIM_ISSUE_NO_MEMORY_WRITE = 0, ///< Data words with no command expecting them (pixels without 0x2C)
+    SIM_ISSUE_PARAMETERS,          ///< Command followed by fewer parameters than it takes
+    SIM_ISSUE_WINDOW,              ///< Address window reversed or outside the frame memory for the MADCTL
+    SIM_ISSUE_PIXEL_COUNT,         ///< Memory write with more or fewer pixels than the window holds
+    SIM_ISSUE_BUSY,                ///< Command sent during a reset or sleep mode delay
+    SIM_ISSUES
+} Sim_Issue_t;
+
+/**
+ * @brief Bus words that had no visible effect
+ */
+typedef enum {
+    SIM_WASTE_STRAY = 0,           ///< Data words with no command expecting them
+    SIM_WASTE_CLIPPED,             ///< Pixels addressed outside the frame memory
+    SIM_WASTE_OVERRUN,             ///< Pixels past the end of the window, which wrap and overwrite it
+    SIM_WASTE_REDUNDANT,           ///< Commands and parameters setting a register to its current value
+    SIM_WASTES
+} Sim_Waste_t;
+
+typedef struct Sim Sim_t;
+
+/**
+ * @brief Called at the end of every refresh, with Sim_t.seen holding what the viewer saw
+ * @param sim Panel
+ * @param torn Memory writes shown in part in this refresh
+ * @param stale Rows written after the scan had shown them
+ * @param context Context given to Sim_StartScan()
+ */
+typedef void (*Sim_RefreshFn_t)(Sim_t *sim, uint32_t torn, uint16_t stale, void *context);
+
+/**
+ * @brief Panel state
+ */
+struct Sim {
+    uint32_t gram[SIM_HEIGHT][SIM_WIDTH]; ///< Frame memory as bus words, glass rows of glass columns
+
+    /* Registers */
+    uint8_t madctl;            ///< Memory access control (0x36)
+    uint8_t pixel_format;      ///< Interface pixel format (0x3A)
+    uint8_t sleeping;          ///< 1 in sleep mode
+    uint8_t display_on;        ///< 1 after display on (0x29)
+    uint8_t te_on;             ///< 1 after tearing effect line on (0x35)
+    uint8_t scrolling;         ///< 1 after a scroll start (0x37), until normal mode (0x13)
+    uint16_t column_start;     ///< Column window (0x2A)
+    uint16_t column_end;
+    uint16_t page_start;       ///< Page window (0x2B)
+    uint16_t page_end;
+    uint16_t scroll_top;       ///< Vertical scrolling definition (0x33)
+    uint16_t scroll_area;
+    uint16_t scroll_bottom;
+    uint16_t scroll_start;     ///< Vertical scrolling start (0x37)
+
+    /* Command decoder */
+    uint8_t command;           ///< Last command
+    uint8_t param_count;       ///< Parameters received for it
+    uint8_t params[16];        ///< First parameters received for it (low byte of each word)
+    uint8_t writing;           ///< 1 while pixels go to memory (after 0x2C or 0x3C)
+    uint16_t column;           ///< Address counter
+    uint16_t page;
+    uint8_t spi_bytes;         ///< Bytes of the SPI pixel in progress (Sim_SpiByte())
+    uint32_t spi_word;         ///< Bus word assembled from them
+
+    /* Statistics */
+    uint64_t commands;         ///< Commands received
+    uint64_t data_words;       ///< Data words received, parameters and pixels
+    uint64_t pixels;           ///< Pixels stored in frame memory
+
+    /* Validation, enabled with SIM_VALIDATE_* bits after Sim_Init() */
+    uint8_t validate;          ///< SIM_VALIDATE_* bits
+    FILE *log;                 ///< Destination of issue messages, NULL to only count them
+    uint64_t time_ns;          ///< Simulated time, moved forward with Sim_Advance()
+    uint64_t busy_until_ns;    ///< End of the current reset or sleep mode delay
+    uint64_t sleep_out_ns;     ///< Time of the last sleep out
+    uint8_t memory_write;      ///< 1 from 0x2C until the window or MADCTL changes
+    uint64_t window_area;      ///< Pixels in the window at the last 0x2C
+    uint64_t window_written;   ///< Pixels sent since the last 0x2C, including 0x3C continuations
+    uint64_t window_command;   ///< Index of the last 0x2C
+    uint64_t issues[SIM_ISSUES];   ///< Issues found, per kind
+    uint64_t wasted[SIM_WASTES];   ///< Wasted bus words, per kind
+
+    /* Refresh scan, enabled with Sim_StartScan() */
+    uint8_t scan;              ///< 1 while the scan runs
+    uint64_t frame_ns;         ///< Refresh period
+    uint64_t word_ns;          ///< Bus time of each command and data word
+    uint64_t scan_next_ns;     ///< Time of the next scan line
+    uint16_t scan_row;         ///< Next glass row, SIM_HEIGHT and above in the blanking
+    uint64_t update;           ///< Memory writes opened (0x2C)
+    uint64_t row_update[SIM_HEIGHT];  ///< Memory write that last stored a pixel in each glass row
+    uint64_t row_pixel[SIM_HEIGHT];   ///< Value of pixels at that store
+    uint64_t shown_update[SIM_HEIGHT];///< row_update of each row as the scan showed it
+    uint64_t shown_pixel[SIM_HEIGHT]; ///< row_pixel of each row as the scan showed it
+    uint32_t seen[SIM_HEIGHT][SIM_WIDTH]; ///< Rows as the scan showed them in the refresh in progress
+    uint64_t refreshes;        ///< Refreshes completed
+    uint64_t torn_refreshes;   ///< Refreshes that showed part of a memory write
+    uint64_t torn_writes;      ///< Memory writes shown in part, over all refreshes
+    Sim_RefreshFn_t on_refresh;///< Called after each refresh, or NULL
+    void *refresh_context;     ///< Passed to on_refresh
+
+    /* Bus lines */
+    uint8_t burst;             ///< Set by the feeder while CS stays low over a pixel burst, 0 to frame every word
+    uint8_t cs_low;            ///< 1 while CS is low
+    uint8_t dcx;               ///< DCX level
+    uint32_t bus;              ///< Data lines after the last word
+    uint64_t toggles[SIM_LINES];   ///< Transitions per line: DB0-DB17, WR, CS, DCX
+    uint64_t toggles_changed;  ///< Data line transitions if only the changed lines were driven
+};
+
+/**
+ * @brief Initialize a panel: clear the frame memory, statistics and validation state, and load the reset register values
+ * @param sim Panel
+ * @details Unlike Sim_Reset() this starts no reset delay, so a trace that
+ *          begins after the panel was set up can be fed right away.
+ */
+void Sim_Init(Sim_t *sim);
+
+/**
+ * @brief Put the panel in its hardware reset state
+ * @param sim Panel
+ * @details The frame memory is kept; a real panel powers up with random
+ *          contents. Commands within SIM_COMMAND_DELAY_NS are reported by the
+ *          timing validation.
+ */
+void Sim_Reset(Sim_t *sim);
+
+/**
+ * @brief Move the simulated time forward
+ * @param sim Panel
+ * @param ns Nanoseconds since the previous call
+ */
+void Sim_Advance(Sim_t *sim, uint64_t ns);
+
+/**
+ * @brief Start the refresh scan at the current time, with the first glass row
+ * @param sim Panel
+ * @param frame_ns Refresh period, 0 for SIM_FRAME_NS
+ * @param on_refresh Called after each refresh, or NULL
+ * @param context Passed to on_refresh
+ */
+void Sim_StartScan(Sim_t *sim, uint64_t frame_ns, Sim_RefreshFn_t on_refresh, void *context);
+
+/**
+ * @brief Align the refresh scan with a TE rising edge at the current time
+ * @param sim Panel
+ * @details The rows not shown yet are shown now and the blanking starts, as
+ *          the edge marks the end of the last row.
+ */
+void Sim_Vsync(Sim_t *sim);
+
+/**
+ * @brief End a pixel burst: CS goes high
+ * @param sim Panel
+ * @details Call between two bursts of the same memory write, which the
+ *          driver sends with CS raised in between.
+ */
+void Sim_Deselect(Sim_t *sim);
+
+/**
+ * @brief Close the memory write in progress, so its pixel count is checked
+ * @param sim Panel
+ * @details Call at the end of the input before reading the issue counters.
+ */
+void Sim_Finish(Sim_t *sim);
+
+/**
+ * @brief Print the issue and wasted word counters
+ * @param sim Panel
+ * @param out Destination
+ * @return Total number of issues
+ */
+uint64_t Sim_Report(const Sim_t *sim, FILE *out);
+
+/**
+ * @brief Print the transitions per bus line
+ * @param sim Panel
+ * @param out Destination
+ */
+void Sim_ReportToggles(const Sim_t *sim, FILE *out);
+
+/**
+ * @brief Feed a command
+ * @param sim Panel
+ * @param cmd Command byte
+ */
+void Sim_Command(Sim_t *sim, uint8_t cmd);
+
+/**
+ * @brief Feed a data word
+ * @param sim Panel
+ * @param word 18-bit bus word
+ */
+void Sim_Data(Sim_t *sim, uint32_t word);
+
+/**
+ * @brief Feed the same data word several times
+ * @param sim Panel
+ * @param word 18-bit bus word
+ * @param count Number of words
+ */
+void Sim_Repeat(Sim_t *sim, uint32_t word, uint32_t count);
+
+/**
+ * @brief Feed a byte received on the SPI bus
+ * @param sim Panel
+ * @param dcx DCX level while the byte was sent: 0 for a command, 1 for data
+ * @param byte Byte on MOSI
+ */
+void Sim_SpiByte(Sim_t *sim, uint8_t dcx, uint8_t byte);
+
+/**
+ * @brief Get the logical size of the picture for the current MADCTL
+ * @param sim Panel
+ * @param width Output: 320 or 480
+ * @param height Output: 480 or 320
+ */
+void Sim_Size(const Sim_t *sim, uint16_t *width, uint16_t *height);
+
+/**
+ * @brief Read a pixel in the coordinates the driver draws with
+ * @param sim Panel
+ * @param x Column address
+ * @param y Page address
+ * @return RGB666 color (0x00RRGGBB with 6-bit channels, as ILI9488_RED etc.)
+ */
+uint32_t Sim_GetPixel(const Sim_t *sim, uint16_t x, uint16_t y);
+
+/**
+ * @brief Save the frame memory as a binary PPM image, in the coordinates the driver draws with
+ * @param sim Panel
+ * @param path Output file
+ * @param note Text stored as a comment in the header, or NULL
+ * @return 1 on success, 0 if the file cannot be written
+ */
+uint8_t Sim_SavePPM(const Sim_t *sim, const char *path, const char *note);
+
+/**
+ * @brief Save the rows of the refresh scan as a binary PPM image, in the coordinates the driver draws with
+ * @param sim Panel
+ * @param path Output file
+ * @param note Text stored as a comment in the header, or NULL
+ * @return 1 on success, 0 if the file cannot be written
+ * @details Holds what the viewer saw when called from the on_refresh callback.
+ */
+uint8_t Sim_SaveRefreshPPM(const Sim_t *sim, const char *path, const char *note);
+
+/**
+ * @brief Compare the frame memory with a PPM image saved by Sim_SavePPM()
+ * @param sim Panel
+ * @param path Image file
+ * @param note Output: comment stored in the image header, empty if none (may be NULL)
+ * @param note_size Size of the note buffer
+ * @return Number of pixels that differ in their 6-bit channels, or -1 if the
+ *         image cannot be read or its size differs from the current picture
+ */
+int64_t Sim_ComparePPM(const Sim_t *sim, const char *path, char *note, uint32_t note_size);
+
+#endif /* __ILI9488_SIM_H */
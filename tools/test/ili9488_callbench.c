@@ -0,0 +1,91 @@
+/**
+ * @file ili9488_callbench.c
+ * @brief Per-call bench of the driver API
+ * @details This host program calls each drawing function of the driver once
+ *          in portrait, with the driver built for the PC, records the bus
+ *          with the trace recorder of ili9488_trace.c and marks the end of
+ *          every call with ILI9488_TraceMark(). The replay tool then prices
+ *          every call on its own:
+ *
+ *              ili9488_callbench calls.trace
+ *              ili9488_replay -b -o calls calls.trace
+ *
+ *          so each "case N" row of the bench is one API call. The program
+ *          prints the call behind every N first. Window setup and the pixels
+ *          of the raw writes share a mark, as a caller always pairs them.
+ *
+ *          Build:  make -C tools (tools/build/ili9488_callbench)
+ *          Usage:  ili9488_callbench calls.trace
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "ili9488.h"
+#include "ili9488_trace.h"
+
+/* Block of the bitmap and raw write calls */
+#define CALLBENCH_BLOCK  64
+
+static uint32_t callbench_pixels[CALLBENCH_BLOCK * CALLBENCH_BLOCK];
+static uint32_t callbench_words[CALLBENCH_BLOCK * CALLBENCH_BLOCK];
+static uint32_t callbench_mark;
+
+/* Run one call, name it and mark its end */
+#define CALLBENCH(call) do { \
+        call; \
+        printf("case %-4u %s\n", (unsigned)callbench_mark, #call); \
+        ILI9488_TraceMark(callbench_mark++); \
+    } while(0)
+
+static void Callbench_Write(void *context, const uint8_t *data, uint32_t size){
+    fwrite(data, 1, size, (FILE *)context);
+}
+
+int main(int argc, char **argv){
+    if(argc != 2){
+        fprintf(stderr, "usage: ili9488_callbench calls.trace\n");
+        return 2;
+    }
+
+    for(uint32_t i = 0; i < CALLBENCH_BLOCK * CALLBENCH_BLOCK; i++){
+        callbench_pixels[i] = (i * 2654435761u) >> 8 & 0x3F3F3F;
+        callbench_words[i] = ILI9488_COLOR_TO_BUS(callbench_pixels[i]);
+    }
+
+    CALLBENCH(ILI9488_Init(ILI9488_ROTATION_PORTRAIT));
+    CALLBENCH(ILI9488_FillBackground(ILI9488_BLACK));
+    CALLBENCH(ILI9488_FillRect(10, 10, 100, 50, ILI9488_RED));
+    CALLBENCH(ILI9488_DrawRect(10, 70, 100, 50, ILI9488_GREEN));
+    CALLBENCH(ILI9488_DrawLine(0, 200, 319, 200, ILI9488_WHITE));
+    CALLBENCH(ILI9488_DrawLine(160, 0, 160, 479, ILI9488_WHITE));
+    CALLBENCH(ILI9488_DrawLine(0, 0, 319, 479, ILI9488_YELLOW));
+    CALLBENCH(ILI9488_DrawLine(0, 479, 319, 300, ILI9488_CYAN));
+    CALLBENCH(ILI9488_DrawCircle(160, 240, 100, ILI9488_MAGENTA));
+    CALLBENCH(ILI9488_FillCircle(160, 240, 50, ILI9488_BLUE));
+    CALLBENCH(ILI9488_DrawPixel(5, 5, ILI9488_WHITE));
+    CALLBENCH(ILI9488_DrawBitmap(20, 300, CALLBENCH_BLOCK, CALLBENCH_BLOCK, callbench_pixels));
+    CALLBENCH(ILI9488_SetWindow(100, 300, CALLBENCH_BLOCK, CALLBENCH_BLOCK);
+              ILI9488_WritePixels(callbench_pixels, CALLBENCH_BLOCK * CALLBENCH_BLOCK));
+    CALLBENCH(ILI9488_SetWindow(180, 300, CALLBENCH_BLOCK, CALLBENCH_BLOCK);
+              ILI9488_WriteColor(ILI9488_RED, CALLBENCH_BLOCK * CALLBENCH_BLOCK));
+    CALLBENCH(ILI9488_SetWindow(20, 380, CALLBENCH_BLOCK, CALLBENCH_BLOCK);
+              ILI9488_WriteBus(callbench_words, CALLBENCH_BLOCK * CALLBENCH_BLOCK));
+    CALLBENCH(ILI9488_SetWindow(100, 380, CALLBENCH_BLOCK, CALLBENCH_BLOCK);
+              ILI9488_WriteBusRun(ILI9488_COLOR_TO_BUS(ILI9488_GREEN), CALLBENCH_BLOCK * CALLBENCH_BLOCK));
+
+    FILE *file = fopen(argv[1], "wb");
+    if(!file){
+        fprintf(stderr, "ili9488_callbench: cannot write %s\n", argv[1]);
+        return 2;
+    }
+    uint32_t size = ILI9488_TraceDump(Callbench_Write, file);
+    fclose(file);
+    if(size >= ILI9488_TRACE_SIZE){
+        fprintf(stderr, "ili9488_callbench: the trace filled the ring, raise ILI9488_TRACE_SIZE\n");
+        return 1;
+    }
+    return 0;
+}
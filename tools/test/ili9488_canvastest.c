@@ -0,0 +1,155 @@
+/**
+ * @file ili9488_canvastest.c
+ * @brief Test of the canvas operations with and without the DMA2D
+ * @details This host program runs a fixed sequence of fills, copies (plain
+ *          and with pixel format conversion) and blends (opaque and with a
+ *          global alpha) into canvases of every format, from sources of
+ *          every format, and writes the destination canvas after each step
+ *          to a file. It is built twice: with the software path, and with
+ *          ILI9488_DMA2D and the register model of ili9488_dma2d.c. The
+ *          DMA2D build is given the file of the software build and fails on
+ *          the first step whose canvas differs, so the register programming
+ *          is checked pixel by pixel against the software path. It also
+ *          fails if a transfer mode was never run by the model.
+ *
+ *          Sources start at an offset inside their canvas and destinations
+ *          do not span the canvas width, so the line offsets are exercised.
+ *
+ *          Build:  make -C tools (tools/build/ili9488_canvastest and
+ *                  tools/build/ili9488_canvastest_dma2d)
+ *          Usage:  ili9488_canvastest out.bin [expected.bin]
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "ili9488_canvas.h"
+
+/* Destination and source canvas sizes */
+#define CANVAS_W      64
+#define CANVAS_H      40
+#define SOURCE_W      24
+#define SOURCE_H      16
+
+/* Bytes per pixel of the formats */
+static const uint8_t canvas_bytes[3] = { 4, 3, 2 };
+static const char *const canvas_names[3] = { "ARGB8888", "RGB888", "RGB565" };
+
+static uint32_t canvas_dst_pixels[CANVAS_W * CANVAS_H];
+static uint32_t canvas_src_pixels[3][SOURCE_W * SOURCE_H];
+static ILI9488_Canvas_t canvas_dst, canvas_src[3];
+
+/* Steps run, and the file the canvases are written to and compared with */
+static uint32_t canvas_step;
+static FILE *canvas_out, *canvas_expected;
+static uint32_t canvas_failures;
+
+/**
+ * @brief Write the destination canvas after a step, and compare it with the expected one
+ * @param ok Return value of the canvas call
+ * @param what Description of the step
+ */
+static void Canvas_Step(uint8_t ok, const char *what){
+    static uint8_t expected[CANVAS_W * CANVAS_H * 4];
+    uint32_t size = (uint32_t)CANVAS_W * CANVAS_H * canvas_bytes[canvas_dst.format];
+    const uint8_t *pixels = (const uint8_t *)canvas_dst.pixels;
+
+    ILI9488_CanvasWait();
+    canvas_step++;
+    if(!ok){
+        printf("step %u, %s into %s: rejected\n", (unsigned)canvas_step, what, canvas_names[canvas_dst.format]);
+        canvas_failures++;
+    }
+    fwrite(pixels, 1, size, canvas_out);
+    if(!canvas_expected || canvas_failures) return;
+
+    if(fread(expected, 1, size, canvas_expected) != size){
+        printf("step %u: missing from the expected file\n", (unsigned)canvas_step);
+        canvas_failures++;
+        return;
+    }
+    for(uint32_t i = 0; i < size; i++){
+        if(pixels[i] == expected[i]) continue;
+        uint32_t pixel = i / canvas_bytes[canvas_dst.format];
+        printf("step %u, %s into %s: differs first at (%u, %u)\n", (unsigned)canvas_step, what,
+               canvas_names[canvas_dst.format], (unsigned)(pixel % CANVAS_W), (unsigned)(pixel / CANVAS_W));
+        canvas_failures++;
+        return;
+    }
+}
+
+/**
+ * @brief Run the sequence into a destination canvas of one format
+ */
+static void Canvas_Run(ILI9488_CanvasFormat_t format){
+    char what[64];
+
+    ILI9488_CanvasInit(&canvas_dst, canvas_dst_pixels, CANVAS_W, CANVAS_H, format);
+    Canvas_Step(ILI9488_CanvasFill(&canvas_dst, 0, 0, CANVAS_W, CANVAS_H, 0xFF203040u), "fill");
+    Canvas_Step(ILI9488_CanvasFill(&canvas_dst, 5, 3, 33, 17, 0x80F08010u), "fill with alpha");
+
+    for(uint32_t s = 0; s < 3; s++){
+        snprintf(what, sizeof(what), "copy from %s", canvas_names[s]);
+        Canvas_Step(ILI9488_CanvasCopy(&canvas_dst, (uint16_t)(s * 20 + 1), 2, &canvas_src[s], 3, 2, 19, 12), what);
+    }
+    for(uint32_t s = 0; s < 3; s++){
+        snprintf(what, sizeof(what), "blend from %s", canvas_names[s]);
+        Canvas_Step(ILI9488_CanvasBlend(&canvas_dst, (uint16_t)(s * 20 + 2), 18, &canvas_src[s], 1, 1, 21, 14, 255), what);
+        snprintf(what, sizeof(what), "blend from %s at alpha 128", canvas_names[s]);
+        Canvas_Step(ILI9488_CanvasBlend(&canvas_dst, (uint16_t)(s * 18 + 3), 24, &canvas_src[s], 0, 0, SOURCE_W, SOURCE_H, 128), what);
+    }
+}
+
+int main(int argc, char **argv){
+    if(argc < 2 || argc > 3){
+        fprintf(stderr, "usage: ili9488_canvastest out.bin [expected.bin]\n");
+        return 2;
+    }
+    canvas_out = fopen(argv[1], "wb");
+    if(!canvas_out){
+        fprintf(stderr, "ili9488_canvastest: cannot write %s\n", argv[1]);
+        return 2;
+    }
+    if(argc == 3 && !(canvas_expected = fopen(argv[2], "rb"))){
+        fprintf(stderr, "ili9488_canvastest: cannot read %s\n", argv[2]);
+        return 2;
+    }
+
+    /* Sources: gradients, the ARGB8888 one with an alpha ramp from clear to opaque */
+    for(uint32_t s = 0; s < 3; s++){
+        ILI9488_CanvasInit(&canvas_src[s], canvas_src_pixels[s], SOURCE_W, SOURCE_H, (ILI9488_CanvasFormat_t)s);
+        for(uint32_t y = 0; y < SOURCE_H; y++){
+            for(uint32_t x = 0; x < SOURCE_W; x++){
+                uint32_t argb = (x * 255 / (SOURCE_W - 1)) << 24 | (x * 11) << 16 | (y * 17) << 8 | ((x + y) * 7 & 0xFF);
+                uint8_t *p = (uint8_t *)canvas_src_pixels[s] + (y * SOURCE_W + x) * canvas_bytes[s];
+                if(s == ILI9488_CANVAS_ARGB8888) memcpy(p, &argb, 4);
+                else if(s == ILI9488_CANVAS_RGB888){
+                    p[0] = (uint8_t)argb;
+                    p[1] = (uint8_t)(argb >> 8);
+                    p[2] = (uint8_t)(argb >> 16);
+                }
+                else{
+                    uint16_t v = (uint16_t)(((argb >> 8) & 0xF800) | ((argb >> 5) & 0x07E0) | ((argb >> 3) & 0x001F));
+                    memcpy(p, &v, 2);
+                }
+            }
+        }
+    }
+
+    for(uint32_t format = 0; format < 3; format++) Canvas_Run((ILI9488_CanvasFormat_t)format);
+    fclose(canvas_out);
+    if(canvas_expected) fclose(canvas_expected);
+
+#ifdef ILI9488_DMA2D
+    static const char *const modes[4] = { "memory to memory", "pixel format conversion", "blending", "register to memory" };
+    for(uint32_t mode = 0; mode < 4; mode++){
+        printf("%-24s %u DMA2D transfers\n", modes[mode], (unsigned)dma2d_transfers[mode]);
+        if(!dma2d_transfers[mode]) canvas_failures++;
+    }
+#endif
+    printf("%u steps, %u failed\n", (unsigned)canvas_step, (unsigned)canvas_failures);
+    return canvas_failures ? 1 : 0;
+}
@@ -0,0 +1,339 @@
+/**
+ * @file ili9488_cases.c
+ * @brief Golden image cases of the driver and its modules
+ * @details This host program draws a fixed set of cases in all four
+ *          rotations with the driver and its modules built for the PC (the
+ *          text cases with the fonts that ili9488_font makes of
+ *          test/case.bdf), records the bus with
+ *          the trace recorder of ili9488_trace.c (ILI9488_TRACE_PIXELS 1)
+ *          and marks the end of each case with ILI9488_TraceMark(). The dump
+ *          is checked by the replay tool:
+ *
+ *              ili9488_replay -c -g test/golden/case -o build/case cases.trace
+ *
+ *          -c validates the bus protocol and command timing, and -g compares
+ *          the picture of every case with its golden image and fails if the
+ *          case needs more bus words than the golden image recorded. Mark N
+ *          is case N % CASES_COUNT in rotation N / CASES_COUNT: 0 primitives
+ *          and clipping, 1 blits, raw bus writes, scrolling and sleep, 2 the
+ *          graphics modules (transition, barcode, affine, scale, sprite) and
+ *          3 the text modules (font, text, glyph cache, number). Scrolling
+ *          is not modelled by the simulator, so its case checks the protocol
+ *          and the bus words only.
+ *
+ *          After an intended change of the output, review the new images and
+ *          save them as the golden ones with make -C tools golden.
+ *
+ *          Build:  make -C tools (tools/build/ili9488_cases)
+ *          Usage:  ili9488_cases cases.trace
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "ili9488.h"
+#include "ili9488_affine.h"
+#include "ili9488_barcode.h"
+#include "ili9488_font.h"
+#include "ili9488_glyphcache.h"
+#include "ili9488_number.h"
+#include "ili9488_scale.h"
+#include "ili9488_sprite.h"
+#include "ili9488_text.h"
+#include "ili9488_trace.h"
+#include "ili9488_transition.h"
+
+/* Fonts converted from test/case.bdf: 1-bit with kerning, and 4-bit downsampled by 2 */
+extern const uint32_t case_font[];
+extern const uint32_t case_font4[];
+
+/* Bitmap of the blit, affine and scale cases */
+#define CASES_BITMAP_W  37
+#define CASES_BITMAP_H  23
+
+/* Sprite size and its color key */
+#define CASES_SPRITE     16
+#define CASES_KEY        0x3F003F
+
+static uint32_t cases_bitmap[CASES_BITMAP_W * CASES_BITMAP_H];
+static uint32_t cases_sprite[2 * CASES_SPRITE * CASES_SPRITE];
+
+/**
+ * @brief Color of the page the transition draws, also the sprite background
+ */
+static uint32_t Cases_Page(uint32_t x, uint32_t y){
+    uint32_t band = ((x + y) / 16) & 0x0F;
+    return ((x / 24 + y / 24) & 1) ? 0x0A1420 + band : 0x141E0A + (band << 8);
+}
+
+/**
+ * @brief Draw a region of the transition page
+ */
+static void Cases_DrawPage(uint16_t x, uint16_t y, uint16_t w, uint16_t h){
+    static uint32_t row[ILI9488_LANDSCAPE_WIDTH];
+    for(uint16_t j = 0; j < h; j++){
+        for(uint16_t i = 0; i < w; i++) row[i] = Cases_Page(x + i, y + j);
+        ILI9488_DrawBitmap(x, y + j, w, 1, row);
+    }
+}
+
+/**
+ * @brief Render a region of the transition page for the sprite engine
+ */
+static void Cases_Background(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint32_t *dst){
+    for(uint16_t j = 0; j < h; j++){
+        for(uint16_t i = 0; i < w; i++) *dst++ = Cases_Page(x + i, y + j);
+    }
+}
+
+/**
+ * @brief Lines, rectangles, circles and pixels, reaching and crossing the screen edges
+ */
+static void Cases_Primitives(void){
+    uint16_t w = ILI9488_GetWidth(), h = ILI9488_GetHeight();
+
+    ILI9488_FillBackground(0x00000F);
+
+    /* Lines: diagonals, straight, steep and flat, single points */
+    ILI9488_DrawLine(0, 0, w - 1, h - 1, ILI9488_WHITE);
+    ILI9488_DrawLine(w - 1, 0, 0, h - 1, ILI9488_YELLOW);
+    ILI9488_DrawLine(0, 10, w - 1, 10, ILI9488_RED);
+    ILI9488_DrawLine(10, 0, 10, h - 1, ILI9488_GREEN);
+    ILI9488_DrawLine(20, 20, 23, 120, ILI9488_CYAN);
+    ILI9488_DrawLine(20, 30, 200, 33, ILI9488_MAGENTA);
+    ILI9488_DrawLine(5, 5, 5, 5, ILI9488_WHITE);
+
+    /* Lines and rectangles past the right and bottom edges, clipped */
+    ILI9488_DrawLine(w - 40, 40, w + 60, 90, ILI9488_CYAN);
+    ILI9488_DrawLine(40, h - 30, 100, h + 200, ILI9488_CYAN);
+    ILI9488_DrawLine(w + 10, 20, w + 50, 60, ILI9488_RED);
+    ILI9488_DrawRect(w - 15, 100, 40, 20, ILI9488_MAGENTA);
+    ILI9488_DrawRect(120, h - 12, 30, 50, ILI9488_MAGENTA);
+    ILI9488_DrawRect(w + 5, h + 5, 10, 10, ILI9488_RED);
+
+    /* Rectangles */
+    ILI9488_DrawRect(60, 60, 50, 30, ILI9488_YELLOW);
+    ILI9488_FillRect(70, 70, 30, 10, 0x20100A);
+    ILI9488_FillRect(w - 20, h - 20, 20, 20, ILI9488_BLUE);
+
+    /* Circles: radius 0 and 1, inside, and clipped by every edge */
+    ILI9488_DrawCircle(150, 150, 0, ILI9488_WHITE);
+    ILI9488_DrawCircle(160, 150, 1, ILI9488_WHITE);
+    ILI9488_DrawCircle(w / 2, h / 2, 60, ILI9488_GREEN);
+    ILI9488_FillCircle(w / 2, h / 2, 30, ILI9488_RED);
+    ILI9488_DrawCircle(0, h / 2, 40, ILI9488_YELLOW);
+    ILI9488_FillCircle(w - 1, 0, 35, ILI9488_MAGENTA);
+    ILI9488_FillCircle(w / 2, h - 1, 25, ILI9488_CYAN);
+
+    /* Pixels in the corners */
+    ILI9488_DrawPixel(0, 0, ILI9488_RED);
+    ILI9488_DrawPixel(w - 1, 0, ILI9488_GREEN);
+    ILI9488_DrawPixel(0, h - 1, ILI9488_BLUE);
+    ILI9488_DrawPixel(w - 1, h - 1, ILI9488_WHITE);
+}
+
+/**
+ * @brief Bitmaps, raw pixel and bus writes, touching the right and bottom
+ *        edges, then scrolling and a sleep cycle that must keep the picture
+ */
+static void Cases_Blits(void){
+    static uint32_t words[CASES_BITMAP_W];
+    uint16_t w = ILI9488_GetWidth(), h = ILI9488_GetHeight();
+
+    ILI9488_FillBackground(ILI9488_BLACK);
+    ILI9488_DrawBitmap(12, 17, CASES_BITMAP_W, CASES_BITMAP_H, cases_bitmap);
+    ILI9488_DrawBitmap(w - CASES_BITMAP_W, h - CASES_BITMAP_H, CASES_BITMAP_W, CASES_BITMAP_H, cases_bitmap);
+    ILI9488_DrawBitmap(0, h - 1, CASES_BITMAP_W, 1, cases_bitmap);
+
+    /* A window written in two parts, then a solid run */
+    ILI9488_SetWindow(100, 100, CASES_BITMAP_W, 2);
+    ILI9488_WritePixels(cases_bitmap, CASES_BITMAP_W);
+    ILI9488_WritePixels(cases_bitmap + 5 * CASES_BITMAP_W, CASES_BITMAP_W);
+    ILI9488_SetWindow(100, 110, 50, 4);
+    ILI9488_WriteColor(ILI9488_YELLOW, 200);
+
+    /* Bus words: a burst, a run, and the rest of the window after Memory Write Continue */
+    for(uint32_t i = 0; i < CASES_BITMAP_W; i++) words[i] = ILI9488_COLOR_TO_BUS(cases_bitmap[10 * CASES_BITMAP_W + i]);
+    ILI9488_SetWindow(100, 130, CASES_BITMAP_W, 4);
+    ILI9488_WriteBus(words, CASES_BITMAP_W);
+    ILI9488_WriteBusRun(ILI9488_COLOR_TO_BUS(ILI9488_CYAN), CASES_BITMAP_W + 5);
+    ILI9488_WriteContinue();
+    ILI9488_WriteBusRun(ILI9488_COLOR_TO_BUS(ILI9488_MAGENTA), CASES_BITMAP_W - 5);
+    ILI9488_WriteContinue();
+    ILI9488_WritePixels(cases_bitmap, CASES_BITMAP_W);
+
+    /* Scroll the middle of the panel and back, then sleep and wake up */
+    ILI9488_SetScrollArea(40, ILI9488_PORTRAIT_HEIGHT - 80, 40);
+    ILI9488_SetScrollStart(100);
+    ILI9488_SetScrollStart(0);
+    ILI9488_ResetScroll();
+    ILI9488_Sleep();
+    ILI9488_WakeUp();
+    ILI9488_DrawPixel(w - 1, 0, ILI9488_WHITE);
+}
+
+/**
+ * @brief Transition, barcodes, affine and scaled blits, and sprites
+ */
+static void Cases_Graphics(void){
+    static const char payload[] = "ILI9488 golden case";
+    uint16_t w = ILI9488_GetWidth();
+    ILI9488_Affine_t m;
+    static ILI9488_Sprite_t ring, cross, edge;
+
+    /* Two transitions to the page, the second one over the first */
+    ILI9488_FillBackground(ILI9488_BLACK);
+    ILI9488_RunTransition(ILI9488_TRANSITION_WIPE, ILI9488_DIRECTION_DOWN, Cases_DrawPage, 0);
+    ILI9488_RunTransition(ILI9488_TRANSITION_DISSOLVE, ILI9488_DIRECTION_UP, Cases_DrawPage, 0);
+
+    /* Barcodes */
+    ILI9488_DrawQRCode(8, 8, (const uint8_t *)payload, sizeof(payload) - 1, ILI9488_QR_ECC_MEDIUM, 2,
+                       ILI9488_BLACK, ILI9488_WHITE);
+    ILI9488_DrawCode128(90, 8, "ILI9488-8080", 1, 40, ILI9488_BLACK, ILI9488_WHITE);
+
+    /* Rotated, sheared and clipped textures */
+    ILI9488_DrawRotozoom(50, 120, cases_bitmap, CASES_BITMAP_W, CASES_BITMAP_H, 30, ILI9488_FIXED_ONE * 3 / 2,
+                         ILI9488_FILTER_NEAREST);
+    ILI9488_DrawRotozoom(140, 120, cases_bitmap, CASES_BITMAP_W, CASES_BITMAP_H, -45, ILI9488_FIXED_ONE * 2,
+                         ILI9488_FILTER_BILINEAR);
+    ILI9488_DrawRotozoom(w - 10, 120, cases_bitmap, CASES_BITMAP_W, CASES_BITMAP_H, 100, ILI9488_FIXED_ONE,
+                         ILI9488_FILTER_BILINEAR);
+    ILI9488_AffineRotozoom(&m, 0, ILI9488_FIXED_ONE, 0, 0, 0, 0);
+    ILI9488_AffineShear(&m, ILI9488_FIXED_ONE / 2, 0);
+    ILI9488_DrawAffine(200, 90, 60, CASES_BITMAP_H, cases_bitmap, CASES_BITMAP_W, CASES_BITMAP_H, &m,
+                       ILI9488_FILTER_NEAREST);
+
+    /* Scaled: enlarged, reduced, zoomed, and zoomed across the left edge */
+    ILI9488_DrawBitmapScaled(8, 170, 90, 40, cases_bitmap, CASES_BITMAP_W, CASES_BITMAP_H, ILI9488_FILTER_NEAREST);
+    ILI9488_DrawBitmapScaled(104, 170, 60, 17, cases_bitmap, CASES_BITMAP_W, CASES_BITMAP_H, ILI9488_FILTER_BILINEAR);
+    ILI9488_DrawBitmapScaled(104, 190, 80, 50, cases_bitmap, CASES_BITMAP_W, CASES_BITMAP_H, ILI9488_FILTER_BILINEAR);
+    ILI9488_DrawBitmapZoom(190, 170, cases_bitmap, CASES_BITMAP_W, CASES_BITMAP_H, 3);
+    ILI9488_DrawBitmapZoom(-20, 215, cases_bitmap, CASES_BITMAP_W, CASES_BITMAP_H, 2);
+
+    /* Sprites over the page: shown, moved, animated, hidden, and one across the right edge */
+    ring = (ILI9488_Sprite_t){ .pixels = cases_sprite, .w = CASES_SPRITE, .h = CASES_SPRITE, .frames = 2,
+                               .transparent = CASES_KEY, .x = 20, .y = 270, .visible = 1 };
+    cross = ring;
+    cross.x = 60;
+    cross.frame = 1;
+    edge = ring;
+    edge.x = (int16_t)(w - 6);
+    ILI9488_SpriteInit(Cases_Background);
+    ILI9488_AddSprite(&ring);
+    ILI9488_AddSprite(&cross);
+    ILI9488_AddSprite(&edge);
+    ILI9488_UpdateSprites();
+    ILI9488_MoveSprite(&ring, 52, 275);
+    ILI9488_SetSpriteFrame(&ring, 1);
+    ILI9488_ShowSprite(&cross, 0);
+    ILI9488_MoveSprite(&edge, (int16_t)(w - 10), 290);
+    ILI9488_UpdateSprites();
+}
+
+/**
+ * @brief Text lines, wrapped text boxes, cached glyphs and numbers
+ */
+static void Cases_Text(void){
+    static const ILI9488_NumberFormat_t field = { 120, ILI9488_ALIGN_RIGHT, 6, 1 };
+    static const ILI9488_NumberFormat_t hex = { 0, ILI9488_ALIGN_LEFT, 6, 0 };
+    uint16_t w = ILI9488_GetWidth();
+    uint16_t y = 4;
+
+    ILI9488_FillBackground(0x000008);
+
+    /* Kerned line, single characters, a line running off the right edge */
+    ILI9488_DrawText(4, y, case_font, "AVATAR LTA, WAVE!", ILI9488_WHITE, 0x000008);
+    y += 20;
+    uint16_t x = 4;
+    x += ILI9488_DrawChar(x, y, case_font, 'Q', ILI9488_YELLOW, ILI9488_BLUE);
+    x += ILI9488_DrawChar(x, y, case_font, '7', ILI9488_YELLOW, ILI9488_BLUE);
+    ILI9488_DrawChar(x, y, case_font, 'x', ILI9488_YELLOW, ILI9488_BLUE);
+    ILI9488_DrawText((uint16_t)(w - 50), y, case_font, "CLIPPED TEXT", ILI9488_GREEN, 0x000008);
+    y += 20;
+
+    /* Wrapped boxes: left with the 1-bit font, centered and right with the 4-bit one,
+       with lower case letters drawn as U+FFFD */
+    y += ILI9488_DrawTextBox(4, y, 150, case_font, "THE QUICK BROWN FOX JUMPS OVER 13 LAZY DOGS.",
+                             ILI9488_ALIGN_LEFT, ILI9488_WHITE, 0x101010);
+    y += 4;
+    y += ILI9488_DrawTextBox(4, y, 100, case_font4, "CENTERED TEXT IN A NARROW BOX", ILI9488_ALIGN_CENTER,
+                             ILI9488_CYAN, 0x000008);
+    y += ILI9488_DrawTextBox(4, y, 100, case_font4, "RIGHT, missing", ILI9488_ALIGN_RIGHT,
+                             ILI9488_CYAN, 0x080000);
+    y += ILI9488_DrawTextBox(4, y, 0, case_font, "NO WRAP\nTWO LINES", ILI9488_ALIGN_LEFT,
+                             ILI9488_MAGENTA, 0x000008);
+    y += 4;
+
+    /* The same line twice through the glyph cache, the second time from the cache */
+    ILI9488_ClearGlyphCache();
+    ILI9488_DrawTextCached(4, y, case_font, "CACHE 0123", ILI9488_YELLOW, 0x000008);
+    y += 18;
+    ILI9488_DrawTextCached(4, y, case_font, "CACHE 3210", ILI9488_YELLOW, 0x000008);
+    ILI9488_DrawCharCached(140, y, case_font, '9', ILI9488_RED, 0x000008);
+    y += 18;
+
+    /* Numbers: formatted field, fixed point, float, NaN and hex */
+    ILI9488_DrawInt(4, y, case_font, -4242, &field, ILI9488_WHITE, 0x102000);
+    ILI9488_DrawInt(130, y, case_font, 77, NULL, ILI9488_WHITE, 0x000008);
+    y += 18;
+    ILI9488_DrawFixed(4, y, case_font, 205887, 16, 3, NULL, ILI9488_GREEN, 0x000008);
+    ILI9488_DrawFloat(100, y, case_font, -0.125f, 2, NULL, ILI9488_GREEN, 0x000008);
+    ILI9488_DrawFloat(200, y, case_font, 0.0f / 0.0f, 1, NULL, ILI9488_GREEN, 0x000008);
+    y += 18;
+    ILI9488_DrawHex(4, y, case_font, 0xBEEF, &hex, ILI9488_YELLOW, 0x000008);
+}
+
+/* Cases drawn in every rotation, in mark order */
+static void (*const cases[])(void) = { Cases_Primitives, Cases_Blits, Cases_Graphics, Cases_Text };
+#define CASES_COUNT  (sizeof(cases) / sizeof(cases[0]))
+
+static void Cases_Write(void *context, const uint8_t *data, uint32_t size){
+    fwrite(data, 1, size, (FILE *)context);
+}
+
+int main(int argc, char **argv){
+    if(argc != 2){
+        fprintf(stderr, "usage: ili9488_cases cases.trace\n");
+        return 2;
+    }
+
+    for(uint32_t y = 0; y < CASES_BITMAP_H; y++){
+        for(uint32_t x = 0; x < CASES_BITMAP_W; x++){
+            cases_bitmap[y * CASES_BITMAP_W + x] = (x * 63 / (CASES_BITMAP_W - 1)) << 16 | (y * 63 / (CASES_BITMAP_H - 1)) << 8 | ((x + y) & 0x3F);
+        }
+    }
+
+    /* Sprite frames: a ring, and a cross, on the color key */
+    for(int32_t y = 0; y < CASES_SPRITE; y++){
+        for(int32_t x = 0; x < CASES_SPRITE; x++){
+            int32_t dx = 2 * x - (CASES_SPRITE - 1), dy = 2 * y - (CASES_SPRITE - 1);
+            int32_t d = dx * dx + dy * dy;
+            cases_sprite[y * CASES_SPRITE + x] = d >= 100 && d < 226 ? ILI9488_YELLOW : CASES_KEY;
+            cases_sprite[(CASES_SPRITE + y) * CASES_SPRITE + x] =
+                (x == y || x == CASES_SPRITE - 1 - y || x == y + 1) ? ILI9488_RED : CASES_KEY;
+        }
+    }
+
+    for(uint32_t rotation = 0; rotation < 4; rotation++){
+        ILI9488_Init((ILI9488_Rotation_t)rotation);
+        for(uint32_t i = 0; i < CASES_COUNT; i++){
+            cases[i]();
+            ILI9488_TraceMark(rotation * CASES_COUNT + i);
+        }
+    }
+
+    FILE *file = fopen(argv[1], "wb");
+    if(!file){
+        fprintf(stderr, "ili9488_cases: cannot write %s\n", argv[1]);
+        return 2;
+    }
+    uint32_t size = ILI9488_TraceDump(Cases_Write, file);
+    fclose(file);
+    if(size >= ILI9488_TRACE_SIZE){
+        fprintf(stderr, "ili9488_cases: the trace filled the ring, raise ILI9488_TRACE_SIZE\n");
+        return 1;
+    }
+    return 0;
+}
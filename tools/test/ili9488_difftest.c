@@ -0,0 +1,146 @@
+/**
+ * @file ili9488_difftest.c
+ * @brief Differential test of the drawing primitives
+ * @details This host program draws random sequences of primitives with the
+ *          driver and with the reference rasterizer of ili9488_ref.c, in all
+ *          four rotations, and compares the simulated panel memory with the
+ *          reference picture. The driver is built with ILI9488_TRACE and
+ *          ILI9488_TRACE_PIXELS 1 and the hooks of ili9488_simtrace.c, so
+ *          every bus word reaches the simulator, which also validates the
+ *          protocol. A failing sequence is reduced with Ref_Shrink() and
+ *          printed as driver calls.
+ *
+ *          Build:  make -C tools (tools/build/ili9488_difftest)
+ *          Usage:  ili9488_difftest [-n sequences] [-l length] [-s seed]
+ *
+ *          Built with ILI9488_FUZZ and -fsanitize=fuzzer (make -C tools
+ *          fuzz, clang only), the program is a libFuzzer target instead: the
+ *          input picks the rotation and seeds the operations, and a mismatch
+ *          prints the reduced sequence and aborts.
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "ili9488.h"
+#include "ili9488_ref.h"
+#include "ili9488_simtrace.h"
+
+/* Longest sequence of operations */
+#define DIFF_MAX_OPS  256
+
+/* Reference picture of the sequence under test */
+static Ref_t diff_ref;
+
+/**
+ * @brief Draw an operation with the driver
+ */
+static void Diff_Draw(const Ref_Op_t *op){
+    switch(op->type){
+        case REF_FILL_BACKGROUND: ILI9488_FillBackground(op->color); break;
+        case REF_PIXEL: ILI9488_DrawPixel(op->a, op->b, op->color); break;
+        case REF_LINE: ILI9488_DrawLine(op->a, op->b, op->c, op->d, op->color); break;
+        case REF_RECT: ILI9488_DrawRect(op->a, op->b, op->c, op->d, op->color); break;
+        case REF_FILL_RECT: ILI9488_FillRect(op->a, op->b, op->c, op->d, op->color); break;
+        case REF_CIRCLE: ILI9488_DrawCircle(op->a, op->b, op->c, op->color); break;
+        case REF_FILL_CIRCLE: ILI9488_FillCircle(op->a, op->b, op->c, op->color); break;
+        default: break;
+    }
+}
+
+/**
+ * @brief Run a sequence on a cleared panel with both rasterizers
+ * @param ops Operations
+ * @param count Number of operations
+ * @param context Rotation (ILI9488_Rotation_t)
+ * @return 1 if the pictures differ or the bus protocol was broken
+ */
+static uint8_t Diff_Fails(const Ref_Op_t *ops, uint32_t count, void *context){
+    ILI9488_Rotation_t rotation = *(const ILI9488_Rotation_t *)context;
+
+    Sim_Init(&host_sim);
+    host_sim.validate = SIM_VALIDATE_PROTOCOL;
+    ILI9488_Init(rotation);
+    ILI9488_FillBackground(ILI9488_BLACK);
+    Ref_Init(&diff_ref, ILI9488_GetWidth(), ILI9488_GetHeight());
+    for(uint32_t i = 0; i < count; i++){
+        Diff_Draw(&ops[i]);
+        Ref_Apply(&diff_ref, &ops[i]);
+    }
+    Sim_Finish(&host_sim);
+    return Ref_Compare(&diff_ref, &host_sim, NULL, NULL) != 0 || Host_Issues(&host_sim) != 0;
+}
+
+/**
+ * @brief Test one random sequence, and report it reduced if it fails
+ * @param rotation Rotation under test
+ * @param count Number of operations (at most DIFF_MAX_OPS)
+ * @param seed Random state, updated
+ * @return 1 if the sequence passed
+ */
+static uint8_t Diff_Run(ILI9488_Rotation_t rotation, uint32_t count, uint32_t *seed){
+    static Ref_Op_t ops[DIFF_MAX_OPS];
+    uint16_t width = (rotation & 1) ? ILI9488_LANDSCAPE_WIDTH : ILI9488_PORTRAIT_WIDTH;
+    uint16_t height = (rotation & 1) ? ILI9488_LANDSCAPE_HEIGHT : ILI9488_PORTRAIT_HEIGHT;
+    uint16_t x = 0, y = 0;
+
+    for(uint32_t i = 0; i < count; i++) Ref_Random(&ops[i], width, height, seed);
+    if(!Diff_Fails(ops, count, &rotation)) return 1;
+
+    count = Ref_Shrink(ops, count, Diff_Fails, &rotation);
+    Diff_Fails(ops, count, &rotation);
+    printf("rotation %d, after ILI9488_Init() and ILI9488_FillBackground(0):\n", (int)rotation);
+    for(uint32_t i = 0; i < count; i++) Ref_Print(&ops[i], stdout);
+    uint32_t differ = Ref_Compare(&diff_ref, &host_sim, &x, &y);
+    printf("%u pixels differ, first at (%u, %u)\n", (unsigned)differ, x, y);
+    Sim_Report(&host_sim, stdout);
+    return 0;
+}
+
+#ifdef ILI9488_FUZZ
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size){
+    uint32_t seed = 2166136261u;
+    if(size == 0) return 0;
+    for(size_t i = 1; i < size; i++) seed = (seed ^ data[i]) * 16777619u;
+    if(!Diff_Run((ILI9488_Rotation_t)(data[0] & 3), 1 + (uint32_t)(size - 1) % 32, &seed)) abort();
+    return 0;
+}
+
+#else
+
+static void Usage(void){
+    fprintf(stderr,
+            "usage: ili9488_difftest [-n sequences] [-l length] [-s seed]\n"
+            "  -n N  random sequences, spread over the four rotations (default 400)\n"
+            "  -l N  operations per sequence, 1 to %d (default 20)\n"
+            "  -s N  random seed (default 1)\n", DIFF_MAX_OPS);
+    exit(2);
+}
+
+int main(int argc, char **argv){
+    uint32_t sequences = 400, length = 20, seed = 1, failures = 0;
+
+    for(int i = 1; i < argc; i++){
+        if(argv[i][0] != '-' || !argv[i][1] || argv[i][2] || i + 1 >= argc) Usage();
+        uint32_t value = (uint32_t)strtoul(argv[++i], NULL, 0);
+        switch(argv[i - 1][1]){
+            case 'n': sequences = value; break;
+            case 'l': length = value; break;
+            case 's': seed = value; break;
+            default: Usage();
+        }
+    }
+    if(length < 1 || length > DIFF_MAX_OPS) Usage();
+
+    for(uint32_t i = 0; i < sequences; i++){
+        if(!Diff_Run((ILI9488_Rotation_t)(i & 3), length, &seed)) failures++;
+    }
+    printf("%u of %u sequences differ from the reference\n", (unsigned)failures, (unsigned)sequences);
+    return failures ? 1 : 0;
+}
+
+#endif /* ILI9488_FUZZ */
@@ -0,0 +1,202 @@
+/**
+ * @file ili9488_streamtest.c
+ * @brief Test of the streamed image path
+ * @details This host program draws every image of an asset pack three ways:
+ *          from memory with ILI9488_DrawImage(), and from the pack file with
+ *          ILI9488_DrawImageStream() through a blocking and an asynchronous
+ *          FILE reader. The simulated panel memory of each stream must equal
+ *          the one of ILI9488_DrawImage(), with no protocol issues, in
+ *          portrait and landscape.
+ *
+ *          The asynchronous reader only records the request in its read
+ *          callback and fills the buffer with garbage, as a DMA transfer in
+ *          flight would leave it; the file is read in the wait callback. A
+ *          chunk pushed to the panel before its read completed, or a chunk
+ *          overwritten by the prefetch while it was sent, shows up in the
+ *          image. Build with a small ILI9488_STREAM_CHUNK so an image spans
+ *          many chunks.
+ *
+ *          Build:  make -C tools (tools/build/ili9488_streamtest)
+ *          Usage:  ili9488_streamtest assets.pack
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ili9488.h"
+#include "ili9488_asset.h"
+#include "ili9488_image.h"
+#include "ili9488_stream.h"
+#include "ili9488_simtrace.h"
+
+/* Where the images are drawn */
+#define STREAM_X  3
+#define STREAM_Y  5
+
+/**
+ * @brief FILE reader state
+ */
+typedef struct {
+    FILE *file;
+    uint32_t offset;   ///< Request started by the asynchronous read callback
+    void *buffer;
+    uint32_t size;
+    uint32_t reads;    ///< Number of read callbacks
+} Stream_File_t;
+
+/* Panel memory drawn from memory, the expected picture */
+static uint32_t stream_expected[SIM_WIDTH * SIM_HEIGHT];
+
+static uint32_t Stream_FileRead(Stream_File_t *f, uint32_t offset, void *buffer, uint32_t size){
+    if(fseek(f->file, (long)offset, SEEK_SET) != 0) return 0;
+    return (uint32_t)fread(buffer, 1, size, f->file);
+}
+
+/**
+ * @brief Blocking read callback
+ */
+static uint32_t Stream_Read(void *context, uint32_t offset, void *buffer, uint32_t size){
+    Stream_File_t *f = (Stream_File_t *)context;
+    f->reads++;
+    return Stream_FileRead(f, offset, buffer, size);
+}
+
+/**
+ * @brief Asynchronous read callback: start the transfer
+ */
+static uint32_t Stream_Start(void *context, uint32_t offset, void *buffer, uint32_t size){
+    Stream_File_t *f = (Stream_File_t *)context;
+    f->reads++;
+    f->offset = offset;
+    f->buffer = buffer;
+    f->size = size;
+    memset(buffer, 0xA5, size);
+    return 0;
+}
+
+/**
+ * @brief Asynchronous wait callback: complete the transfer started last
+ */
+static uint32_t Stream_Wait(void *context){
+    Stream_File_t *f = (Stream_File_t *)context;
+    return Stream_FileRead(f, f->offset, f->buffer, f->size);
+}
+
+/**
+ * @brief Start a picture on a cleared panel
+ */
+static void Stream_Clear(ILI9488_Rotation_t rotation){
+    Sim_Init(&host_sim);
+    host_sim.validate = SIM_VALIDATE_PROTOCOL;
+    ILI9488_Init(rotation);
+    ILI9488_FillBackground(ILI9488_BLACK);
+}
+
+/**
+ * @brief Finish a picture and check it
+ * @param label Name of the picture in messages
+ * @param expected Picture to compare with, or NULL to store it as the expected one
+ * @return 1 if the picture is good
+ */
+static uint8_t Stream_Check(const char *label, const uint32_t *expected){
+    uint16_t width, height;
+    uint32_t differ = 0;
+    uint8_t ok = 1;
+
+    Sim_Finish(&host_sim);
+    Sim_Size(&host_sim, &width, &height);
+    for(uint16_t y = 0; y < height; y++){
+        for(uint16_t x = 0; x < width; x++){
+            uint32_t pixel = Sim_GetPixel(&host_sim, x, y);
+            if(!expected) stream_expected[(uint32_t)y * width + x] = pixel;
+            else if(expected[(uint32_t)y * width + x] != pixel) differ++;
+        }
+    }
+    if(differ){
+        printf("%s: %u pixels differ from ILI9488_DrawImage()\n", label, (unsigned)differ);
+        ok = 0;
+    }
+    if(Host_Issues(&host_sim)){
+        printf("%s: ", label);
+        Sim_Report(&host_sim, stdout);
+        ok = 0;
+    }
+    return ok;
+}
+
+/**
+ * @brief Draw one image of the pack in memory and streamed, and compare
+ * @return Number of failed checks
+ */
+static uint32_t Stream_Test(const uint8_t *pack, FILE *file, const char *name, ILI9488_Rotation_t rotation){
+    char label[128];
+    uint32_t failures = 0;
+    const uint8_t *image = ILI9488_PackFind(pack, name, NULL);
+    uint32_t offset = (uint32_t)(image - pack);
+    Stream_File_t context = {file, 0, NULL, 0, 0};
+    const ILI9488_Reader_t blocking = {Stream_Read, NULL, &context};
+    const ILI9488_Reader_t async = {Stream_Start, Stream_Wait, &context};
+
+    snprintf(label, sizeof(label), "%s, rotation %d, memory", name, (int)rotation);
+    Stream_Clear(rotation);
+    ILI9488_DrawImage(STREAM_X, STREAM_Y, image);
+    if(!Stream_Check(label, NULL)) failures++;
+
+    snprintf(label, sizeof(label), "%s, rotation %d, blocking reader", name, (int)rotation);
+    Stream_Clear(rotation);
+    if(!ILI9488_DrawImageStream(STREAM_X, STREAM_Y, &blocking, offset)){
+        printf("%s: read failed\n", label);
+        failures++;
+    }
+    if(!Stream_Check(label, stream_expected)) failures++;
+
+    snprintf(label, sizeof(label), "%s, rotation %d, asynchronous reader", name, (int)rotation);
+    Stream_Clear(rotation);
+    context.reads = 0;
+    if(!ILI9488_DrawImageStream(STREAM_X, STREAM_Y, &async, offset)){
+        printf("%s: read failed\n", label);
+        failures++;
+    }
+    if(!Stream_Check(label, stream_expected)) failures++;
+
+    printf("%-10s rotation %d: %u reads of up to %u bytes, %s\n", name, (int)rotation,
+           (unsigned)context.reads, (unsigned)ILI9488_STREAM_CHUNK, failures ? "FAILED" : "ok");
+    return failures;
+}
+
+int main(int argc, char **argv){
+    uint32_t failures = 0;
+    long size;
+
+    if(argc != 2){
+        fprintf(stderr, "usage: ili9488_streamtest assets.pack\n");
+        return 2;
+    }
+    FILE *file = fopen(argv[1], "rb");
+    if(!file || fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) <= 0){
+        fprintf(stderr, "ili9488_streamtest: cannot read %s\n", argv[1]);
+        return 2;
+    }
+    uint32_t *pack = malloc(((size_t)size + 3) & ~(size_t)3);
+    if(!pack || fseek(file, 0, SEEK_SET) != 0 || fread(pack, 1, (size_t)size, file) != (size_t)size ||
+       !ILI9488_PackCheck(pack)){
+        fprintf(stderr, "ili9488_streamtest: %s is not a pack\n", argv[1]);
+        return 2;
+    }
+
+    const ILI9488_PackHeader_t *header = (const ILI9488_PackHeader_t *)pack;
+    const ILI9488_PackEntry_t *entries = (const ILI9488_PackEntry_t *)(header + 1);
+    for(uint32_t i = 0; i < header->count; i++){
+        const char *name = (const char *)pack + entries[i].name;
+        failures += Stream_Test((const uint8_t *)pack, file, name, ILI9488_ROTATION_PORTRAIT);
+        failures += Stream_Test((const uint8_t *)pack, file, name, ILI9488_ROTATION_LANDSCAPE);
+    }
+    fclose(file);
+    free(pack);
+    printf("%u failed checks\n", (unsigned)failures);
+    return failures ? 1 : 0;
+}
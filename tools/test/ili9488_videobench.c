@@ -0,0 +1,168 @@
+/**
+ * @file ili9488_videobench.c
+ * @brief Video playback bench
+ * @details This host program writes a short RGB565 clip to a file and plays
+ *          it through a FILE reader with the video player of
+ *          ili9488_video.c, first sending every row, then only the rows that
+ *          changed. The driver is built with the trace hooks of
+ *          ili9488_costtrace.c, so the bus traffic is priced by the cost
+ *          model while it is sent and the player is paced by the predicted
+ *          time (ILI9488_VIDEO_CLOCK() is Host_Clock()). Reads are taken as
+ *          free, as with a DMA reader that keeps up.
+ *
+ *          For each frame the predicted bus time on the chosen part and
+ *          transport is printed, and for each run the frames shown and
+ *          dropped, the bus utilization and the time of the whole traffic on
+ *          every part and transport.
+ *
+ *          Build:  make -C tools (tools/build/ili9488_videobench)
+ *          Usage:  ili9488_videobench [-p part] [-t transport] [-f fps] clip.raw
+ * @author Cengiz Sinan Kostakoglu
+ * @version 1.0
+ * @date 2025-06-07
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ili9488.h"
+#include "ili9488_video.h"
+#include "ili9488_costtrace.h"
+
+/* Clip: a gradient with a square moving across it and a growing bar */
+#define BENCH_WIDTH   320
+#define BENCH_HEIGHT  240
+#define BENCH_FRAMES  24
+#define BENCH_SQUARE  40
+
+/* Frame buffers of the player */
+static uint32_t bench_frames[2][BENCH_WIDTH * BENCH_HEIGHT];
+
+/**
+ * @brief Get pixel (x, y) of a clip frame as RGB565
+ */
+static uint16_t Bench_Pixel(uint32_t frame, uint32_t x, uint32_t y){
+    uint32_t sx = 8 + frame * (BENCH_WIDTH - BENCH_SQUARE - 16) / (BENCH_FRAMES - 1);
+    uint32_t sy = 60 + (frame & 7) * 8;
+    if(x >= sx && x < sx + BENCH_SQUARE && y >= sy && y < sy + BENCH_SQUARE) return 0xFFE0;
+    if(y >= BENCH_HEIGHT - 8 && x < (frame + 1) * BENCH_WIDTH / BENCH_FRAMES) return 0xF800;
+    return (uint16_t)((x * 31 / (BENCH_WIDTH - 1)) << 11 | (y * 63 / (BENCH_HEIGHT - 1)) << 5 | ((x + y) & 0x1F));
+}
+
+/**
+ * @brief Write the clip
+ * @return 1 on success
+ */
+static uint8_t Bench_WriteClip(const char *path){
+    static uint16_t frame[BENCH_WIDTH * BENCH_HEIGHT];
+    FILE *file = fopen(path, "wb");
+    if(!file) return 0;
+    for(uint32_t f = 0; f < BENCH_FRAMES; f++){
+        for(uint32_t y = 0; y < BENCH_HEIGHT; y++){
+            for(uint32_t x = 0; x < BENCH_WIDTH; x++) frame[y * BENCH_WIDTH + x] = Bench_Pixel(f, x, y);
+        }
+        if(fwrite(frame, sizeof(frame), 1, file) != 1){
+            fclose(file);
+            return 0;
+        }
+    }
+    return fclose(file) == 0;
+}
+
+/**
+ * @brief Blocking read callback
+ */
+static uint32_t Bench_Read(void *context, uint32_t offset, void *buffer, uint32_t size){
+    FILE *file = (FILE *)context;
+    if(fseek(file, (long)offset, SEEK_SET) != 0) return 0;
+    return (uint32_t)fread(buffer, 1, size, file);
+}
+
+/**
+ * @brief Play the clip once and print its frames and totals
+ * @return 1 if every frame was read
+ */
+static uint8_t Bench_Play(FILE *file, uint16_t fps, uint8_t skip_unchanged, uint32_t part, Cost_Transport_t transport){
+    static const char *const transports[COST_TRANSPORTS] = { "gpio", "fmc", "dma", "flash" };
+    const ILI9488_Reader_t reader = {Bench_Read, NULL, file};
+    ILI9488_Video_t video;
+    Cost_t frame_cost, total;
+    const char *label = skip_unchanged ? "changed rows" : "all rows";
+
+    ILI9488_Init(ILI9488_ROTATION_PORTRAIT);
+    ILI9488_FillBackground(ILI9488_BLACK);
+    Host_CostInit(&cost_profiles[part], transport);
+    Cost_Init(&total);
+
+    memset(&video, 0, sizeof(video));
+    video.reader = &reader;
+    video.format = ILI9488_VIDEO_RAW565;
+    video.y = (ILI9488_PORTRAIT_HEIGHT - BENCH_HEIGHT) / 2;
+    video.width = BENCH_WIDTH;
+    video.height = BENCH_HEIGHT;
+    video.frame_count = BENCH_FRAMES;
+    video.fps = fps;
+    video.skip_unchanged = skip_unchanged;
+    video.frames[0] = bench_frames[0];
+    video.frames[1] = bench_frames[1];
+    if(!ILI9488_VideoOpen(&video)) return 0;
+
+    printf("%s, %u fps, paced on %s %s:\n", label, (unsigned)fps, cost_profiles[part].name, transports[transport]);
+    for(uint32_t f = 0; f < BENCH_FRAMES && !video.error; f++){
+        uint32_t shown = video.stats.frames_shown;
+        ILI9488_VideoStep(&video);
+        Host_CostTake(&frame_cost);
+        Cost_Add(&total, &frame_cost);
+        printf("  frame %2u  %-7s %10.1f us\n", (unsigned)f, video.stats.frames_shown != shown ? "shown" : "dropped",
+               Cost_Microseconds(&frame_cost, &cost_profiles[part], transport));
+    }
+    printf("%s: %u frames shown, %u dropped, %u rows sent, %u skipped, bus utilization %u %%\n", label,
+           (unsigned)video.stats.frames_shown, (unsigned)video.stats.frames_dropped,
+           (unsigned)video.stats.rows_sent, (unsigned)video.stats.rows_skipped,
+           (unsigned)ILI9488_VideoBusUtilization(&video));
+    Cost_Print(&total, skip_unchanged ? "changed" : "all", stdout);
+    printf("\n");
+    return !video.error;
+}
+
+static void Usage(void){
+    fprintf(stderr,
+            "usage: ili9488_videobench [-p part] [-t transport] [-f fps] clip.raw\n"
+            "  -p N  part that paces the player, 0 to %d (default 0, %s)\n"
+            "  -t N  transport: 0 gpio, 1 fmc, 2 dma, 3 flash (default 0)\n"
+            "  -f N  frame rate, 0 for as fast as possible (default 60)\n", COST_PROFILES - 1, cost_profiles[0].name);
+    exit(2);
+}
+
+int main(int argc, char **argv){
+    uint32_t part = 0, transport = COST_GPIO, fps = 60;
+    int i;
+
+    for(i = 1; i + 1 < argc; i += 2){
+        if(argv[i][0] != '-' || !argv[i][1] || argv[i][2]) Usage();
+        uint32_t value = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        switch(argv[i][1]){
+            case 'p': part = value; break;
+            case 't': transport = value; break;
+            case 'f': fps = value; break;
+            default: Usage();
+        }
+    }
+    if(i + 1 != argc || part >= COST_PROFILES || transport >= COST_TRANSPORTS || fps > 0xFFFF) Usage();
+
+    if(!Bench_WriteClip(argv[i])){
+        fprintf(stderr, "ili9488_videobench: cannot write %s\n", argv[i]);
+        return 2;
+    }
+    FILE *file = fopen(argv[i], "rb");
+    if(!file){
+        fprintf(stderr, "ili9488_videobench: cannot read %s\n", argv[i]);
+        return 2;
+    }
+    uint8_t ok = Bench_Play(file, (uint16_t)fps, 0, part, (Cost_Transport_t)transport) &&
+                 Bench_Play(file, (uint16_t)fps, 1, part, (Cost_Transport_t)transport);
+    fclose(file);
+    if(!ok) fprintf(stderr, "ili9488_videobench: reading %s failed\n", argv[i]);
+    return ok ? 0 : 1;
+}